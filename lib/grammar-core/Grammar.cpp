@@ -1,4 +1,5 @@
 #include "Grammar.h"
+#include "../../src/Profiler.h"
 #include <random>
 #include <iostream>
 #include <sstream>
@@ -59,6 +60,7 @@ glm::ivec2 Grammar::getOutDir(const PrimDef* def, glm::ivec2 inDir)
 
 void Grammar::generate(std::function<void(int,int)> progressCb)
 {
+    MYTHOS_PROFILE_SCOPE("Grammar::generate");
     if (hardcoded) { generateHardcoded(); return; }
 
     placed.clear();
@@ -121,6 +123,7 @@ bool Grammar::stepGenerate()
 
 bool Grammar::runAttempt(int attempt)
 {
+    MYTHOS_PROFILE_SCOPE("Grammar::runAttempt");
     const PrimDef* startDef = findPrim("CornerBR");
     if (!startDef) return false;
 
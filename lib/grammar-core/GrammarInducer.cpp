@@ -1,10 +1,13 @@
 #include "GrammarInducer.h"
+#include "../../src/Profiler.h"
+#include "../../src/MemoryStats.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <memory>
 
 namespace grammar {
 
@@ -54,9 +57,11 @@ struct JV {
 
 struct JP {
     const char* p; const char* end;
+    size_t nodes=0;   // values parsed (MemoryStats estimate)
     JP(const char* d,size_t l):p(d),end(d+l){}
     void ws(){while(p<end&&(*p==' '||*p=='\t'||*p=='\n'||*p=='\r'))++p;}
     JV parse(){
+        ++nodes;
         ws(); if(p>=end) return {};
         char c=*p;
         if(c=='{') return pObj();
@@ -257,11 +262,13 @@ InducedGrammar GrammarInducer::induceFromFile(const std::string& path)
 
 InducedGrammar GrammarInducer::induce(const std::string& gepJson)
 {
+    MYTHOS_PROFILE_SCOPE("GrammarInducer::induce");
     InducedGrammar result;
     s_error.clear();
 
     JP parser(gepJson.data(), gepJson.size());
     JV root = parser.parse();
+    MemoryStats::Tracked dom(MemTag::Json, parser.nodes * sizeof(JV));
     if (root.type != JV::Obj) {
         s_error = "Invalid GEP JSON";
         return result;
@@ -1,4 +1,5 @@
 #include "HalfEdgeMesh.h"
+#include "../../src/Profiler.h"
 #include "../../src/MeshAsset.h"   // MeshData, MeshVertex, SubMesh
 
 #include <algorithm>
@@ -17,6 +18,7 @@ namespace grammar {
 
 bool HalfEdgeMesh::buildFromMesh(const MeshData& mesh, float weldEpsilon)
 {
+    MYTHOS_PROFILE_SCOPE("HalfEdgeMesh::buildFromMesh");
     verts.clear();
     halfEdges.clear();
     faces.clear();
@@ -192,6 +194,7 @@ void HalfEdgeMesh::weldVertices(const MeshData& mesh, float epsilon,
                                   std::vector<glm::vec3>& outPositions,
                                   std::vector<glm::vec3>& outNormals)
 {
+    MYTHOS_PROFILE_SCOPE("HalfEdgeMesh::weldVertices");
     int n = (int)mesh.vertices.size();
     remap.resize(n, -1);
 
@@ -274,6 +277,7 @@ void HalfEdgeMesh::weldVertices(const MeshData& mesh, float epsilon,
 
 void HalfEdgeMesh::buildTwins()
 {
+    MYTHOS_PROFILE_SCOPE("HalfEdgeMesh::buildTwins");
     // Map from directed edge (u->v) -> list of all half-edge ids with that direction.
     // For a clean manifold mesh every entry has exactly 1 element.
     // Non-manifold edges have 2+ elements — we leave those unlinked (twin = -1)
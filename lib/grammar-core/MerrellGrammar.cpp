@@ -1,4 +1,5 @@
 #include "MerrellGrammar.h"
+#include "../../src/Profiler.h"
 #include <iostream>
 #include <set>
 #include <unordered_map>
@@ -17,6 +18,8 @@ namespace merrell {
 void MerrellGrammar::loadFromTiles(const std::vector<TileSocketDef>& socketDefs,
                                    const std::vector<TileInput>&     /*tiles*/)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::loadFromTiles");
+    ++m_version;
     m_primitives.clear();
     m_lastError.clear();
 
@@ -65,6 +68,7 @@ void MerrellGrammar::loadFromTiles(const std::vector<TileSocketDef>& socketDefs,
         m_primitives.push_back(std::move(prim));
     }
 
+    trackMemory();
     std::cout << "[MerrellGrammar] MG-1 complete: "
               << m_primitives.size() << " primitives.\n";
 }
@@ -80,6 +84,8 @@ void MerrellGrammar::loadFromShape(const MeshData* /*mesh*/)
 
 void MerrellGrammar::extractGrammar(std::function<void(int,int)> progressCb)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::extractGrammar");
+    ++m_version;
     m_rules.clear();
     m_lastError.clear();
 
@@ -91,6 +97,7 @@ void MerrellGrammar::extractGrammar(std::function<void(int,int)> progressCb)
 
     buildHierarchy(progressCb);
     algorithm1_findGrammar(progressCb);
+    trackMemory();
 
     std::cout << "[MerrellGrammar] extractGrammar: "
               << m_rules.size() << " rules extracted (MG-3 complete).\n";
@@ -103,6 +110,7 @@ void MerrellGrammar::extractGrammar(std::function<void(int,int)> progressCb)
 void MerrellGrammar::generate(int seed,
                               std::function<void(int,int)> progressCb)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::generate");
     m_result = {};
     m_lastError.clear();
     if (m_rules.empty()) {
@@ -375,6 +383,7 @@ static bool loopGlue(const MerrellGraph& A, const MerrellGraph& B,
 
 void MerrellGrammar::buildHierarchy(std::function<void(int,int)> progressCb)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::buildHierarchy");
     m_hierarchy.clear();
 
     // ---- Gen 0: seed with primitives ----------------------------------------
@@ -485,6 +494,7 @@ void MerrellGrammar::buildHierarchy(std::function<void(int,int)> progressCb)
 
 void MerrellGrammar::tryLoopGluings(int generation)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::tryLoopGluings");
     // Collect all hierarchy nodes at `generation`
     std::vector<int> genNodes;
     for (int i = 0; i < (int)m_hierarchy.size(); ++i)
@@ -505,6 +515,10 @@ void MerrellGrammar::tryLoopGluings(int generation)
     int maxNewNodes = m_settings.maxRules; // use as a safety cap
     int newNodes    = 0;
 
+    // A and B below reference graphs inside m_hierarchy, so new nodes are
+    // collected here and appended once the pair loops are done.
+    std::vector<HierarchyNode> added;
+
     // Try all pairs (including self-gluing) at this generation
     for (int ai : genNodes) {
         for (int bi : genNodes) {
@@ -557,7 +571,7 @@ void MerrellGrammar::tryLoopGluings(int generation)
 
                     // Add to hierarchy
                     HierarchyNode node;
-                    node.id         = nextHierarchyId();
+                    node.id         = nextHierarchyId() + (int)added.size();
                     node.generation = generation + 1;
                     node.graph      = std::move(result);
                     node.boundary   = bs;
@@ -570,17 +584,20 @@ void MerrellGrammar::tryLoopGluings(int generation)
                               << "  complete=" << (node.isComplete ? "Y" : "N")
                               << "\n";
 
-                    m_hierarchy.push_back(std::move(node));
+                    added.push_back(std::move(node));
                     ++newNodes;
                 }
             }
         }
     }
-    done:;
+    done:
+    for (HierarchyNode& node : added)
+        m_hierarchy.push_back(std::move(node));
 }
 
 void MerrellGrammar::tryBranchGluings(int generation)
 {
+    MYTHOS_PROFILE_SCOPE("MerrellGrammar::tryBranchGluings");
     // TODO MG-2 step 2: branch gluing — (āB to a) replaces a → Bv  (Sec 4.2)
     // Branch gluing inserts a subgraph B alongside a cut edge a.
     // More complex than loop gluing; deferred until loop gluings are verified.
@@ -906,4 +923,58 @@ int MerrellGrammar::hierarchyDepth() const
     return d;
 }
 
+// ============================================================
+// Memory accounting
+// ============================================================
+// Capacity-based estimates; strings count only when they spill out of the
+// small-string buffer.
+
+static size_t strHeap(const std::string& s) { return s.capacity() > 15 ? s.capacity() + 1 : 0; }
+
+static size_t graphBytes(const MerrellGraph& g)
+{
+    size_t n = g.vertices.capacity()  * sizeof(MGVertex)
+             + g.halfEdges.capacity() * sizeof(MGHalfEdge)
+             + g.faces.capacity()     * sizeof(MGFace);
+    for (const auto& he : g.halfEdges) n += strHeap(he.label.l) + strHeap(he.label.r);
+    for (const auto& f  : g.faces)     n += strHeap(f.label);
+    return n;
+}
+
+static size_t boundaryBytes(const BoundaryString& b)
+{
+    size_t n = b.elements.capacity() * sizeof(BoundaryElement);
+    for (const auto& e : b.elements) n += strHeap(e.edge_label);
+    return n;
+}
+
+static size_t morphismBytes(const GraphMorphism& m)
+{
+    // Node: key/value pair + next pointer (+ cached hash); one pointer per bucket
+    auto mapBytes = [](const std::unordered_map<int,int>& u) {
+        return u.size() * (sizeof(std::pair<const int,int>) + 2 * sizeof(void*))
+             + u.bucket_count() * sizeof(void*);
+    };
+    return mapBytes(m.vertexMap) + mapBytes(m.halfEdgeMap) + mapBytes(m.faceMap);
+}
+
+void MerrellGrammar::trackMemory()
+{
+    size_t hier = m_primitives.capacity() * sizeof(MerrellGraph)
+                + m_hierarchy.capacity()  * sizeof(HierarchyNode);
+    for (const auto& p : m_primitives) hier += graphBytes(p);
+    for (const auto& h : m_hierarchy)
+        hier += graphBytes(h.graph) + boundaryBytes(h.boundary)
+              + h.parentIds.capacity() * sizeof(int);
+
+    size_t rules = m_rules.capacity() * sizeof(DPORule);
+    for (const auto& r : m_rules)
+        rules += strHeap(r.name) + graphBytes(r.L) + graphBytes(r.R) + graphBytes(r.I)
+               + morphismBytes(r.phi_L) + morphismBytes(r.phi_R)
+               + boundaryBytes(r.boundary_L) + boundaryBytes(r.boundary_R);
+
+    m_hierarchyMem.set(hier);
+    m_rulesMem.set(rules);
+}
+
 } // namespace merrell
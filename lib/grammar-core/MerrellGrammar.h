@@ -22,6 +22,8 @@
 
 #include "MerrellGraph.h"
 #include "DPORule.h"
+#include "../../src/MemoryStats.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
@@ -154,13 +156,24 @@ public:
 
     const std::string& lastError() const { return m_lastError; }
 
+    // Bumped whenever primitives, hierarchy or rules are rebuilt — views
+    // cache layouts against it instead of diffing the containers.
+    uint64_t version() const { return m_version; }
+
 private:
     GrammarSettings            m_settings;
     std::vector<MerrellGraph>  m_primitives;
     std::vector<HierarchyNode> m_hierarchy;
     std::vector<DPORule>       m_rules;
     GenerationResult           m_result;
+
+    // Estimated heap footprint of primitives + hierarchy, and of m_rules.
+    // Refreshed by trackMemory() after loadFromTiles / extractGrammar.
+    MemoryStats::Tracked       m_hierarchyMem { MemTag::MerrellHierarchy };
+    MemoryStats::Tracked       m_rulesMem     { MemTag::MerrellRules };
+    void trackMemory();
     std::string                m_lastError;
+    uint64_t                   m_version = 0;
 
     // Step state for animated generation
     MerrellGraph  m_genState;
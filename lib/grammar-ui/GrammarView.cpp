@@ -1,6 +1,7 @@
 #include "GrammarView.h"
 #include "../grammar-core/GrammarInducer.h"
 #include "../../src/FileDialog.h"
+#include "../../src/SceneDelta.h"
 #include <imgui.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
@@ -27,11 +28,43 @@ void GrammarView::registerPrims()
 
 void GrammarView::startGenerate(Scene& scene, MeshLibrary& lib)
 {
-    scene.clear();
+    // Objects stay in the scene (hidden) so populateFromGrammar can diff
+    // the new layout against them instead of rebuilding from nothing.
+    beginEdit(scene);
+    scene.beginRepopulate();
     m_grammar.beginGenerate();
     m_animating = true;
 }
 
+// ============================================================
+// Undo
+// ============================================================
+// The scene copy lives only while an edit is in progress; what goes on the
+// history is the diff. Restarting a generation keeps the first baseline so
+// the whole run undoes in one step.
+
+void GrammarView::beginEdit(const Scene& scene)
+{
+    if (!m_history || m_hasBaseline) return;
+    m_baseline    = scene.objects();
+    m_hasBaseline = true;
+}
+
+void GrammarView::commitEdit(Scene& scene, const char* name)
+{
+    if (!m_hasBaseline) return;
+    SceneDelta delta = SceneDelta::diff(m_baseline, scene);
+    dropBaseline();
+    if (!delta.empty())
+        m_history->push(makeDeltaCommand(name, scene, std::move(delta)));
+}
+
+void GrammarView::dropBaseline()
+{
+    std::vector<SceneObject>().swap(m_baseline);
+    m_hasBaseline = false;
+}
+
 // ============================================================
 // Toolbar section — registered with EditorUI at startup
 // Draws grammar action buttons inside the main toolbar when
@@ -110,6 +143,9 @@ void GrammarView::update(Scene& scene, MeshLibrary& lib, double /*dt*/)
             m_animating = false;
             if (m_grammar.state().success)
                 scene.populateFromGrammar(m_grammar, lib);
+            else
+                scene.clear();   // failed run — nothing left to show
+            commitEdit(scene, "Generate layout");
             break;
         }
     }
@@ -235,7 +271,9 @@ void GrammarView::drawPanel(Scene& scene, MeshLibrary& lib)
         if (ImGui::Button("Decode"))
             if (m_grammar.decode(buf)) {
                 m_animating = false;
+                beginEdit(scene);
                 scene.populateFromGrammar(m_grammar, lib);
+                commitEdit(scene, "Decode layout");
             }
     }
 
@@ -4,6 +4,9 @@
 #include "../../src/Scene.h"
 #include "../../src/Renderer.h"
 #include <glm/glm.hpp>
+#include <vector>
+
+class CommandHistory;
 
 class GrammarView
 {
@@ -37,7 +40,11 @@ public:
         m_grammar.maxPrim   = s.maxPrim;
         m_grammar.hardcoded = s.hardcoded;
     }
-    void stopGenerating() { m_animating = false; }
+    void stopGenerating() { m_animating = false; dropBaseline(); }
+
+    // Finished generations / decodes are pushed as one undoable SceneDelta.
+    // Set after init() so the startup layout is not on the stack.
+    void setHistory(CommandHistory* history) { m_history = history; }
 
 private:
     grammar::Grammar          m_grammar;
@@ -48,6 +55,15 @@ private:
     bool  m_open             = true;   // window visibility
     int   m_attemptsPerFrame = 10;
 
+    // Scene as it was before the edit in progress (diff base for undo)
+    CommandHistory*          m_history     = nullptr;
+    std::vector<SceneObject> m_baseline;
+    bool                     m_hasBaseline = false;
+
+    void beginEdit(const Scene& scene);
+    void commitEdit(Scene& scene, const char* name);
+    void dropBaseline();
+
     void startGenerate(Scene& scene, MeshLibrary& lib);
     void registerPrims();
 };
@@ -0,0 +1,106 @@
+#include "GraphLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
+// ============================================================
+// Sugiyama — layered DAG
+// ============================================================
+// Layers come from the input (generation), so only the crossing-reduction
+// and placement steps remain. Links that skip layers are not split into
+// dummy nodes; the barycentre still uses the real parent positions.
+GraphLayout GraphLayout::sugiyama(const std::vector<DagItem>& items,
+                                  float nodeW, float nodeH, float gapX, float gapY)
+{
+    static const int kSweeps = 4;   // down + up passes; more rarely helps
+
+    GraphLayout out;
+    out.nodeW = nodeW;
+    out.nodeH = nodeH;
+    const int n = (int)items.size();
+    out.nodes.resize(n);
+    if (n == 0) return out;
+
+    std::unordered_map<int, int> indexOf;
+    indexOf.reserve(n);
+    for (int i = 0; i < n; ++i) indexOf[items[i].id] = i;
+
+    std::vector<std::vector<int>> parents(n), children(n);
+    for (int i = 0; i < n; ++i)
+        for (int pid : items[i].parentIds) {
+            auto it = indexOf.find(pid);
+            if (it == indexOf.end() || it->second == i) continue;
+            parents[i].push_back(it->second);
+            children[it->second].push_back(i);
+            out.links.push_back({ it->second, i });
+        }
+
+    // Compact layer numbers into rows, keeping input order within a row
+    std::map<int, std::vector<int>> byLayer;
+    for (int i = 0; i < n; ++i) byLayer[items[i].layer].push_back(i);
+    std::vector<std::vector<int>> rows;
+    rows.reserve(byLayer.size());
+    for (auto& [layer, row] : byLayer) rows.push_back(std::move(row));
+
+    const float stepX = nodeW + gapX;
+    std::vector<float> x(n, 0.f);
+    auto place = [&](const std::vector<int>& row) {
+        const float start = -0.5f * (float)(row.size() - 1) * stepX;
+        for (size_t k = 0; k < row.size(); ++k) x[row[k]] = start + (float)k * stepX;
+    };
+    for (const auto& row : rows) place(row);
+
+    // Barycentre ordering: sort a row by the mean x of its neighbours in
+    // the rows already placed; nodes without neighbours keep their x.
+    std::vector<float> key(n, 0.f);
+    auto reorder = [&](std::vector<int>& row, const std::vector<std::vector<int>>& nbrs) {
+        for (int i : row) {
+            const auto& nb = nbrs[i];
+            if (nb.empty()) { key[i] = x[i]; continue; }
+            float sum = 0.f;
+            for (int j : nb) sum += x[j];
+            key[i] = sum / (float)nb.size();
+        }
+        std::stable_sort(row.begin(), row.end(), [&](int a, int b) { return key[a] < key[b]; });
+        place(row);
+    };
+    for (int s = 0; s < kSweeps; ++s) {
+        for (size_t r = 1; r < rows.size(); ++r)      reorder(rows[r], parents);
+        for (size_t r = rows.size() - 1; r-- > 0; )   reorder(rows[r], children);
+    }
+
+    // Shift to a non-negative origin
+    float minX = 0.f;
+    for (float v : x) minX = std::min(minX, v);
+    for (size_t r = 0; r < rows.size(); ++r)
+        for (int i : rows[r]) {
+            out.nodes[i] = { x[i] - minX, (float)r * (nodeH + gapY) };
+            out.width = std::max(out.width, out.nodes[i].x + nodeW);
+        }
+    out.height = (float)rows.size() * (nodeH + gapY) - gapY;
+    return out;
+}
+
+// ============================================================
+// Grid packing
+// ============================================================
+GraphLayout GraphLayout::grid(int count, float nodeW, float nodeH, float gap)
+{
+    GraphLayout out;
+    out.nodeW = nodeW;
+    out.nodeH = nodeH;
+    if (count <= 0) return out;
+
+    // Columns for a roughly square block in canvas units
+    const float cellW = nodeW + gap, cellH = nodeH + gap;
+    const int   cols  = std::max(1, (int)std::ceil(std::sqrt((float)count * cellH / cellW)));
+    const int   rows  = (count + cols - 1) / cols;
+
+    out.nodes.resize(count);
+    for (int i = 0; i < count; ++i)
+        out.nodes[i] = { (float)(i % cols) * cellW, (float)(i / cols) * cellH };
+    out.width  = (float)std::min(count, cols) * cellW - gap;
+    out.height = (float)rows * cellH - gap;
+    return out;
+}
@@ -0,0 +1,39 @@
+#pragma once
+// GraphLayout — node placement for GraphViewer's overview canvases.
+//
+//   sugiyama()  layered DAG: one row per layer (hierarchy generation),
+//               nodes ordered within a row by barycentre sweeps so parent →
+//               child links cross as little as possible
+//   grid()      uniform cells packed row-major into a roughly square block
+//
+// Both are pure functions of their input (no ImGui, no grammar types), so
+// GraphViewer can compute a layout on a worker thread from a snapshot and
+// keep it until MerrellGrammar::version() changes. Coordinates are canvas
+// units; nodes[i] is placed for input item i.
+
+#include <cstdint>
+#include <vector>
+
+struct GraphLayout
+{
+    struct Node { float x = 0.f, y = 0.f; };   // top-left corner
+    struct Link { int from = 0, to = 0; };     // indices into nodes
+
+    std::vector<Node> nodes;
+    std::vector<Link> links;
+    float    nodeW  = 0.f, nodeH = 0.f;
+    float    width  = 0.f, height = 0.f;      // extent of all nodes
+    uint64_t version = ~0ull;                 // grammar version laid out
+
+    struct DagItem {
+        int              id    = -1;
+        int              layer = 0;
+        std::vector<int> parentIds;           // ids of items in earlier layers
+    };
+
+    static GraphLayout sugiyama(const std::vector<DagItem>& items,
+                                float nodeW, float nodeH, float gapX, float gapY);
+    static GraphLayout grid(int count, float nodeW, float nodeH, float gap);
+
+    bool empty() const { return nodes.empty(); }
+};
@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
 // ============================================================
@@ -42,6 +43,20 @@ ImU32 GraphViewer::faceColour(const std::string& label)
     return kFacePalette[idx];
 }
 
+// Rule kind → list badge and colour (rule list and grid overview)
+static const char* ruleKindBadge(merrell::RuleKind kind, ImVec4& col)
+{
+    switch (kind) {
+        case merrell::RuleKind::Starter:    col = {0.9f,0.8f,0.3f,1.f}; return "S";
+        case merrell::RuleKind::LoopGlue:   col = {0.3f,0.8f,0.7f,1.f}; return "L";
+        case merrell::RuleKind::BranchGlue: col = {0.8f,0.5f,0.3f,1.f}; return "B";
+        case merrell::RuleKind::Stub:       col = {0.6f,0.5f,0.8f,1.f}; return "Sb";
+        case merrell::RuleKind::General:    col = {0.7f,0.7f,0.9f,1.f}; return "G";
+    }
+    col = {0.7f,0.7f,0.7f,1.f};
+    return "?";
+}
+
 // ============================================================
 // imnodes context lifecycle (kept for API compat; imnodes no longer used
 // for graph rendering — we draw directly via ImDrawList instead)
@@ -347,45 +362,51 @@ void GraphViewer::drawHierarchyTab()
     ImGui::PopStyleColor();
     ImGui::Separator();
 
-    int curGen = -1;
-    for (int i = 0; i < (int)hier.size(); ++i) {
-        const auto& node = hier[i];
-
-        // Generation header
-        if (node.generation != curGen) {
-            curGen = node.generation;
-            ImGui::Spacing();
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0.5f, 0.7f, 1.f, 1.f});
-            ImGui::Text("Gen %d", curGen);
-            ImGui::PopStyleColor();
-        }
+    // Only the visible rows are submitted — headers are rows of the same
+    // height, so the clipper can index the flattened list directly
+    updateHierRows();
+    ImGuiListClipper clipper;
+    clipper.Begin((int)m_hierRows.size());
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const int i = m_hierRows[row];
+
+            // Generation header
+            if (i < 0) {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0.5f, 0.7f, 1.f, 1.f});
+                ImGui::Text("Gen %d", -i - 1);
+                ImGui::PopStyleColor();
+                continue;
+            }
+            const auto& node = hier[i];
 
-        // Node entry
-        char buf[128];
-        snprintf(buf, sizeof(buf), "  N%d##hiersel_%d", node.id, i);
+            // Node entry
+            char buf[128];
+            snprintf(buf, sizeof(buf), "  N%d##hiersel_%d", node.id, i);
 
-        bool sel = (m_selectedHierNode == i);
-        ImGui::PushStyleColor(ImGuiCol_Header,
-            sel ? ImVec4{0.22f,0.40f,0.72f,0.8f} : ImVec4{0,0,0,0});
+            bool sel = (m_selectedHierNode == i);
+            ImGui::PushStyleColor(ImGuiCol_Header,
+                sel ? ImVec4{0.22f,0.40f,0.72f,0.8f} : ImVec4{0,0,0,0});
 
-        if (ImGui::Selectable(buf, sel))
-            m_selectedHierNode = i;
+            if (ImGui::Selectable(buf, sel))
+                m_selectedHierNode = i;
 
-        ImGui::PopStyleColor();
+            ImGui::PopStyleColor();
 
-        // Badges inline
-        ImGui::SameLine();
-        if (node.isComplete)
-            ImGui::TextColored({0.3f,0.9f,0.3f,1.f}, "●");  // complete
-        else
-            ImGui::TextColored({0.5f,0.5f,0.5f,1.f}, "○");  // incomplete
-        if (node.pruned) {
+            // Badges inline
             ImGui::SameLine();
-            ImGui::TextColored({0.8f,0.4f,0.3f,1.f}, "✕");
-        }
+            if (node.isComplete)
+                ImGui::TextColored({0.3f,0.9f,0.3f,1.f}, "●");  // complete
+            else
+                ImGui::TextColored({0.5f,0.5f,0.5f,1.f}, "○");  // incomplete
+            if (node.pruned) {
+                ImGui::SameLine();
+                ImGui::TextColored({0.8f,0.4f,0.3f,1.f}, "✕");
+            }
 
-        ImGui::SameLine();
-        ImGui::TextDisabled("f%d", node.graph.faceCount());
+            ImGui::SameLine();
+            ImGui::TextDisabled("f%d", node.graph.faceCount());
+        }
     }
 
     ImGui::EndChild();
@@ -393,10 +414,16 @@ void GraphViewer::drawHierarchyTab()
 
     ImGui::SameLine();
 
-    // Right pane: selected node detail
+    // Right pane: selected node detail, or the whole DAG
     ImGui::BeginChild("##hier_detail", {-1.f, -1.f}, false);
 
-    if (m_selectedHierNode >= 0 && m_selectedHierNode < (int)hier.size()) {
+    ImGui::RadioButton("Graph##hierview", &m_hierView, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("DAG##hierview", &m_hierView, 1);
+
+    if (m_hierView == 1) {
+        drawHierarchyDag();
+    } else if (m_selectedHierNode >= 0 && m_selectedHierNode < (int)hier.size()) {
         const auto& node = hier[m_selectedHierNode];
 
         float detailH = 160.f;
@@ -479,30 +506,27 @@ void GraphViewer::drawRulesTab()
     ImGui::PopStyleColor();
     ImGui::Separator();
 
-    for (int i = 0; i < (int)rules.size(); ++i) {
-        const auto& rule = rules[i];
-
-        // Kind badge
-        const char* kindStr = "?";
-        ImVec4 kindCol = {0.7f,0.7f,0.7f,1.f};
-        switch (rule.kind) {
-            case merrell::RuleKind::Starter:    kindStr="S";  kindCol={0.9f,0.8f,0.3f,1.f}; break;
-            case merrell::RuleKind::LoopGlue:   kindStr="L";  kindCol={0.3f,0.8f,0.7f,1.f}; break;
-            case merrell::RuleKind::BranchGlue: kindStr="B";  kindCol={0.8f,0.5f,0.3f,1.f}; break;
-            case merrell::RuleKind::Stub:        kindStr="Sb"; kindCol={0.6f,0.5f,0.8f,1.f}; break;
-            case merrell::RuleKind::General:    kindStr="G";  kindCol={0.7f,0.7f,0.9f,1.f}; break;
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rules.size());
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const auto& rule = rules[i];
+
+            // Kind badge
+            ImVec4 kindCol;
+            const char* kindStr = ruleKindBadge(rule.kind, kindCol);
+
+            char buf[128];
+            snprintf(buf, sizeof(buf), "[%s] %s##rulesel_%d",
+                kindStr, rule.name.empty() ? "(unnamed)" : rule.name.c_str(), i);
+
+            bool sel = (m_selectedRule == i);
+            ImGui::PushStyleColor(ImGuiCol_Header,
+                sel ? ImVec4{0.22f,0.40f,0.72f,0.8f} : ImVec4{0,0,0,0});
+            ImGui::PushStyleColor(ImGuiCol_Text, kindCol);
+            if (ImGui::Selectable(buf, sel)) m_selectedRule = i;
+            ImGui::PopStyleColor(2);
         }
-
-        char buf[128];
-        snprintf(buf, sizeof(buf), "[%s] %s##rulesel_%d",
-            kindStr, rule.name.empty() ? "(unnamed)" : rule.name.c_str(), i);
-
-        bool sel = (m_selectedRule == i);
-        ImGui::PushStyleColor(ImGuiCol_Header,
-            sel ? ImVec4{0.22f,0.40f,0.72f,0.8f} : ImVec4{0,0,0,0});
-        ImGui::PushStyleColor(ImGuiCol_Text, kindCol);
-        if (ImGui::Selectable(buf, sel)) m_selectedRule = i;
-        ImGui::PopStyleColor(2);
     }
 
     ImGui::EndChild();
@@ -510,10 +534,16 @@ void GraphViewer::drawRulesTab()
 
     ImGui::SameLine();
 
-    // Rule detail pane
+    // Rule detail pane, or every rule packed in a grid
     ImGui::BeginChild("##rule_detail", {-1.f, -1.f}, false);
 
-    if (m_selectedRule >= 0 && m_selectedRule < (int)rules.size()) {
+    ImGui::RadioButton("Rule##ruleview", &m_ruleView, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("Grid##ruleview", &m_ruleView, 1);
+
+    if (m_ruleView == 1) {
+        drawRuleGrid();
+    } else if (m_selectedRule >= 0 && m_selectedRule < (int)rules.size()) {
         const auto& rule = rules[m_selectedRule];
 
         float detailH = 120.f;
@@ -602,6 +632,252 @@ void GraphViewer::drawRulesTab()
     ImGui::EndChild();
 }
 
+// ============================================================
+// Overviews — cached layouts, clipped and level-of-detail drawing
+// ============================================================
+
+// Overview node sizes in canvas units
+static const float kDagNodeW  = 72.f, kDagNodeH  = 26.f;
+static const float kRuleCellW = 180.f, kRuleCellH = 40.f;
+
+// LOD thresholds: on-screen node width in pixels
+static const float kLabelMinPx = 44.f;   // below: plain boxes, tooltip on hover
+static const float kLinkMinPx  = 5.f;    // below: links are skipped as well
+
+static const float kMinZoom = 0.02f, kMaxZoom = 4.f;
+
+void GraphViewer::updateHierRows()
+{
+    if (m_hierRowsVersion == m_grammar->version()) return;
+    m_hierRowsVersion = m_grammar->version();
+
+    const auto& hier = m_grammar->hierarchy();
+    m_hierRows.clear();
+    m_hierRows.reserve(hier.size() + 8);
+    int curGen = -1;
+    for (int i = 0; i < (int)hier.size(); ++i) {
+        if (hier[i].generation != curGen) {
+            curGen = hier[i].generation;
+            m_hierRows.push_back(-curGen - 1);
+        }
+        m_hierRows.push_back(i);
+    }
+}
+
+void GraphViewer::updateDagLayout()
+{
+    const uint64_t version = m_grammar->version();
+
+    if (m_dagJob.valid() &&
+        m_dagJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        m_dagLayout   = m_dagJob.get();
+        m_dagView.fit = true;
+    }
+    // One job at a time; a stale result is replaced on the next call
+    if (m_dagJob.valid() || m_dagLayout.version == version) return;
+
+    // Snapshot only what the layout reads — the grammar can be re-extracted
+    // while the job runs
+    const auto& hier = m_grammar->hierarchy();
+    std::vector<GraphLayout::DagItem> items(hier.size());
+    for (size_t i = 0; i < hier.size(); ++i) {
+        items[i].id        = hier[i].id;
+        items[i].layer     = hier[i].generation;
+        items[i].parentIds = hier[i].parentIds;
+    }
+    m_dagJob = std::async(std::launch::async, [items = std::move(items), version]() {
+        GraphLayout layout = GraphLayout::sugiyama(items, kDagNodeW, kDagNodeH, 14.f, 44.f);
+        layout.version = version;
+        return layout;
+    });
+}
+
+void GraphViewer::updateGridLayout()
+{
+    const uint64_t version = m_grammar->version();
+    if (m_gridLayout.version == version) return;
+    m_gridLayout = GraphLayout::grid(m_grammar->ruleCount(), kRuleCellW, kRuleCellH, 8.f);
+    m_gridLayout.version = version;
+    m_gridView.fit = true;
+}
+
+int GraphViewer::drawLayoutCanvas(const char* id, const GraphLayout& layout, CanvasView& view,
+                                  int selected,
+                                  const std::function<void(int, char*, int)>& label,
+                                  const std::function<ImU32(int)>& fill)
+{
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 size   = ImGui::GetContentRegionAvail();
+    if (size.x < 8.f || size.y < 8.f || layout.empty()) return -1;
+
+    if (view.fit) {
+        const float margin = 20.f;
+        view.zoom = std::min((size.x - 2.f * margin) / std::max(layout.width,  1.f),
+                             (size.y - 2.f * margin) / std::max(layout.height, 1.f));
+        view.zoom = std::clamp(view.zoom, kMinZoom, 1.f);
+        view.pan  = ImVec2{ -(size.x / view.zoom - layout.width)  * 0.5f,
+                            -(size.y / view.zoom - layout.height) * 0.5f };
+        view.fit  = false;
+    }
+
+    // ---- Pan (left / middle drag) and zoom about the cursor (wheel) ----
+    ImGui::InvisibleButton(id, size,
+        ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+    const bool hovered = ImGui::IsItemHovered();
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (ImGui::IsItemActive() &&
+        (ImGui::IsMouseDragging(ImGuiMouseButton_Left) ||
+         ImGui::IsMouseDragging(ImGuiMouseButton_Middle))) {
+        view.pan.x -= io.MouseDelta.x / view.zoom;
+        view.pan.y -= io.MouseDelta.y / view.zoom;
+    }
+    if (hovered && io.MouseWheel != 0.f) {
+        const float mx = io.MousePos.x - origin.x, my = io.MousePos.y - origin.y;
+        const float ax = view.pan.x + mx / view.zoom, ay = view.pan.y + my / view.zoom;
+        view.zoom = std::clamp(view.zoom * std::pow(1.2f, io.MouseWheel), kMinZoom, kMaxZoom);
+        view.pan  = ImVec2{ ax - mx / view.zoom, ay - my / view.zoom };
+    }
+
+    auto toScreen = [&](float x, float y) {
+        return ImVec2{ origin.x + (x - view.pan.x) * view.zoom,
+                       origin.y + (y - view.pan.y) * view.zoom };
+    };
+
+    // Visible window in canvas units
+    const float vx0 = view.pan.x, vx1 = vx0 + size.x / view.zoom;
+    const float vy0 = view.pan.y, vy1 = vy0 + size.y / view.zoom;
+    const float nw  = layout.nodeW, nh = layout.nodeH;
+
+    const float pxW        = nw * view.zoom;
+    const bool  showLabels = pxW >= kLabelMinPx;
+    const bool  showLinks  = pxW >= kLinkMinPx;
+
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    dl->PushClipRect(origin, ImVec2{origin.x + size.x, origin.y + size.y}, true);
+
+    // ---- Links: parent bottom-centre → child top-centre ----
+    if (showLinks) {
+        for (const GraphLayout::Link& l : layout.links) {
+            const GraphLayout::Node& a = layout.nodes[l.from];
+            const GraphLayout::Node& b = layout.nodes[l.to];
+            const float ax = a.x + nw * 0.5f, ay = a.y + nh;
+            const float bx = b.x + nw * 0.5f, by = b.y;
+            if (std::max(ax, bx) < vx0 || std::min(ax, bx) > vx1 ||
+                std::max(ay, by) < vy0 || std::min(ay, by) > vy1)
+                continue;
+            const bool hot = l.from == selected || l.to == selected;
+            dl->AddLine(toScreen(ax, ay), toScreen(bx, by),
+                        hot ? IM_COL32(140, 190, 255, 230) : IM_COL32(90, 100, 130, 140),
+                        hot ? 2.f : 1.f);
+        }
+    }
+
+    // ---- Nodes ----
+    int  hoveredNode = -1;
+    char buf[128];
+    for (int i = 0; i < (int)layout.nodes.size(); ++i) {
+        const GraphLayout::Node& n = layout.nodes[i];
+        if (n.x > vx1 || n.x + nw < vx0 || n.y > vy1 || n.y + nh < vy0) continue;
+
+        const ImVec2 p0 = toScreen(n.x, n.y);
+        const ImVec2 p1 = ImVec2{p0.x + pxW, p0.y + nh * view.zoom};
+        dl->AddRectFilled(p0, p1, fill(i), showLabels ? 3.f : 0.f);
+        if (i == selected)
+            dl->AddRect(p0, p1, IM_COL32(240, 240, 255, 255), showLabels ? 3.f : 0.f, 0, 2.f);
+
+        if (showLabels) {
+            label(i, buf, (int)sizeof(buf));
+            dl->PushClipRect(p0, p1, true);
+            dl->AddText(ImVec2{p0.x + 5.f, p0.y + 3.f}, IM_COL32(230, 235, 250, 255), buf);
+            dl->PopClipRect();
+        }
+        if (hovered && io.MousePos.x >= p0.x && io.MousePos.x < p1.x &&
+                       io.MousePos.y >= p0.y && io.MousePos.y < p1.y)
+            hoveredNode = i;
+    }
+    dl->PopClipRect();
+
+    // Collapsed nodes still name themselves on hover
+    if (hoveredNode >= 0 && !showLabels) {
+        label(hoveredNode, buf, (int)sizeof(buf));
+        ImGui::SetTooltip("%s", buf);
+    }
+
+    // A click selects; a drag only pans
+    const float dragTol = io.MouseDragThreshold * io.MouseDragThreshold;
+    if (hoveredNode >= 0 && ImGui::IsMouseReleased(ImGuiMouseButton_Left) &&
+        io.MouseDragMaxDistanceSqr[ImGuiMouseButton_Left] < dragTol)
+        return hoveredNode;
+    return -1;
+}
+
+void GraphViewer::drawHierarchyDag()
+{
+    updateDagLayout();
+    const auto& hier = m_grammar->hierarchy();
+
+    if (m_dagLayout.version != m_grammar->version()) {
+        ImGui::TextDisabled("Laying out %d nodes...", (int)hier.size());
+        return;
+    }
+
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Fit##dag")) m_dagView.fit = true;
+    ImGui::SameLine();
+    ImGui::TextDisabled("%d nodes  %d links  —  drag to pan, wheel to zoom",
+        (int)m_dagLayout.nodes.size(), (int)m_dagLayout.links.size());
+
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4{0.06f, 0.07f, 0.10f, 1.f});
+    ImGui::BeginChild("##dag_canvas", {-1.f, -1.f}, true, ImGuiWindowFlags_NoScrollWithMouse);
+
+    int clicked = drawLayoutCanvas("##dag", m_dagLayout, m_dagView, m_selectedHierNode,
+        [&](int i, char* buf, int n) {
+            snprintf(buf, n, "N%d  f%d", hier[i].id, hier[i].graph.faceCount());
+        },
+        [&](int i) -> ImU32 {
+            if (hier[i].pruned)     return IM_COL32(120, 60, 55, 230);
+            if (hier[i].isComplete) return IM_COL32(45, 115, 60, 230);
+            return IM_COL32(50, 65, 100, 230);
+        });
+    if (clicked >= 0) m_selectedHierNode = clicked;
+
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+}
+
+void GraphViewer::drawRuleGrid()
+{
+    updateGridLayout();
+    const auto& rules = m_grammar->rules();
+
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Fit##grid")) m_gridView.fit = true;
+    ImGui::SameLine();
+    ImGui::TextDisabled("%d rules  —  drag to pan, wheel to zoom", (int)rules.size());
+
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4{0.06f, 0.07f, 0.10f, 1.f});
+    ImGui::BeginChild("##grid_canvas", {-1.f, -1.f}, true, ImGuiWindowFlags_NoScrollWithMouse);
+
+    int clicked = drawLayoutCanvas("##grid", m_gridLayout, m_gridView, m_selectedRule,
+        [&](int i, char* buf, int n) {
+            const auto& r = rules[i];
+            ImVec4 col;
+            snprintf(buf, n, "[%s] %s\nL%d  I%d  R%d", ruleKindBadge(r.kind, col),
+                r.name.empty() ? "(unnamed)" : r.name.c_str(),
+                r.L.faceCount(), r.I.faceCount(), r.R.faceCount());
+        },
+        [&](int i) -> ImU32 {
+            ImVec4 col;
+            ruleKindBadge(rules[i].kind, col);
+            return ImGui::ColorConvertFloat4ToU32({col.x * 0.45f, col.y * 0.45f, col.z * 0.45f, 0.9f});
+        });
+    if (clicked >= 0) m_selectedRule = clicked;
+
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+}
+
 // ============================================================
 // drawGraph — render a MerrellGraph directly via ImDrawList
 // ============================================================
@@ -643,12 +919,22 @@ int GraphViewer::drawGraph(const merrell::MerrellGraph& graph,
         };
     };
 
+    // Everything outside the canvas is skipped — large hierarchy nodes are
+    // mostly off-screen at this fixed scale. Margins cover labels.
+    const ImVec2 clipMin = dl->GetClipRectMin();
+    const ImVec2 clipMax = dl->GetClipRectMax();
+    auto offCanvas = [&](ImVec2 lo, ImVec2 hi, float margin) {
+        return hi.x < clipMin.x - margin || lo.x > clipMax.x + margin ||
+               hi.y < clipMin.y - margin || lo.y > clipMax.y + margin;
+    };
+
     // ── Draw faces (filled polygons as background) ───────────────────────────
+    std::vector<ImVec2>& poly = m_poly;
     for (const auto& f : graph.faces) {
         if (f.start_he == -1) continue;
 
         // Collect face boundary vertex positions
-        std::vector<ImVec2> poly;
+        poly.clear();
         int cur = f.start_he, safety = 0;
         do {
             const auto* he = graph.halfEdge(cur);
@@ -658,6 +944,14 @@ int GraphViewer::drawGraph(const merrell::MerrellGraph& graph,
             cur = he->next;
         } while (cur != f.start_he && safety < 200);
 
+        if (poly.empty()) continue;
+        ImVec2 lo = poly[0], hi = poly[0];
+        for (const ImVec2& p : poly) {
+            lo = ImVec2{std::min(lo.x, p.x), std::min(lo.y, p.y)};
+            hi = ImVec2{std::max(hi.x, p.x), std::max(hi.y, p.y)};
+        }
+        if (offCanvas(lo, hi, 0.f)) continue;
+
         if (poly.size() >= 3) {
             ImU32 fillCol = faceColour(f.label);
             // Make it semi-transparent so edges/labels show through
@@ -691,6 +985,9 @@ int GraphViewer::drawGraph(const merrell::MerrellGraph& graph,
 
         ImVec2 p0 = worldToScreen(v0->pos.x, v0->pos.y);
         ImVec2 p1 = worldToScreen(v1->pos.x, v1->pos.y);
+        if (offCanvas(ImVec2{std::min(p0.x, p1.x), std::min(p0.y, p1.y)},
+                      ImVec2{std::max(p0.x, p1.x), std::max(p0.y, p1.y)}, 120.f))
+            continue;
 
         // Direction vector
         float dx = p1.x - p0.x;
@@ -755,6 +1052,7 @@ int GraphViewer::drawGraph(const merrell::MerrellGraph& graph,
     // ── Draw vertices as filled circles ──────────────────────────────────────
     for (const auto& v : graph.vertices) {
         ImVec2 sp = worldToScreen(v.pos.x, v.pos.y);
+        if (offCanvas(sp, sp, kVtxR + 2.f)) continue;
 
         dl->AddCircleFilled(sp, kVtxR,     IM_COL32(30,  35,  50,  255));
         dl->AddCircle      (sp, kVtxR + 1, IM_COL32(180, 200, 240, 200), 16, 1.5f);
@@ -20,10 +20,21 @@
 //
 // Reads MerrellGrammar as const — never modifies grammar state.
 // Registered as a panel in App::render() under GRAPH_GRAMMAR mode.
+//
+// Large grammars: the node/rule lists are clipped to the visible rows, and
+// the Hierarchy (DAG) and Rules (Grid) overviews draw from a GraphLayout
+// cached per MerrellGrammar::version() — the DAG is laid out on a worker
+// thread. Overview canvases pan/zoom, skip everything off-screen, and drop
+// labels and links as nodes get small (level of detail).
 
 #include "../grammar-core/MerrellGrammar.h"
 #include "../../src/EditorUI.h"
+#include "GraphLayout.h"
 #include <imnodes.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <vector>
 
 class GraphViewer
 {
@@ -38,6 +49,13 @@ public:
     bool isOpen()           const { return m_open; }
     void setOpen(bool open)       { m_open = open; }
 
+    // Background DAG layout still running — its result is picked up by a
+    // later draw, so keep drawing until it lands.
+    bool layoutPending() const {
+        return m_dagJob.valid() &&
+               m_dagJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
 private:
     const merrell::MerrellGrammar* m_grammar = nullptr;
     bool m_open       = true;
@@ -54,6 +72,45 @@ private:
     void ensureContext();
     void destroyContext();
 
+    // ---- Overviews ---------------------------------------------------------
+    // Pan/zoom state of one overview canvas. fit: frame the whole layout on
+    // the next draw (new layout or "Fit" pressed).
+    struct CanvasView {
+        ImVec2 pan  = {0.f, 0.f};   // canvas units at the top-left corner
+        float  zoom = 1.f;          // pixels per canvas unit
+        bool   fit  = true;
+    };
+
+    int  m_hierView = 0;   // 0=Graph (selected node)  1=DAG
+    int  m_ruleView = 0;   // 0=Rule (selected rule)   1=Grid
+
+    GraphLayout              m_dagLayout;
+    std::future<GraphLayout> m_dagJob;          // pending background layout
+    CanvasView               m_dagView;
+
+    GraphLayout m_gridLayout;
+    CanvasView  m_gridView;
+
+    // Hierarchy list rows: node index, or -(generation + 1) for a header
+    std::vector<int> m_hierRows;
+    uint64_t         m_hierRowsVersion = ~0ull;
+
+    std::vector<ImVec2> m_poly;   // drawGraph face scratch, reused per frame
+
+    void updateDagLayout();       // start / collect the background layout
+    void updateGridLayout();
+    void updateHierRows();
+
+    // Draws a layout into the current child window. Returns the node index
+    // clicked this frame, or -1. label/fill are only called for visible nodes.
+    int drawLayoutCanvas(const char* id, const GraphLayout& layout, CanvasView& view,
+                         int selected,
+                         const std::function<void(int, char*, int)>& label,
+                         const std::function<ImU32(int)>& fill);
+
+    void drawHierarchyDag();
+    void drawRuleGrid();
+
     // ---- Tab drawing -------------------------------------------------------
     void drawPrimitivesTab();
     void drawHierarchyTab();
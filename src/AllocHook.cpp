@@ -0,0 +1,46 @@
+// ============================================================
+// AllocHook — global operator new/delete that count allocations
+//
+// Not part of mythos-core: only programs that link this file pay for it
+// (mythos-bench, and the editor when configured with MYTHOS_COUNT_ALLOCS).
+// Counts land in MemoryStats::threadAllocations(). Over-aligned new is
+// left to the library and not counted.
+// ============================================================
+
+#include "MemoryStats.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+struct HookRegistrar {
+    HookRegistrar() { MemoryStats::detail::setHookLinked(); }
+} s_registrar;
+
+void* countedAlloc(std::size_t n)
+{
+    MemoryStats::detail::noteAllocation();
+    return std::malloc(n ? n : 1);
+}
+} // namespace
+
+void* operator new(std::size_t n)
+{
+    if (void* p = countedAlloc(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n)
+{
+    if (void* p = countedAlloc(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new  (std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+
+void operator delete  (void* p) noexcept                        { std::free(p); }
+void operator delete[](void* p) noexcept                        { std::free(p); }
+void operator delete  (void* p, std::size_t) noexcept           { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept           { std::free(p); }
+void operator delete  (void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
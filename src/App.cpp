@@ -12,6 +12,9 @@
 #include "FileDialog.h"
 #include "ProjectFile.h"
 #include "MeshMerge.h"
+#include "ContentHash.h"
+#include "GpuProfiler.h"
+#include "ShaderCache.h"
 #include "../lib/grammar-core/HalfEdgeMesh.h"
 
 #include <imgui.h>
@@ -24,11 +27,14 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 #include <iostream>
+#include <unordered_set>
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <cmath>
 
+static App* self(GLFWwindow* w) { return static_cast<App*>(glfwGetWindowUserPointer(w)); }
+
 static std::string exeDir()
 {
 #ifdef _WIN32
@@ -48,6 +54,18 @@ static std::string exeDir()
 
 bool App::init(int width, int height, const std::string& title)
 {
+    MYTHOS_PROFILE_THREAD("Main");
+
+    // A replay brings its own startup state (scene, play mode, window size)
+    if (!m_benchCfg.replayPath.empty()) {
+        if (!m_recorder.load(m_benchCfg.replayPath, m_benchCfg)) return false;
+        width  = m_benchCfg.width;
+        height = m_benchCfg.height;
+        m_benchCfg.warmup = std::min(m_benchCfg.warmup, m_recorder.frameCount() - 1);
+        m_benchCfg.frames = m_recorder.frameCount() - m_benchCfg.warmup;
+        m_replaying = true;
+    }
+
     if (!glfwInit()) { std::cerr << "[App] glfwInit failed\n"; return false; }
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -74,6 +92,14 @@ bool App::init(int width, int height, const std::string& title)
     glfwSetScrollCallback     (m_window, cbScroll);
     glfwSetKeyCallback        (m_window, cbKey);
 
+    // Window changes that need a redraw without any input (redraw on demand).
+    // Registered before ImGui so its backend chains to them.
+    glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow* w, int, int)  { self(w)->requestRedraw(); });
+    glfwSetWindowRefreshCallback  (m_window, [](GLFWwindow* w)            { self(w)->requestRedraw(); });
+    glfwSetWindowFocusCallback    (m_window, cbFocus);
+    glfwSetCursorEnterCallback    (m_window, cbCursorEnter);
+    glfwSetCharCallback           (m_window, cbChar);
+
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
@@ -82,14 +108,27 @@ bool App::init(int width, int height, const std::string& title)
     ImGui_ImplGlfw_InitForOpenGL(m_window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
+    // Recorded sessions start from the default layout so replays match
+    if (m_replaying || !m_benchCfg.recordPath.empty()) io.IniFilename = nullptr;
+    // Replay feeds ImGui itself (injectReplayInput) — unhook the backend
+    // from live input
+    if (m_replaying) ImGui_ImplGlfw_RestoreCallbacks(m_window);
+
     m_ui.init();
 
+    // Program binaries from the last run; written back once every editor
+    // shader has been built (renderer + thumbnails)
+    ShaderCache::open(exeDir() + "editor_shaders.bin");
     if (!m_renderer.init()) { std::cerr << "[App] Renderer init failed\n"; return false; }
+    GpuProfiler::init();
 
     std::string libPath = exeDir() + "editor_assets.json";
+    m_assetLibrary.library().setMeshRegistry(&m_meshLib.registry());
     m_assetLibrary.init(libPath);
+    ShaderCache::save();
 
     m_grammar.init(m_scene, m_meshLib);
+    m_grammar.setHistory(&m_history);
 
     // ---- Merrell DPO grammar (MG-1+) init ----------------------------------
     // MINIMAL TEST INPUT — 2 tile types for readable hierarchy output.
@@ -148,9 +187,42 @@ bool App::init(int width, int height, const std::string& title)
     m_camera.pitch  =  30.f;
     m_camera.dist   =  50.f;
 
+    // ---- Command-line scene / benchmark ----
+    if (!m_benchCfg.scenePath.empty()) {
+        if (!ProjectFile::load(m_benchCfg.scenePath, m_camera, m_grammar, m_scene, m_meshLib)) {
+            std::cerr << "[App] Cannot load " << m_benchCfg.scenePath << ": "
+                      << ProjectFile::lastError() << "\n";
+            return false;
+        }
+        m_uiState.projectPath = m_benchCfg.scenePath;
+        m_stressStats = {};
+        m_stressStats.objects = m_scene.objectCount();
+        for (const auto& o : m_scene.objects())
+            if (o.mesh) m_stressStats.triangles += o.mesh->triangleCount();
+    } else if (m_benchCfg.stressScene) {
+        generateStressScene(m_benchCfg.stress);
+    }
+    if (m_benchCfg.enabled) {
+        if (m_benchCfg.play) m_uiState.mode = EditorMode::PLAY;
+        m_bench.begin(m_benchCfg, m_scene);
+    }
+
     m_prevTime = glfwGetTime();
     m_fpsTime  = m_prevTime;
     glfwGetCursorPos(m_window, &m_lastMX, &m_lastMY);
+
+    if (!m_benchCfg.recordPath.empty()) {
+        if (!m_recorder.startRecording(m_benchCfg.recordPath, m_benchCfg)) return false;
+        // Where the cursor starts — no event reports it until it moves
+        InputEvent enter;
+        enter.type = InputEventType::CursorEnter;
+        enter.i[0] = glfwGetWindowAttrib(m_window, GLFW_HOVERED);
+        m_recorder.record(enter);
+        InputEvent pos;
+        pos.x = m_lastMX;
+        pos.y = m_lastMY;
+        m_recorder.record(pos);
+    }
     return true;
 }
 
@@ -164,10 +236,25 @@ void App::run()
 
     while (!glfwWindowShouldClose(m_window))
     {
+        // Block on events while idle — before the frame mark, so idle time
+        // is not charged to a frame
+        if (!m_bench.active()) waitWhileIdle();
+
+        MYTHOS_PROFILE_FRAME();
+        MYTHOS_GPU_FRAME();
+
         double now = glfwGetTime();
         double dt  = std::min(now - m_prevTime, 0.1);
         m_prevTime = now;
 
+        // Benchmark: scripted camera/selection and a fixed time step, or the
+        // recorded time step when replaying
+        const bool benchmarking = m_bench.active();
+        if (benchmarking) {
+            m_bench.applyFrame(m_scene, m_camera);
+            dt = m_replaying ? m_recorder.frame(m_bench.frame()).dt : BenchmarkMode::kFixedDt;
+        }
+
         m_fpsFrames++;
         if (now - m_fpsTime >= 1.0) {
             m_uiState.fps = (float)(m_fpsFrames / (now - m_fpsTime));
@@ -175,17 +262,39 @@ void App::run()
             m_fpsTime     = now;
         }
 
-        glfwPollEvents();
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-        ImGuizmo::BeginFrame();
+        {
+            MYTHOS_PROFILE_SCOPE("App::pollEvents");
+            glfwPollEvents();
+            if (m_replaying) injectReplayInput();
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            if (m_replaying) ImGui::GetIO().DeltaTime = (float)dt;
+            ImGui::NewFrame();
+            ImGuizmo::BeginFrame();
+        }
 
-        m_input.update();
-        update(dt);
+        {
+            MYTHOS_PROFILE_SCOPE("App::update");
+            m_input.update();
+            update(dt);
+        }
+        m_bench.lap(BenchPhase::Update);
         render();
+        updateRedrawState();
 
-        glfwSwapBuffers(m_window);
+        {
+            MYTHOS_PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(m_window);
+        }
+        if (m_recorder.recording()) m_recorder.endFrame(dt);
+
+        if (benchmarking) {
+            glFinish();   // charge the GPU work to this frame
+            m_bench.lap(BenchPhase::Present);
+            m_bench.endFrame(m_uiState.numDrawn);
+            if (m_bench.finished()) { finishBenchmark(); break; }
+            continue;     // no frame cap — measure raw frame time
+        }
 
         // Soft frame cap — sleep off any spare time so we don't burn 100% CPU
         double elapsed = glfwGetTime() - now;
@@ -199,6 +308,128 @@ void App::run()
     }
 }
 
+// ============================================================
+// Redraw on demand
+// ============================================================
+
+// Work that changes the picture without any input event. Static batches only
+// update and draw in PLAY, which redraws every frame anyway.
+bool App::isAnimating() const
+{
+    return m_uiState.mode == EditorMode::PLAY
+        || m_grammar.isGenerating()
+        || (m_uiState.mode == EditorMode::GRAPH_GRAMMAR && m_graphViewer.layoutPending())
+        || m_assetLibrary.backgroundBusy()
+        || (m_uiState.mode == EditorMode::EDITOR && m_assetLibrary.thumbnailsQueued())
+        || (!m_uiState.statusMsg.empty() && glfwGetTime() < m_uiState.statusExpiry);
+}
+
+void App::updateRedrawState()
+{
+    const bool cameraMoved = m_camera.target != m_drawnCamera.target ||
+                             m_camera.yaw    != m_drawnCamera.yaw    ||
+                             m_camera.pitch  != m_drawnCamera.pitch  ||
+                             m_camera.dist   != m_drawnCamera.dist;
+
+    if (cameraMoved || m_scene.version() != m_drawnSceneVersion || isAnimating())
+        requestRedraw();
+
+    m_drawnCamera       = m_camera;
+    m_drawnSceneVersion = m_scene.version();
+}
+
+void App::waitWhileIdle()
+{
+    if (!m_uiState.redrawOnDemand || glfwGetTime() < m_redrawUntil) return;
+
+    // Input arriving during the wait calls requestRedraw() via the callbacks
+    if (m_uiState.idleFps > 0) glfwWaitEventsTimeout(1.0 / m_uiState.idleFps);
+    else                       glfwWaitEvents();
+}
+
+// ============================================================
+// Stress scene / benchmark
+// ============================================================
+
+void App::generateStressScene(const StressSceneParams& params)
+{
+    m_stressStats = StressScene::populate(m_scene, params);
+
+    // Frame the whole grid
+    glm::vec3 lo(1e9f), hi(-1e9f);
+    for (const auto& o : m_scene.objects()) {
+        lo = glm::min(lo, o.position);
+        hi = glm::max(hi, o.position);
+    }
+    if (!m_scene.objects().empty()) {
+        m_camera.target = (lo + hi) * 0.5f;
+        m_camera.dist   = std::min(glm::length(hi - lo) * 0.8f + 10.f, Camera::kFar * 0.8f);
+    }
+}
+
+void App::finishBenchmark()
+{
+    int fw, fh;
+    glfwGetFramebufferSize(m_window, &fw, &fh);
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    const char* version  = (const char*)glGetString(GL_VERSION);
+
+    if (!m_bench.writeReport(renderer ? renderer : "", version ? version : "",
+                             fw, fh, m_stressStats))
+        m_exitCode = 1;
+    glfwSetWindowShouldClose(m_window, true);
+}
+
+// ============================================================
+// Mesh residency
+// ============================================================
+// Periodically compresses / evicts the CPU copy of meshes that nobody read
+// since the previous pass (MeshAsset::ensureResident marks a read). Skipped
+// while background jobs might be reading mesh data on worker threads.
+
+void App::updateMeshResidency(double dt)
+{
+    m_residencyTimer += dt;
+    if (m_residencyTimer < kResidencyPeriod) return;
+    m_residencyTimer = 0.0;
+
+    // Unique meshes of the scene and the asset library
+    std::unordered_set<MeshAsset*> meshes;
+    for (const auto& o : m_scene.objects())
+        if (o.mesh) meshes.insert(o.mesh.get());
+    for (const auto& e : m_assetLibrary.library().entries())
+        if (e.mesh && e.loadState == AssetLoadState::Loaded) meshes.insert(e.mesh.get());
+
+    const auto policy = (MeshResidency)m_uiState.meshResidency;
+    const bool busy   = m_batcher.busy() || m_assetLibrary.backgroundBusy();
+
+    size_t freed = 0, total = 0;
+    for (MeshAsset* m : meshes) {
+        if (!busy && policy != MeshResidency::Keep) {
+            if (m->dataAccessed) m->dataAccessed = false;   // in use — next pass
+            else                 freed += m->releaseData(policy);
+        }
+        total += m->cpuBytes();
+    }
+    m_uiState.meshCpuBytes = total;
+    if (freed)
+        std::cout << "[App] Mesh residency: released " << freed / 1024 << " KB\n";
+}
+
+// ============================================================
+// Memory stats
+// ============================================================
+// Everything else updates its MemoryStats handle where it allocates; the
+// scene is too fine-grained for that and is re-measured on a timer instead.
+
+void App::updateMemoryStats(double dt)
+{
+    m_memoryTimer += dt;
+    if (m_memoryTimer < kMemoryPeriod) return;
+    m_memoryTimer = 0.0;
+    m_sceneMem.set(m_scene.memoryBytes() + Scene::objectsBytes(m_clipboard));
+}
+
 // ============================================================
 // Update
 // ============================================================
@@ -206,6 +437,22 @@ void App::run()
 void App::update(double dt)
 {
     m_grammar.update(m_scene, m_meshLib, dt);
+
+    // Static batches are only drawn in PLAY, so only kept current there —
+    // per-frame edits in EDITOR would otherwise re-merge chunks continuously.
+    // Leaving PLAY or turning batching off frees the chunk meshes.
+    if (m_uiState.mode == EditorMode::PLAY && m_uiState.staticBatching)
+        m_batcher.update(m_scene);
+    else
+        m_batcher.release();
+    // Not only while the library panel draws — placed placeholders wait on
+    // these in every mode. Merge workers may be reading a placeholder's data.
+    m_assetLibrary.pollLoads(m_scene, !m_batcher.busy());
+    updateMeshResidency(dt);
+    updateMemoryStats(dt);
+    m_history.setBudget((size_t)m_uiState.undoBudgetMB << 20);
+    m_uiState.undoBytes = m_history.bytesUsed();
+    m_uiState.undoSteps = m_history.size();
     m_uiState.numObjects  = m_scene.objectCount();
     m_uiState.numSelected = m_scene.selectedCount();
 
@@ -232,7 +479,7 @@ void App::update(double dt)
         if (sel->mesh)
             snprintf(m_uiState.inspMeshInfo, sizeof(m_uiState.inspMeshInfo),
                      "%s  (%d tris)", sel->mesh->name.c_str(),
-                     (int)sel->mesh->data.indices.size() / 3);
+                     sel->mesh->triangleCount());
         else
             m_uiState.inspMeshInfo[0] = '\0';
     }
@@ -271,18 +518,75 @@ void App::update(double dt)
 
 void App::render()
 {
+    MYTHOS_PROFILE_SCOPE("App::render");
     int fw, fh;
     glfwGetFramebufferSize(m_window, &fw, &fh);
 
-    m_renderer.beginFrame(fw, fh);
+    m_renderer.beginFrame(m_camera, fw, fh);
 
     // Wireframe mode — apply before drawing scene objects, restore after
     if (m_uiState.wireframeMode)
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
+    // ---- Visibility ----
+    const auto& objects = m_scene.objects();
+    float aspect = (fh > 0) ? (float)fw / (float)fh : 1.f;
+    CullParams cp;
+    cp.viewProj       = m_camera.projMatrix(aspect) * m_camera.viewMatrix();
+    cp.eye            = m_camera.position();
+    cp.maxDistance    = m_uiState.cullDistanceEnabled ? m_uiState.cullMaxDistance : 0.f;
+    cp.minPixels      = m_uiState.cullMinPixels;
+    cp.viewportHeight = (float)fh;
+    cp.fovY           = Camera::kFovY;
+
+    m_visible.clear();
+    if (m_uiState.cullEnabled) {
+        if (m_culler.builtVersion() != m_scene.version()) {
+            m_culler.rebuild(objects);
+            m_culler.setBuiltVersion(m_scene.version());
+        }
+        m_culler.cull(cp, m_visible);
+
+        // Occlusion would hide geometry that wireframe is meant to show through
+        if (m_uiState.occlusionEnabled && !m_uiState.wireframeMode) {
+            OcclusionParams op;
+            op.viewProj = cp.viewProj;
+            m_occlusion.cull(objects, m_visible, op);
+        }
+    } else {
+        for (int i = 0; i < (int)objects.size(); ++i)
+            if (objects[i].visible) m_visible.push_back(i);
+    }
+
+    // ---- PLAY: static chunk batches replace the objects they cover ----
+    const bool batching = m_uiState.mode == EditorMode::PLAY && m_uiState.staticBatching;
+    m_chunkVisible.clear();
+    if (batching) {
+        const auto& mask = m_batcher.batchedMask();
+        m_visible.erase(std::remove_if(m_visible.begin(), m_visible.end(),
+                            [&](int i) { return i < (int)mask.size() && mask[i]; }),
+                        m_visible.end());
+
+        const auto& chunks = m_batcher.chunkObjects();
+        if (m_uiState.cullEnabled) {
+            if (m_chunkCuller.builtVersion() != m_batcher.version()) {
+                m_chunkCuller.rebuild(chunks);
+                m_chunkCuller.setBuiltVersion(m_batcher.version());
+            }
+            CullParams chunkCp = cp;
+            chunkCp.minPixels = 0.f;   // chunks are large; size culling is per object
+            m_chunkCuller.cull(chunkCp, m_chunkVisible);
+        } else {
+            for (int i = 0; i < (int)chunks.size(); ++i) m_chunkVisible.push_back(i);
+        }
+    }
+    m_uiState.numDrawn = (int)(m_visible.size() + m_chunkVisible.size());
+    m_bench.lap(BenchPhase::Visibility);
+
     // Draw opaque geometry first so the grid depth-tests against it correctly
-    for (auto& obj : m_scene.objects())
-        m_renderer.drawSceneObject(m_camera, obj, fw, fh);
+    m_renderer.drawScene(m_camera, objects, m_visible, fw, fh);
+    if (!m_chunkVisible.empty())
+        m_renderer.drawScene(m_camera, m_batcher.chunkObjects(), m_chunkVisible, fw, fh);
 
     m_grammar.drawLivePath(m_renderer, m_camera, fw, fh);
 
@@ -305,6 +609,7 @@ void App::render()
     }
 
     m_renderer.endFrame();
+    m_bench.lap(BenchPhase::Draw);
 
     // ---- ImGui ----
     bool keepRunning = m_ui.render(m_uiState);
@@ -361,6 +666,23 @@ void App::render()
         }
         m_uiState.statusExpiry = glfwGetTime() + 3.0;
     }
+    if (m_uiState.stressGenerate) {
+        m_uiState.stressGenerate = false;
+        StressSceneParams p;
+        p.objectCount      = m_uiState.stressObjects;
+        p.meshSegments     = m_uiState.stressSegments;
+        p.instancingRatio  = m_uiState.stressInstancing;
+        p.socketsPerObject = m_uiState.stressSockets;
+        p.seed             = (uint32_t)m_uiState.stressSeed;
+        generateStressScene(p);
+        m_history.clear();
+        m_uiState.projectPath.clear();
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Stress scene: %d objects, %d meshes (%.0f ms)",
+                 m_stressStats.objects, m_stressStats.meshes, m_stressStats.buildMs);
+        m_uiState.statusMsg    = buf;
+        m_uiState.statusExpiry = glfwGetTime() + 3.0;
+    }
 
     if (m_uiState.mode != EditorMode::PLAY && !m_uiState.panelsHidden) {
         // ---- Mode transition side effects (fire exactly once per transition) ----
@@ -405,6 +727,16 @@ void App::render()
             m_uiState.showGraphViewer = m_graphViewer.isOpen();
         }
 
+        // Profiler — any mode
+        m_profilerView.setOpen(m_uiState.showProfiler);
+        m_profilerView.draw();
+        m_uiState.showProfiler = m_profilerView.isOpen();
+
+        // Memory — any mode
+        m_memoryView.setOpen(m_uiState.showMemory);
+        m_memoryView.draw();
+        m_uiState.showMemory = m_memoryView.isOpen();
+
         // Scene actions (gizmo buttons, snap, etc.) — only in EDITOR mode
         if (m_uiState.mode == EditorMode::EDITOR)
             drawSceneActions();
@@ -427,6 +759,7 @@ void App::render()
             sel->position = m_uiState.inspPos;
             sel->rotation = m_uiState.inspRot;
             sel->scale    = m_uiState.inspScale;
+            m_scene.touch();
         }
         m_uiState.inspectorDirty = false;
     }
@@ -447,8 +780,13 @@ void App::render()
     // Record mode for transition detection next frame
     m_uiState.prevMode = m_uiState.mode;
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+        MYTHOS_PROFILE_SCOPE("ImGui::Render");
+        MYTHOS_GPU_SCOPE("ImGui");
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    m_bench.lap(BenchPhase::Ui);
 }
 
 // ============================================================
@@ -519,20 +857,33 @@ void App::drawSceneActions()
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, {0.65f,0.50f,0.20f,1.f});
 
     auto doMerge = [&](bool weld) {
+        // Every source must have CPU data — merging one whose data could not
+        // be restored would read its submesh ranges out of bounds
         std::vector<const SceneObject*> objs;
         for (int id : m_scene.selectedIds())
-            if (auto* o = m_scene.findById(id)) objs.push_back(o);
+            if (auto* o = m_scene.findById(id)) {
+                if (o->mesh && !o->mesh->ensureResident()) {
+                    m_uiState.statusMsg    = "Cannot merge: mesh data of '" + o->name
+                                           + "' is unavailable (source file missing or changed)";
+                    m_uiState.statusExpiry = glfwGetTime() + 3.0;
+                    return;
+                }
+                objs.push_back(o);
+            }
         if (objs.size() < 2) return;
 
         std::vector<SceneObject> snapshots;
-        for (auto* o : objs) snapshots.push_back(*o);
+        for (auto* o : objs) snapshots.push_back(SceneDelta::stored(*o));
 
         std::string mname = "merged_" + std::to_string(m_scene.selectedId());
         MeshMerge::Result res = weld
             ? MeshMerge::mergeAndWeld(objs, mname, 0.001f)
             : MeshMerge::merge(objs, mname);
 
-        if (!res.asset->upload()) return;
+        // Re-merging identical geometry (e.g. after an undo) reuses the
+        // existing asset and its GPU buffers
+        res.asset = m_meshLib.registry().intern(res.asset);
+        if (!res.asset->isLoaded() && !res.asset->upload()) return;
 
         addMergedToLibrary(res.asset, mname);
 
@@ -545,23 +896,18 @@ void App::drawSceneActions()
 
         std::vector<int> oldIds;
         for (auto* o : objs) oldIds.push_back(o->id);
-        for (int id : oldIds) m_scene.removeObject(id);
+        m_scene.removeObjects(oldIds);
         m_scene.selectById(newId);
 
         std::string cmdName = std::string(weld ? "Merge+Weld " : "Merge ") +
                               std::to_string(snapshots.size()) + " objects";
-        m_history.execute({
-            cmdName,
-            [](){},
-            [this, snapshots, newId]() {
-                m_scene.removeObject(newId);
-                for (const auto& snap : snapshots) {
-                    SceneObject& o = m_scene.addObject();
-                    o = snap;
-                }
-                m_scene.selectNone();
-            }
-        });
+        SceneDelta delta;
+        delta.removed = std::move(snapshots);
+        if (const SceneObject* o = m_scene.findById(newId))
+            delta.added.push_back(SceneDelta::stored(*o));
+        Command cmd = makeDeltaCommand(cmdName, m_scene, std::move(delta));
+        cmd.undo = [this, undo = std::move(cmd.undo)]() { undo(); m_scene.selectNone(); };
+        m_history.push(std::move(cmd));
     };
 
     if (ImGui::Button("Merge Selected", {-1,0})) doMerge(false);
@@ -582,9 +928,9 @@ void App::drawSceneActions()
     ImGui::PushStyleColor(ImGuiCol_Button,        {0.20f,0.40f,0.55f,1.f});
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, {0.28f,0.55f,0.75f,1.f});
 
-    bool hasMesh = sel->mesh && !sel->mesh->data.indices.empty();
+    bool hasMesh = sel->mesh && sel->mesh->triangleCount() > 0;
     ImGui::BeginDisabled(!hasMesh);
-    if (ImGui::Button("Build Half-Edge Split", {-1,0})) {
+    if (ImGui::Button("Build Half-Edge Split", {-1,0}) && sel->mesh->ensureResident()) {
         grammar::HalfEdgeMesh hem;
         std::cout << "\n[HalfEdge] ======= Building from: "
                   << sel->name << " =======\n";
@@ -633,8 +979,11 @@ void App::drawSceneActions()
 
 void App::shutdown()
 {
+    m_recorder.stopRecording();
     m_assetLibrary.shutdown();
+    m_batcher.clear();   // chunk meshes own GL buffers — free while the context lives
     m_renderer.shutdown();
+    GpuProfiler::shutdown();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -646,14 +995,107 @@ void App::shutdown()
 // GLFW callbacks
 // ============================================================
 
+// Every input event also ends an idle wait (redraw on demand) and is
+// recorded with --record. Live input is dropped while replaying.
+static InputEvent makeEvent(InputEventType type, int a = 0, int b = 0, int c = 0, int d = 0)
+{
+    InputEvent e;
+    e.type = type;
+    e.i[0] = a; e.i[1] = b; e.i[2] = c; e.i[3] = d;
+    return e;
+}
+
 void App::cbMouseButton(GLFWwindow* w,int b,int a,int m)
-{ static_cast<App*>(glfwGetWindowUserPointer(w))->onMouseButton(b,a,m); }
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    app->m_recorder.record(makeEvent(InputEventType::MouseButton, b, a, m));
+    app->requestRedraw(); app->onMouseButton(b,a,m);
+}
 void App::cbCursorPos(GLFWwindow* w,double x,double y)
-{ static_cast<App*>(glfwGetWindowUserPointer(w))->onCursorPos(x,y); }
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    InputEvent e = makeEvent(InputEventType::CursorPos);
+    e.x = x; e.y = y;
+    app->m_recorder.record(e);
+    app->requestRedraw(); app->onCursorPos(x,y);
+}
 void App::cbScroll(GLFWwindow* w,double x,double y)
-{ static_cast<App*>(glfwGetWindowUserPointer(w))->onScroll(x,y); }
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    InputEvent e = makeEvent(InputEventType::Scroll);
+    e.x = x; e.y = y;
+    app->m_recorder.record(e);
+    app->requestRedraw(); app->onScroll(x,y);
+}
 void App::cbKey(GLFWwindow* w,int k,int s,int a,int m)
-{ static_cast<App*>(glfwGetWindowUserPointer(w))->onKey(k,s,a,m); }
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    app->m_recorder.record(makeEvent(InputEventType::Key, k, s, a, m));
+    app->requestRedraw(); app->onKey(k,s,a,m);
+}
+void App::cbChar(GLFWwindow* w,unsigned c)
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    app->m_recorder.record(makeEvent(InputEventType::Char, (int)c));
+    app->requestRedraw();
+}
+void App::cbCursorEnter(GLFWwindow* w,int entered)
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    app->m_recorder.record(makeEvent(InputEventType::CursorEnter, entered));
+    app->requestRedraw();
+}
+void App::cbFocus(GLFWwindow* w,int focused)
+{
+    App* app = self(w);
+    if (!app->liveInput()) return;
+    app->m_recorder.record(makeEvent(InputEventType::Focus, focused));
+    app->requestRedraw();
+}
+
+// Replays this frame's recorded events in order, to ImGui's backend first
+// and then to App — the same order the chained callbacks run in live.
+void App::injectReplayInput()
+{
+    const int f = m_bench.frame();
+    if (f >= m_recorder.frameCount()) return;
+
+    for (const InputEvent& e : m_recorder.frame(f).events) {
+        switch (e.type) {
+            case InputEventType::MouseButton:
+                ImGui_ImplGlfw_MouseButtonCallback(m_window, e.i[0], e.i[1], e.i[2]);
+                onMouseButton(e.i[0], e.i[1], e.i[2]);
+                break;
+            case InputEventType::CursorPos:
+                ImGui_ImplGlfw_CursorPosCallback(m_window, e.x, e.y);
+                onCursorPos(e.x, e.y);
+                break;
+            case InputEventType::Scroll:
+                ImGui_ImplGlfw_ScrollCallback(m_window, e.x, e.y);
+                onScroll(e.x, e.y);
+                break;
+            case InputEventType::Key:
+                ImGui_ImplGlfw_KeyCallback(m_window, e.i[0], e.i[1], e.i[2], e.i[3]);
+                onKey(e.i[0], e.i[1], e.i[2], e.i[3]);
+                break;
+            case InputEventType::Char:
+                ImGui_ImplGlfw_CharCallback(m_window, (unsigned)e.i[0]);
+                break;
+            case InputEventType::CursorEnter:
+                ImGui_ImplGlfw_CursorEnterCallback(m_window, e.i[0]);
+                break;
+            case InputEventType::Focus:
+                ImGui_ImplGlfw_WindowFocusCallback(m_window, e.i[0]);
+                break;
+        }
+    }
+}
 
 void App::onMouseButton(int btn, int action, int mods)
 {
@@ -745,10 +1187,12 @@ void App::onKey(int key, int /*sc*/, int action, int mods)
         return;
     }
 
-    // Undo / Redo — work regardless of keyboard focus
+    // Undo / Redo — work regardless of keyboard focus. Not while the grammar
+    // is mid-generation: it owns the scene until it commits its own entry.
+    if (ctrl && (key == GLFW_KEY_Z || key == GLFW_KEY_Y) && m_grammar.isGenerating()) return;
+    if (ctrl && shift && key == GLFW_KEY_Z) { m_history.redo(); return; }
     if (ctrl && key == GLFW_KEY_Z) { m_history.undo(); return; }
     if (ctrl && key == GLFW_KEY_Y) { m_history.redo(); return; }
-    if (ctrl && shift && key == GLFW_KEY_Z) { m_history.redo(); return; }
 
     // Copy / Paste / Select All
     if (ctrl && key == GLFW_KEY_C) { copySelection(); return; }
@@ -851,6 +1295,7 @@ void App::drawGizmo()
                 }
             }
         }
+        m_scene.touch();
 
         // Keep pivot snapshot current so delta is frame-relative
         m_gizmoPivotPre = newPivotMatrix;
@@ -891,19 +1336,22 @@ void App::commitMultiTransformCommand(
     }
     if (!changed) return;
 
-    m_history.execute({
+    // Struct-of-arrays delta holding only the channels that moved
+    SceneDelta delta;
+    delta.moved.ids.reserve(pre.size());
+    for (auto& [id, ps] : pre) {
+        auto it = post.find(id);
+        if (it != post.end()) delta.moved.add(id, ps, it->second);
+    }
+    delta.moved.finish();
+
+    // The objects already sit at `post` (gizmo / inspector wrote them).
+    // Callers like Snap to Grid write transforms directly, so bump the scene
+    // version here — culling, batching and occlusion rebuild from it.
+    m_history.push(makeDeltaCommand(
         pre.size() == 1 ? "Transform" : "Transform " + std::to_string(pre.size()) + " objects",
-        [this, post]() {
-            for (auto& [id, snap] : post)
-                if (auto* o = m_scene.findById(id))
-                    { o->position = snap.pos; o->rotation = snap.rot; o->scale = snap.scl; }
-        },
-        [this, pre]() {
-            for (auto& [id, snap] : pre)
-                if (auto* o = m_scene.findById(id))
-                    { o->position = snap.pos; o->rotation = snap.rot; o->scale = snap.scl; }
-        }
-    });
+        m_scene, std::move(delta)));
+    m_scene.touch();
 }
 
 void App::copySelection()
@@ -918,8 +1366,9 @@ void App::pasteClipboard()
 {
     if (m_clipboard.empty()) return;
     m_scene.selectNone();
-    std::vector<int> newIds;
 
+    SceneDelta delta;
+    delta.added.reserve(m_clipboard.size());
     for (const auto& snap : m_clipboard) {
         SceneObject& obj = m_scene.addObject();
         int newId = obj.id;
@@ -927,17 +1376,14 @@ void App::pasteClipboard()
         obj.id = newId;
         obj.position.x += 1.0f;
         obj.position.z += 1.0f;
-        newIds.push_back(newId);
+        m_scene.reindexObject(newId);   // snap carried the source gridCell
+        delta.added.push_back(SceneDelta::stored(obj));
         m_scene.selectAdd(newId);
     }
 
-    m_history.execute({
-        "Paste " + std::to_string(newIds.size()) + " object(s)",
-        [](){},
-        [this, newIds]() {
-            for (int id : newIds) m_scene.removeObject(id);
-        }
-    });
+    m_history.push(makeDeltaCommand(
+        "Paste " + std::to_string(delta.added.size()) + " object(s)",
+        m_scene, std::move(delta)));
 }
 
 void App::deleteSelection()
@@ -945,39 +1391,40 @@ void App::deleteSelection()
     std::vector<int> ids = m_scene.selectedIds();
     if (ids.empty()) return;
 
-    std::vector<SceneObject> snapshots;
+    SceneDelta delta;
+    delta.removed.reserve(ids.size());
     for (int id : ids)
         if (auto* o = m_scene.findById(id))
-            snapshots.push_back(*o);
+            delta.removed.push_back(SceneDelta::stored(*o));
 
-    for (int id : ids) m_scene.removeObject(id);
+    m_scene.removeObjects(ids);
 
-    m_history.execute({
-        "Delete " + std::to_string(snapshots.size()) + " object(s)",
-        [](){},
-        [this, snapshots]() {
-            for (const auto& snap : snapshots) {
-                SceneObject& o = m_scene.addObject();
-                o = snap;
-            }
-        }
-    });
+    m_history.push(makeDeltaCommand(
+        "Delete " + std::to_string(delta.removed.size()) + " object(s)",
+        m_scene, std::move(delta)));
 }
 
 void App::addMergedToLibrary(std::shared_ptr<MeshAsset> asset, const std::string& name)
 {
+    // Deduplicated merge — the library already lists this mesh
+    for (const auto& existing : m_assetLibrary.library().entries())
+        if (existing.mesh == asset) return;
+
     // Add directly to the asset library's entry list
     // sourcePath is empty (procedural/merged mesh — not from disk)
     AssetEntry e;
     e.name        = name;
     e.sourcePath  = "";   // no source file
     e.mesh        = asset;
+    e.contentHash = asset->contentHash ? asset->contentHash
+                                       : ContentHash::mesh(asset->data, asset->submeshes);
+    e.loadState   = AssetLoadState::Loaded;
     e.calibPos    = glm::vec3(0.f);
     e.calibRot    = glm::vec3(0.f);
     e.calibScale  = glm::vec3(1.f);
     e.thumbDirty  = true;
 
-    m_assetLibrary.library().entries().push_back(std::move(e));
+    m_assetLibrary.library().add(std::move(e));
     // Note: save on shutdown via AssetLibraryView::shutdown()
     // Merged meshes have no sourcePath so they won't re-import on next load,
     // but they will appear in the library for the current session.
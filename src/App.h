@@ -6,8 +6,16 @@
 #include "../lib/grammar-ui/GraphViewer.h"
 #include "../lib/grammar-core/MerrellGrammar.h"
 #include "Scene.h"
+#include "Culling.h"
+#include "SoftwareOcclusion.h"
+#include "StaticBatcher.h"
 #include "AssetLibraryView.h"
 #include "CommandHistory.h"
+#include "SceneDelta.h"
+#include "BenchmarkMode.h"
+#include "InputRecorder.h"
+#include "ProfilerView.h"
+#include "MemoryView.h"
 #include <GLFW/glfw3.h>
 #include <string>
 #include <vector>
@@ -16,10 +24,15 @@
 class App
 {
 public:
+    // Command-line options (benchmark / stress scene) — call before init().
+    void setOptions(const BenchmarkConfig& cfg) { m_benchCfg = cfg; }
+
     bool init(int width, int height, const std::string& title);
     void run();
     void shutdown();
 
+    int exitCode() const { return m_exitCode; }
+
 private:
     GLFWwindow*      m_window   = nullptr;
     Renderer         m_renderer;
@@ -32,6 +45,29 @@ private:
     Scene            m_scene;
     MeshLibrary      m_meshLib;
     AssetLibraryView m_assetLibrary;
+    ProfilerView     m_profilerView;
+    MemoryView       m_memoryView;
+
+    // Visibility — hierarchy rebuilt when the scene version changes,
+    // traversed every frame into m_visible (indices into objects()), then
+    // thinned by the CPU occlusion buffer.
+    SceneCuller       m_culler;
+    SoftwareOcclusion m_occlusion;
+    std::vector<int>  m_visible;
+
+    // PLAY mode: merged per-chunk meshes and their own culling hierarchy.
+    StaticBatcher     m_batcher;
+    SceneCuller       m_chunkCuller;
+    std::vector<int>  m_chunkVisible;
+
+    // CPU mesh data residency (View menu) — applied every kResidencyPeriod s
+    static constexpr double kResidencyPeriod = 2.0;
+    double m_residencyTimer = 0.0;
+
+    // Scene / clipboard memory estimate (Memory window) — O(n), so sampled
+    static constexpr double kMemoryPeriod = 0.5;
+    double m_memoryTimer = 0.0;
+    MemoryStats::Tracked m_sceneMem { MemTag::Scene };
 
     Camera m_camera;
     bool   m_lmbDown      = false;
@@ -50,13 +86,46 @@ private:
     double m_fpsTime   = 0.0;
     int    m_fpsFrames = 0;
 
+    // ---- Redraw on demand ----
+    // Frames are drawn until kRedrawSettle s after the last change (input,
+    // camera, scene version, async work, animation) — long enough for ImGui
+    // hover delays and fades — then the loop blocks on events, waking at
+    // EditorUIState::idleFps at most.
+    static constexpr double kRedrawSettle = 0.5;
+    double   m_redrawUntil       = 0.0;
+    uint64_t m_drawnSceneVersion = ~0ull;
+    Camera   m_drawnCamera;
+
+    void requestRedraw() { m_redrawUntil = glfwGetTime() + kRedrawSettle; }
+    bool isAnimating() const;
+    void waitWhileIdle();
+    void updateRedrawState();
+
+    // ---- Stress scene / benchmark mode ----
+    BenchmarkConfig  m_benchCfg;
+    BenchmarkMode    m_bench;
+    StressSceneStats m_stressStats;
+    int              m_exitCode = 0;
+
+    void generateStressScene(const StressSceneParams& params);
+    void finishBenchmark();
+
+    // ---- Input recording / replay ----
+    // While replaying, live GLFW input is ignored and each frame's recorded
+    // events are fed to ImGui and App instead.
+    InputRecorder m_recorder;
+    bool          m_replaying = false;
+
+    bool liveInput() const { return !m_replaying; }
+    void injectReplayInput();
+
     // ---- Command history ----
     CommandHistory m_history;
 
     // ---- Gizmo multi-object tracking ----
     bool m_gizmoWasUsing = false;
 
-    struct TransformSnap { glm::vec3 pos, rot, scl; };
+    using TransformSnap = TransformDelta::Trs;
     // Snapshots of ALL selected objects at gizmo drag start
     std::map<int, TransformSnap> m_gizmoPreSnaps;
     // Pivot object's transform matrix at drag start
@@ -76,6 +145,8 @@ private:
     void addMergedToLibrary(std::shared_ptr<MeshAsset> asset, const std::string& name);
 
     void update(double dt);
+    void updateMeshResidency(double dt);
+    void updateMemoryStats(double dt);
     void render();
     void drawSceneActions();  // action buttons inside the docked scene panel
     void drawGizmo();
@@ -84,6 +155,9 @@ private:
     static void cbCursorPos  (GLFWwindow*, double, double);
     static void cbScroll     (GLFWwindow*, double, double);
     static void cbKey        (GLFWwindow*, int, int, int, int);
+    static void cbChar       (GLFWwindow*, unsigned);
+    static void cbCursorEnter(GLFWwindow*, int);
+    static void cbFocus      (GLFWwindow*, int);
 
     void onMouseButton(int btn, int action, int mods);
     void onCursorPos  (double x, double y);
@@ -1,6 +1,8 @@
 #include "AssetLibrary.h"
+#include "Profiler.h"
 #include "ObjImporter.h"
 #include "GltfImporter.h"
+#include "ContentHash.h"
 #include <algorithm>
 
 // Route to correct importer based on file extension
@@ -19,6 +21,8 @@ static std::shared_ptr<MeshAsset> importMesh(const std::string& path)
     return ObjImporter::load(path);
 }
 #include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -116,6 +120,20 @@ static std::string vec3ToJson(const glm::vec3& v)
     return "[" + jsonF(v.x) + "," + jsonF(v.y) + "," + jsonF(v.z) + "]";
 }
 
+// 64-bit hashes as hex strings — JSON numbers are doubles
+static std::string hashToHex(uint64_t h)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+    return buf;
+}
+
+static uint64_t hexToHash(const std::string& s)
+{
+    if (s.empty()) return 0;
+    return (uint64_t)strtoull(s.c_str(), nullptr, 16);
+}
+
 // ============================================================
 // AssetLibrary::save
 // ============================================================
@@ -136,7 +154,11 @@ void AssetLibrary::save(const std::string& path) const
         f << "      \"sourcePath\": " << jsonStr(e.sourcePath) << ",\n";
         f << "      \"calibPos\": "   << vec3ToJson(e.calibPos)   << ",\n";
         f << "      \"calibRot\": "   << vec3ToJson(e.calibRot)   << ",\n";
-        f << "      \"calibScale\": " << vec3ToJson(e.calibScale) << "\n";
+        f << "      \"calibScale\": " << vec3ToJson(e.calibScale) << ",\n";
+        // Cached so the next start needs no import — see load()
+        f << "      \"contentHash\": " << jsonStr(hashToHex(e.contentHash)) << ",\n";
+        f << "      \"aabbMin\": "  << vec3ToJson(e.mesh ? e.mesh->data.aabbMin : glm::vec3(0.f)) << ",\n";
+        f << "      \"aabbMax\": "  << vec3ToJson(e.mesh ? e.mesh->data.aabbMax : glm::vec3(0.f)) << "\n";
         f << "    }";
         if (i + 1 < (int)m_entries.size()) f << ",";
         f << "\n";
@@ -154,7 +176,9 @@ void AssetLibrary::save(const std::string& path) const
 void AssetLibrary::load(const std::string& path)
 {
     jsonPath = path;
+    waitLoads();
     m_entries.clear();
+    ++m_version;
 
     std::ifstream f(path);
     if (!f) {
@@ -196,24 +220,32 @@ void AssetLibrary::load(const std::string& path)
         e.calibRot   = jsonGetVec3(block, "calibRot");
         e.calibScale = jsonGetVec3(block, "calibScale");
 
-        // Re-import the mesh from disk
+        // Metadata only — the mesh is imported on first use (requestMesh).
+        // The empty asset already carries the cached bounds.
         if (!e.sourcePath.empty()) {
-            auto asset = importMesh(e.sourcePath);
-            if (asset && asset->upload()) {
-                e.mesh = asset;
-                m_entries.push_back(std::move(e));
-                std::cout << "[AssetLibrary] Loaded: " << e.name << "\n";
-            } else {
-                std::cerr << "[AssetLibrary] Could not reload: "
-                          << e.sourcePath << " — skipping\n";
+            e.contentHash = hexToHash(jsonGetString(block, "contentHash"));
+            e.mesh = std::make_shared<MeshAsset>();
+            e.mesh->name       = "obj:" + e.sourcePath;
+            e.mesh->sourcePath = e.sourcePath;
+            bool haveBounds = block.find("\"aabbMin\"") != std::string::npos &&
+                              block.find("\"aabbMax\"") != std::string::npos;
+            if (haveBounds) {
+                e.mesh->data.aabbMin = jsonGetVec3(block, "aabbMin");
+                e.mesh->data.aabbMax = jsonGetVec3(block, "aabbMax");
             }
+            m_entries.push_back(std::move(e));
+
+            // Library written before metadata was cached — import in the
+            // background so the next save has it
+            if (!haveBounds || m_entries.back().contentHash == 0)
+                requestMesh((int)m_entries.size() - 1);
         }
 
         pos = cb;
     }
 
-    std::cout << "[AssetLibrary] Loaded " << m_entries.size()
-              << " assets from " << path << "\n";
+    std::cout << "[AssetLibrary] Read " << m_entries.size()
+              << " assets from " << path << " (meshes load on demand)\n";
 }
 
 // ============================================================
@@ -231,11 +263,15 @@ std::vector<int> AssetLibrary::importObjs(const std::vector<std::string>& paths)
         }
 
         auto asset = importMesh(path);
-        if (!asset || !asset->upload()) continue;
+        if (asset && m_registry) asset = m_registry->intern(asset);
+        if (!asset || (!asset->isLoaded() && !asset->upload())) continue;
 
         AssetEntry e;
-        e.sourcePath = path;
-        e.mesh       = asset;
+        e.sourcePath  = path;
+        e.mesh        = asset;
+        e.contentHash = asset->contentHash ? asset->contentHash
+                                           : ContentHash::mesh(asset->data, asset->submeshes);
+        e.loadState   = AssetLoadState::Loaded;
 
         // Derive display name from filename
         size_t slash = path.find_last_of("/\\");
@@ -250,6 +286,7 @@ std::vector<int> AssetLibrary::importObjs(const std::vector<std::string>& paths)
 
         newIndices.push_back((int)m_entries.size());
         m_entries.push_back(std::move(e));
+        ++m_version;
 
         std::cout << "[AssetLibrary] Imported: "
                   << m_entries.back().name << "\n";
@@ -261,11 +298,16 @@ std::vector<int> AssetLibrary::importObjs(const std::vector<std::string>& paths)
 void AssetLibrary::remove(int index)
 {
     if (index < 0 || index >= (int)m_entries.size()) return;
-    // Free thumbnail texture
-    if (m_entries[index].thumbnailTex) {
-        glDeleteTextures(1, &m_entries[index].thumbnailTex);
-    }
+    // Thumbnail slot belongs to the shared atlas — the view releases it
     m_entries.erase(m_entries.begin() + index);
+    ++m_version;
+}
+
+int AssetLibrary::add(AssetEntry entry)
+{
+    m_entries.push_back(std::move(entry));
+    ++m_version;
+    return (int)m_entries.size() - 1;
 }
 
 bool AssetLibrary::entryExists(const std::string& sourcePath) const
@@ -274,3 +316,153 @@ bool AssetLibrary::entryExists(const std::string& sourcePath) const
         if (e.sourcePath == sourcePath) return true;
     return false;
 }
+
+// ============================================================
+// Lazy loading
+// ============================================================
+
+// Box of the given bounds (unit cube when unknown) — 24 verts so each face
+// gets its own normal.
+static void fillPlaceholderBox(MeshData& d, glm::vec3 bmin, glm::vec3 bmax)
+{
+    if (!(bmin.x <= bmax.x && bmin.y <= bmax.y && bmin.z <= bmax.z)) {
+        bmin = glm::vec3(-0.5f);
+        bmax = glm::vec3( 0.5f);
+    }
+    static const glm::vec3 normals[6] = {
+        { 1,0,0}, {-1,0,0}, {0, 1,0}, {0,-1,0}, {0,0, 1}, {0,0,-1}
+    };
+    d.vertices.clear();
+    d.indices.clear();
+    for (int f = 0; f < 6; ++f) {
+        glm::vec3 n = normals[f];
+        // Two axes spanning the face
+        glm::vec3 u = (f < 2) ? glm::vec3(0,1,0) : glm::vec3(1,0,0);
+        glm::vec3 v = glm::cross(n, u);
+        unsigned base = (unsigned)d.vertices.size();
+        for (int c = 0; c < 4; ++c) {
+            float su = (c == 1 || c == 2) ? 1.f : -1.f;
+            float sv = (c >= 2) ? 1.f : -1.f;
+            glm::vec3 unit = n + su * u + sv * v;          // in [-1,1]^3
+            glm::vec3 t    = unit * 0.5f + 0.5f;           // in [0,1]^3
+            MeshVertex mv;
+            mv.pos    = bmin + t * (bmax - bmin);
+            mv.normal = n;
+            mv.uv     = { su * 0.5f + 0.5f, sv * 0.5f + 0.5f };
+            d.vertices.push_back(mv);
+        }
+        d.indices.insert(d.indices.end(),
+                         { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+}
+
+void AssetLibrary::requestMesh(int index, bool placeholder)
+{
+    if (index < 0 || index >= (int)m_entries.size()) return;
+    AssetEntry& e = m_entries[index];
+    if (!e.mesh) return;
+
+    if (e.loadState == AssetLoadState::Unloaded && !e.sourcePath.empty()) {
+        e.loadState = AssetLoadState::Loading;
+        LoadJob job;
+        job.target = e.mesh;
+        job.path   = e.sourcePath;
+        m_loadQueue.push_back(std::move(job));
+    }
+
+    if (placeholder && e.loadState != AssetLoadState::Loaded &&
+        !e.mesh->isLoaded() && e.mesh->data.indices.empty()) {
+        fillPlaceholderBox(e.mesh->data, e.mesh->data.aabbMin, e.mesh->data.aabbMax);
+        e.mesh->upload();
+    }
+}
+
+int AssetLibrary::pollLoads(bool install)
+{
+    MYTHOS_PROFILE_SCOPE("AssetLibrary::pollLoads");
+    // Launch up to the in-flight limit
+    while (!m_loadQueue.empty() && (int)m_loading.size() < kMaxLoadsInFlight) {
+        LoadJob job = std::move(m_loadQueue.front());
+        m_loadQueue.pop_front();
+        std::string path = job.path;
+        job.result = std::async(std::launch::async, [path]() { return importMesh(path); });
+        m_loading.push_back(std::move(job));
+    }
+
+    int finished = 0;
+    if (!install) return finished;
+    for (auto it = m_loading.begin(); it != m_loading.end(); ) {
+        if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        std::shared_ptr<MeshAsset> loaded = it->result.get();
+        MeshAsset& target = *it->target;
+
+        AssetEntry* entry = nullptr;
+        for (auto& e : m_entries)
+            if (e.mesh == it->target) { entry = &e; break; }
+
+        // Identical content already live elsewhere (another path, a merge)?
+        // Share it when nothing has picked up this entry's asset yet;
+        // otherwise placed objects already point at the target, so fill it.
+        std::shared_ptr<MeshAsset> shared;
+        uint64_t loadedHash = 0;
+        bool     duplicate  = false;
+        if (loaded && !loaded->data.indices.empty() && m_registry) {
+            loadedHash = ContentHash::mesh(loaded->data, loaded->submeshes);
+            shared     = m_registry->find(loadedHash, loaded->data, loaded->submeshes);
+            duplicate  = (shared != nullptr);
+            if (shared && !(entry && it->target.use_count() <= 2))   // entry + job
+                shared.reset();
+        }
+
+        if (shared) {
+            entry->mesh = shared;
+            ++finished;
+            if (loadedHash != entry->contentHash) {
+                entry->contentHash = loadedHash;
+                entry->thumbDirty  = true;
+            }
+            entry->loadState = AssetLoadState::Loaded;
+            std::cout << "[AssetLibrary] Loaded: " << entry->name << " (shared)\n";
+        } else if (loaded && !loaded->data.indices.empty()) {
+            // Hand the imported data to the shared asset and upload here —
+            // GL calls stay on the main thread
+            target.data        = std::move(loaded->data);
+            target.submeshes   = std::move(loaded->submeshes);
+            target.contentHash = 0;
+            if (target.upload()) {
+                ++finished;
+                if (m_registry && !duplicate) m_registry->intern(it->target);   // sets contentHash
+                if (entry) {
+                    uint64_t h = target.contentHash ? target.contentHash
+                                                    : ContentHash::mesh(target.data, target.submeshes);
+                    if (h != entry->contentHash) {
+                        // Source changed since the library was saved
+                        entry->contentHash = h;
+                        entry->thumbDirty  = true;
+                    }
+                    entry->loadState = AssetLoadState::Loaded;
+                    std::cout << "[AssetLibrary] Loaded: " << entry->name << "\n";
+                }
+            } else if (entry) {
+                entry->loadState = AssetLoadState::Failed;
+            }
+        } else {
+            std::cerr << "[AssetLibrary] Could not load: " << it->path << "\n";
+            if (entry) entry->loadState = AssetLoadState::Failed;
+        }
+
+        it = m_loading.erase(it);   // worker result released here, on this thread
+    }
+    return finished;
+}
+
+void AssetLibrary::waitLoads()
+{
+    m_loadQueue.clear();
+    for (auto& job : m_loading)
+        if (job.result.valid()) job.result.wait();
+    m_loading.clear();
+}
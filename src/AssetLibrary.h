@@ -1,10 +1,20 @@
 #pragma once
 #include "MeshAsset.h"
+#include "MeshRegistry.h"
+#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
+#include <deque>
+#include <future>
 #include <vector>
 #include <memory>
 
+// ---- AssetLoadState --------------------------------------------------------
+// Library meshes are parsed lazily: entries start Unloaded (metadata only)
+// and are imported on first placement / preview.
+enum class AssetLoadState { Unloaded, Loading, Loaded, Failed };
+
 // ---- AssetEntry ------------------------------------------------------------
 // One imported OBJ in the editor's asset library.
 // calibration corrects for axis convention differences between DCC tools.
@@ -14,7 +24,13 @@ struct AssetEntry {
     std::string name;         // display name (filename without extension)
     std::string sourcePath;   // original .obj path on disk
 
+    // Always non-null once the entry exists. While Unloaded/Loading it holds
+    // no geometry (or a bounding-box placeholder) but data.aabbMin/aabbMax are
+    // the cached bounds; the imported data is moved into this same asset, so
+    // scene objects placed early pick up the real mesh.
     std::shared_ptr<MeshAsset> mesh;
+    uint64_t       contentHash = 0;   // ContentHash::mesh of the imported mesh
+    AssetLoadState loadState   = AssetLoadState::Unloaded;
 
     // Calibration — applied to every instance placed into the scene.
     // Lets the user correct for Y-up vs Z-up, wrong scale, rotated root, etc.
@@ -24,9 +40,15 @@ struct AssetEntry {
 
     glm::mat4 calibMatrix() const;              // computed from above
 
-    // Thumbnail GL texture (rendered on first draw, cached)
-    GLuint thumbnailTex   = 0;
-    bool   thumbDirty     = true;   // set true when calibration changes
+    // Thumbnail — a slot in ThumbnailRenderer's atlas. thumbnailTex is the
+    // shared page texture; draw with thumbUV0/thumbUV1.
+    GLuint    thumbnailTex = 0;
+    int       thumbPage    = -1;
+    int       thumbSlot    = -1;
+    glm::vec2 thumbUV0     = {0.f, 1.f};
+    glm::vec2 thumbUV1     = {1.f, 0.f};
+    bool      thumbDirty   = true;   // set true when calibration changes
+    uint64_t  thumbKey     = 0;      // ThumbnailCache key of the slot's pixels
 };
 
 // ---- AssetLibrary ----------------------------------------------------------
@@ -35,9 +57,22 @@ struct AssetEntry {
 // holds placed instances, the library holds the source assets.
 //
 // Serialised to/from editor_assets.json next to the executable.
+//
+// load() reads metadata only (name, path, calibration, AABB, content hash) —
+// startup cost is independent of mesh sizes. Meshes are imported on
+// std::async workers when requestMesh() is first called for an entry and
+// handed over / uploaded on the main thread by pollLoads().
 class AssetLibrary
 {
 public:
+    static constexpr int kMaxLoadsInFlight = 4;
+
+    ~AssetLibrary() { waitLoads(); }
+
+    // Imported meshes are interned here so identical content is shared with
+    // the rest of the editor. Optional; set before load().
+    void setMeshRegistry(MeshRegistry* registry) { m_registry = registry; }
+
     // Load from disk on startup. Creates empty library if file not found.
     void load(const std::string& jsonPath);
 
@@ -48,20 +83,56 @@ public:
     // Returns indices of newly added entries.
     std::vector<int> importObjs(const std::vector<std::string>& paths);
 
+    // Append an already-loaded entry (e.g. a merged mesh). Returns its index.
+    int add(AssetEntry entry);
+
     // Remove an entry by index.
     void remove(int index);
 
+    // ---- Lazy loading ----
+    // Start importing the entry's mesh if it is not loaded yet. With
+    // placeholder, an entry without geometry also gets a box of its cached
+    // bounds uploaded immediately so it can be drawn while loading.
+    void requestMesh(int index, bool placeholder = false);
+
+    // Launch queued imports and install finished ones (main thread, per
+    // frame). Returns the number of meshes that finished — callers bump the
+    // scene version so culling / batching see the new geometry. With
+    // install false, finished imports are held back: a placeholder's data
+    // is replaced in place, so not while other threads may be reading it.
+    int  pollLoads(bool install = true);
+    int  loadsPending() const { return (int)(m_loadQueue.size() + m_loading.size()); }
+    void waitLoads();
+
     // All entries
     const std::vector<AssetEntry>& entries() const { return m_entries; }
           std::vector<AssetEntry>& entries()       { return m_entries; }
 
     int count() const { return (int)m_entries.size(); }
 
+    // Bumped when entries are added, removed or reloaded (not on calibration
+    // or thumbnail changes) — for views indexing names/paths.
+    uint64_t version() const { return m_version; }
+
     // Path used for save/load (set by load(), used by save())
     std::string jsonPath;
 
 private:
     std::vector<AssetEntry> m_entries;
+    uint64_t                m_version  = 0;
+    MeshRegistry*           m_registry = nullptr;
+
+    // An import in progress. The target asset (entry.mesh) is held here so
+    // it outlives a removed entry; the worker result is released on the
+    // main thread only.
+    struct LoadJob
+    {
+        std::shared_ptr<MeshAsset>              target;
+        std::string                             path;
+        std::future<std::shared_ptr<MeshAsset>> result;
+    };
+    std::deque<LoadJob>  m_loadQueue;   // not launched yet
+    std::vector<LoadJob> m_loading;     // on workers
 
     bool entryExists(const std::string& sourcePath) const;
 };
@@ -4,6 +4,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <queue>
 
 static constexpr float TILE_SIZE  = 110.f;
 static constexpr float THUMB_SIZE =  90.f;
@@ -18,12 +20,31 @@ void AssetLibraryView::init(const std::string& jsonPath)
     m_jsonPath = jsonPath;
     m_library.load(jsonPath);
     m_thumbRenderer.init();
+
+    // Every cached thumbnail is uploaded now, so the first frame of the
+    // panel shows them without rendering anything
+    m_thumbCache.open(ThumbnailCache::pathFor(jsonPath), ThumbnailRenderer::SIZE);
+    m_thumbRenderer.setCache(&m_thumbCache);
+    int restored = 0;
+    for (auto& e : m_library.entries())
+        if (m_thumbRenderer.restoreCached(e)) ++restored;
+    std::cout << "[AssetLibraryView] " << restored << "/" << m_library.count()
+              << " thumbnails restored from cache\n";
 }
 
 void AssetLibraryView::shutdown()
 {
+    m_library.waitLoads();   // while GL is still alive
     m_library.save(m_jsonPath);
+
+    // Keep only thumbnails still shown by some entry
+    std::vector<uint64_t> live;
+    for (const auto& e : m_library.entries())
+        if (e.thumbKey) live.push_back(e.thumbKey);
+    m_thumbRenderer.setCache(nullptr);
     m_thumbRenderer.shutdown();
+    m_thumbCache.save(live);
+    m_thumbCache.close();
 }
 
 // ============================================================
@@ -54,9 +75,17 @@ void AssetLibraryView::toggleSelect(int idx)
 
 void AssetLibraryView::selectRange(int from, int to)
 {
-    if (from > to) std::swap(from, to);
-    for (int i = from; i <= to; ++i)
-        m_selection.insert(i);
+    // Range in grid order — with a search active that skips hidden entries
+    auto a = std::find(m_filtered.begin(), m_filtered.end(), from);
+    auto b = std::find(m_filtered.begin(), m_filtered.end(), to);
+    if (a != m_filtered.end() && b != m_filtered.end()) {
+        if (a > b) std::swap(a, b);
+        m_selection.insert(a, b + 1);
+    } else {
+        int lo = std::min(from, to), hi = std::max(from, to);
+        for (int i = lo; i <= hi; ++i)
+            m_selection.insert(i);
+    }
     m_primaryIdx = to;
 }
 
@@ -86,6 +115,17 @@ void AssetLibraryView::applyCalibToSelection(
     m_library.save(m_jsonPath);
 }
 
+// ============================================================
+// Lazy loads
+// ============================================================
+
+void AssetLibraryView::pollLoads(Scene& scene, bool install)
+{
+    // New geometry behind existing asset pointers, so culling and batching
+    // must rebuild
+    if (m_library.pollLoads(install) > 0) scene.touch();
+}
+
 // ============================================================
 // Main draw
 // ============================================================
@@ -109,15 +149,10 @@ void AssetLibraryView::draw(Scene& scene, std::vector<std::string>& importPaths)
         }
     }
 
-    // Render one dirty thumbnail per frame
-    for (auto& e : m_library.entries()) {
-        if (e.thumbDirty && e.mesh && e.mesh->isLoaded()) {
-            m_thumbRenderer.renderThumbnail(e);
-            break;
-        }
-    }
+    updateFilter();
+    pumpThumbnails();
 
-    if (!m_open) return;
+    if (!m_open) { m_firstRow = m_lastRow = -1; return; }
 
     ImGui::SetNextWindowSize({680.f, 500.f}, ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowPos({300.f, 70.f},   ImGuiCond_FirstUseEver);
@@ -143,15 +178,34 @@ void AssetLibraryView::draw(Scene& scene, std::vector<std::string>& importPaths)
         ImGui::TextColored({0.6f,0.85f,1.f,1.f}, "%d assets selected", selCount);
 
     ImGui::SameLine(ImGui::GetContentRegionAvail().x - 180.f);
-    if (ImGui::SmallButton("Select All")) {
+    if (ImGui::SmallButton("Select All") && !m_filtered.empty()) {
+        // Everything matching the search
         m_selection.clear();
-        for (int i = 0; i < m_library.count(); ++i) m_selection.insert(i);
-        m_primaryIdx  = m_library.count() - 1;
-        m_rangeAnchor = 0;
+        m_selection.insert(m_filtered.begin(), m_filtered.end());
+        m_primaryIdx  = m_filtered.back();
+        m_rangeAnchor = m_filtered.front();
     }
     ImGui::SameLine();
     if (ImGui::SmallButton("Clear")) clearSelection();
 
+    // Search — name or source path, case-insensitive substring
+    ImGui::SetNextItemWidth(240.f);
+    if (ImGui::InputTextWithHint("##assetsearch", "Search name or path",
+                                 m_searchBuf, sizeof(m_searchBuf))) {
+        m_filterDirty = true;
+        updateFilter();
+    }
+    if (m_searchBuf[0]) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%d / %d", (int)m_filtered.size(), m_library.count());
+        ImGui::SameLine();
+        if (ImGui::SmallButton("x")) {
+            m_searchBuf[0] = '\0';
+            m_filterDirty  = true;
+            updateFilter();
+        }
+    }
+
     ImGui::Separator();
 
     // Left: grid   Right: calibration panel (when anything selected)
@@ -173,18 +227,115 @@ void AssetLibraryView::draw(Scene& scene, std::vector<std::string>& importPaths)
     ImGui::End();
 }
 
+// ============================================================
+// Thumbnail queue
+// ============================================================
+
+void AssetLibraryView::pumpThumbnails()
+{
+    auto& entries = m_library.entries();
+
+    // Finished CPU renders — uploads only, cheap
+    m_thumbRenderer.collectSoftware(entries);
+    m_thumbsQueued = false;
+
+    if (m_firstRow < 0) return;   // grid not drawn — nothing on screen to fill
+
+    // (rank, index) — rank 0 is on screen, then rows nearest the view
+    const int n = (int)m_filtered.size();
+    const int from = std::max(0, (m_firstRow - kPrefetchRows) * COLS);
+    const int to   = std::min(n, (m_lastRow + 1 + kPrefetchRows) * COLS);
+    using Item = std::pair<int,int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    for (int k = from; k < to; ++k) {
+        const int i = m_filtered[k];
+        auto& e = entries[i];
+        if (!e.thumbDirty) continue;
+        // e.g. calibration set back to a previously seen value
+        if (m_thumbRenderer.restoreCached(e)) continue;
+        if (!e.mesh) continue;
+
+        const int row  = k / COLS;
+        const int rank = (row < m_firstRow) ? m_firstRow - row
+                       : (row > m_lastRow)  ? row - m_lastRow
+                                            : 0;
+        // Not imported yet — on-screen tiles count as a preview request
+        if (e.loadState != AssetLoadState::Loaded) {
+            if (rank == 0) m_library.requestMesh(i);
+            continue;
+        }
+        if (e.mesh->data.indices.empty() && !e.mesh->isLoaded()) continue;
+        queue.push({ rank, i });
+    }
+    if (queue.empty()) return;
+
+    // Entries with CPU mesh data go to the software rasteriser workers (in
+    // priority order, as many as there are free workers). Only meshes that
+    // exist solely on the GPU use the GL path, which costs main-thread time:
+    // at least one per frame so progress never stalls, then up to the budget.
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    bool workersFull = false;
+    while (!queue.empty()) {
+        AssetEntry& e = entries[queue.top().second];
+        queue.pop();
+        if (!e.mesh->data.indices.empty()) {
+            if (workersFull) continue;
+            m_thumbRenderer.queueSoftware(e);
+            workersFull = m_thumbRenderer.softwareFull();
+            continue;
+        }
+        m_thumbRenderer.renderThumbnail(e);
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if (ms >= kThumbBudgetMs) break;
+    }
+    m_thumbsQueued = !queue.empty();
+}
+
+// ============================================================
+// Search
+// ============================================================
+
+void AssetLibraryView::updateFilter()
+{
+    if (m_searchVersion != m_library.version()) {
+        m_search.rebuild(m_library.entries());
+        m_searchVersion = m_library.version();
+        m_filterDirty   = true;
+    }
+    if (!m_filterDirty) return;
+    m_filtered    = m_search.query(m_searchBuf);
+    m_filterDirty = false;
+}
+
 // ============================================================
 // Grid
 // ============================================================
 
 void AssetLibraryView::drawGrid()
 {
-    int n = m_library.count();
-    for (int i = 0; i < n; ++i) {
-        if (i > 0 && i % COLS != 0)
-            ImGui::SameLine();
-        drawTile(i);
+    // Only the rows in view are submitted; the clipper reserves space for
+    // the rest so the scrollbar is right. Row height = child tile + spacing.
+    const int n    = (int)m_filtered.size();
+    const int rows = (n + COLS - 1) / COLS;
+    const float rowH = TILE_SIZE + 20.f + ImGui::GetStyle().ItemSpacing.y;
+
+    m_firstRow = m_lastRow = -1;
+    ImGuiListClipper clipper;
+    clipper.Begin(rows, rowH);
+    while (clipper.Step()) {
+        for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+            for (int c = 0; c < COLS; ++c) {
+                int k = r * COLS + c;
+                if (k >= n) break;
+                if (c > 0) ImGui::SameLine();
+                drawTile(m_filtered[k]);
+            }
+            if (m_firstRow < 0 || r < m_firstRow) m_firstRow = r;
+            if (r > m_lastRow) m_lastRow = r;
+        }
     }
+    clipper.End();
 }
 
 void AssetLibraryView::drawTile(int idx)
@@ -206,7 +357,8 @@ void AssetLibraryView::drawTile(int idx)
     // Thumbnail or grey placeholder
     if (e.thumbnailTex) {
         ImGui::Image((ImTextureID)(uintptr_t)e.thumbnailTex,
-                     {THUMB_SIZE, THUMB_SIZE}, {0,1}, {1,0});
+                     {THUMB_SIZE, THUMB_SIZE},
+                     {e.thumbUV0.x, e.thumbUV0.y}, {e.thumbUV1.x, e.thumbUV1.y});
     } else {
         ImGui::Dummy({THUMB_SIZE, THUMB_SIZE});
         ImGui::GetWindowDrawList()->AddRectFilled(
@@ -271,7 +423,18 @@ void AssetLibraryView::drawCalibrationPanel(Scene& scene)
         ImGui::TextColored({0.9f,0.9f,0.5f,1.f}, "%s", primary.name.c_str());
         if (primary.mesh) {
             auto sz = primary.mesh->data.size();
-            ImGui::TextDisabled("%d tris", (int)primary.mesh->data.indices.size()/3);
+            switch (primary.loadState) {
+            case AssetLoadState::Loaded:
+                ImGui::TextDisabled("%d tris", primary.mesh->triangleCount());
+                break;
+            case AssetLoadState::Failed:
+                ImGui::TextColored({1.f,0.45f,0.4f,1.f}, "Source could not be loaded");
+                break;
+            default:
+                ImGui::TextDisabled("Loading...");
+                m_library.requestMesh(m_primaryIdx);
+                break;
+            }
             ImGui::TextDisabled("%.2f x %.2f x %.2f", sz.x, sz.y, sz.z);
         }
     } else {
@@ -378,8 +541,10 @@ void AssetLibraryView::drawCalibrationPanel(Scene& scene)
     if (ImGui::Button(removeLabel.c_str(), {-1.f, 0.f})) {
         // Remove in reverse index order so indices stay valid
         std::vector<int> toRemove(m_selection.rbegin(), m_selection.rend());
-        for (int i : toRemove)
+        for (int i : toRemove) {
+            m_thumbRenderer.releaseThumbnail(m_library.entries()[i]);
             m_library.remove(i);
+        }
         m_library.save(m_jsonPath);
         clearSelection();
     }
@@ -396,6 +561,9 @@ void AssetLibraryView::placeIntoScene(Scene& scene, int assetIdx)
     auto& e = m_library.entries()[assetIdx];
     if (!e.mesh) return;
 
+    // Drawn as a box of the cached bounds until the import lands
+    m_library.requestMesh(assetIdx, true);
+
     SceneObject& obj = scene.addObject();
     obj.name   = e.name;
     obj.primId = e.name;
@@ -1,9 +1,12 @@
 #pragma once
 #include "AssetLibrary.h"
 #include "ThumbnailRenderer.h"
+#include "ThumbnailCache.h"
+#include "AssetSearchIndex.h"
 #include "Scene.h"
 #include <string>
 #include <set>
+#include <vector>
 
 class AssetLibraryView
 {
@@ -13,14 +16,27 @@ public:
 
     void draw(Scene& scene, std::vector<std::string>& importPaths);
 
+    // Lazily imported meshes — call every frame, whatever the mode. install
+    // as for AssetLibrary::pollLoads.
+    void pollLoads(Scene& scene, bool install);
+
     AssetLibrary& library() { return m_library; }
 
+    // Thumbnail workers or mesh imports in flight (they read MeshData)
+    bool backgroundBusy() const {
+        return m_thumbRenderer.pendingSoftware() > 0 || m_library.loadsPending() > 0;
+    }
+
+    // GL-path thumbnails left over by the per-frame budget in the last draw()
+    bool thumbnailsQueued() const { return m_thumbsQueued; }
+
     bool isOpen()           const { return m_open; }
     void setOpen(bool open)       { m_open = open; }
 
 private:
     AssetLibrary      m_library;
     ThumbnailRenderer m_thumbRenderer;
+    ThumbnailCache    m_thumbCache;   // editor_thumbs.bin beside the library
     std::string       m_jsonPath;
     bool              m_open = true;
 
@@ -29,6 +45,27 @@ private:
     int           m_primaryIdx = -1;   // last clicked — drives calibration display
     int           m_rangeAnchor = -1;  // shift-click anchor
 
+    // ---- Search ----
+    // m_filtered holds the entry indices shown by the grid, in order.
+    AssetSearchIndex m_search;
+    uint64_t         m_searchVersion = ~0ull;   // library version indexed
+    char             m_searchBuf[128] = {};
+    bool             m_filterDirty = true;
+    std::vector<int> m_filtered;
+    void updateFilter();
+
+    // ---- Thumbnail queue ----
+    // Only rows the grid's list clipper submitted last frame (plus
+    // kPrefetchRows either side) are considered. Dirty thumbnails are
+    // rendered visible-first, then by row distance — on software-rasteriser
+    // workers when the mesh has CPU data, otherwise on the GL path within
+    // kThumbBudgetMs per frame. Meshes are only requested for visible rows.
+    static constexpr double kThumbBudgetMs = 4.0;
+    static constexpr int    kPrefetchRows  = 2;
+    int m_firstRow = -1, m_lastRow = -1;   // rows of m_filtered drawn last frame
+    bool m_thumbsQueued = false;
+    void pumpThumbnails();
+
     void drawGrid();
     void drawTile(int idx);
     void drawCalibrationPanel(Scene& scene);
@@ -0,0 +1,88 @@
+#include "AssetSearchIndex.h"
+#include <cctype>
+
+uint32_t AssetSearchIndex::trigram(const char* p)
+{
+    return  (uint32_t)(unsigned char)p[0]
+         | ((uint32_t)(unsigned char)p[1] << 8)
+         | ((uint32_t)(unsigned char)p[2] << 16);
+}
+
+std::string AssetSearchIndex::lower(const std::string& s)
+{
+    std::string r = s;
+    for (auto& c : r) c = (char)tolower((unsigned char)c);
+    return r;
+}
+
+// ============================================================
+// Build
+// ============================================================
+
+void AssetSearchIndex::rebuild(const std::vector<AssetEntry>& entries)
+{
+    m_text.clear();
+    m_postings.clear();
+    m_text.reserve(entries.size());
+
+    for (int i = 0; i < (int)entries.size(); ++i) {
+        // '\x01' never appears in a query, so no match spans name and path
+        m_text.push_back(lower(entries[i].name) + '\x01' + lower(entries[i].sourcePath));
+        const std::string& t = m_text.back();
+        for (size_t k = 0; k + 3 <= t.size(); ++k) {
+            std::vector<int>& list = m_postings[trigram(&t[k])];
+            if (list.empty() || list.back() != i) list.push_back(i);   // ascending, unique
+        }
+    }
+
+    m_lastQuery.clear();
+    m_result.clear();
+    m_haveResult = false;
+}
+
+// ============================================================
+// Query
+// ============================================================
+
+const std::vector<int>& AssetSearchIndex::query(const std::string& text)
+{
+    const std::string q = lower(text);
+    const int n = (int)m_text.size();
+
+    if (q.empty()) {
+        m_result.resize(n);
+        for (int i = 0; i < n; ++i) m_result[i] = i;
+        m_lastQuery.clear();
+        m_haveResult = true;
+        return m_result;
+    }
+    if (m_haveResult && q == m_lastQuery) return m_result;
+
+    std::vector<int> out;
+
+    if (m_haveResult && !m_lastQuery.empty() && q.find(m_lastQuery) != std::string::npos) {
+        // Narrowing the previous query — every match is already in m_result
+        for (int i : m_result)
+            if (m_text[i].find(q) != std::string::npos) out.push_back(i);
+    } else if (q.size() >= 3) {
+        // Candidates from the rarest trigram of the query
+        const std::vector<int>* best = nullptr;
+        bool missing = false;
+        for (size_t k = 0; k + 3 <= q.size() && !missing; ++k) {
+            auto it = m_postings.find(trigram(&q[k]));
+            if (it == m_postings.end()) missing = true;   // some trigram never occurs
+            else if (!best || it->second.size() < best->size()) best = &it->second;
+        }
+        if (!missing)
+            for (int i : *best)
+                if (m_text[i].find(q) != std::string::npos) out.push_back(i);
+    } else {
+        for (int i = 0; i < n; ++i)
+            if (m_text[i].find(q) != std::string::npos) out.push_back(i);
+    }
+
+    m_result.swap(out);
+    m_lastQuery  = q;
+    m_haveResult = true;
+    return m_result;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "AssetLibrary.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================
+// AssetSearchIndex — case-insensitive substring search over asset
+// names and source paths
+//
+// Each entry's lower-cased "name + path" is split into trigrams; every
+// trigram maps to the ascending list of entries containing it. A query
+// takes the rarest of its trigrams as the candidate list and verifies each
+// candidate with a substring test, so cost scales with matches rather than
+// library size. Queries shorter than three characters scan all entries.
+//
+// Typing is incremental: when the new query contains the previous one (the
+// usual case — one more character), only the previous result is refined.
+// Rebuild after AssetLibrary::version() changes. GL-free.
+// ============================================================
+
+class AssetSearchIndex
+{
+public:
+    void rebuild(const std::vector<AssetEntry>& entries);
+
+    // Matching entry indices, ascending. Empty query matches everything.
+    // The reference stays valid until the next query()/rebuild().
+    const std::vector<int>& query(const std::string& text);
+
+    int size() const { return (int)m_text.size(); }
+
+private:
+    std::vector<std::string>                         m_text;       // lower-cased name '\x01' path
+    std::unordered_map<uint32_t, std::vector<int>>   m_postings;   // trigram → entries
+
+    std::string      m_lastQuery;
+    std::vector<int> m_result;
+    bool             m_haveResult = false;
+
+    static uint32_t trigram(const char* p);
+    static std::string lower(const std::string& s);
+};
@@ -0,0 +1,305 @@
+#include "BenchmarkMode.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+static const char* kPhaseNames[(int)BenchPhase::Count] = {
+    "update", "visibility", "draw", "ui", "present"
+};
+
+// ============================================================
+// Command line
+// ============================================================
+
+void BenchmarkConfig::printUsage()
+{
+    std::cerr <<
+        "usage: Mythos [--benchmark] [--frames N] [--warmup N] [--out F] [--play]\n"
+        "              [--scene F.gep] [--objects N] [--segments N] [--instancing R]\n"
+        "              [--sockets N] [--seed N] [--size WxH]\n"
+        "       Mythos --record F [scene options]\n"
+        "       Mythos --replay F [--warmup N] [--out F]\n";
+}
+
+bool BenchmarkConfig::parse(int argc, char** argv, BenchmarkConfig& out)
+{
+    bool warmupGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        auto intArg = [&](int& dst) {
+            if (!hasValue) return false;
+            dst = atoi(argv[++i]);
+            return true;
+        };
+
+        bool ok = true;
+        if      (a == "--benchmark") out.enabled = true;
+        else if (a == "--play")      out.play    = true;
+        else if (a == "--frames")    ok = intArg(out.frames);
+        else if (a == "--warmup")    { ok = intArg(out.warmup); warmupGiven = true; }
+        else if (a == "--out")       { ok = hasValue; if (ok) out.outPath   = argv[++i]; }
+        else if (a == "--scene")     { ok = hasValue; if (ok) out.scenePath = argv[++i]; }
+        else if (a == "--record")    { ok = hasValue; if (ok) out.recordPath = argv[++i]; }
+        else if (a == "--replay")    {
+            ok = hasValue;
+            if (ok) out.replayPath = argv[++i];
+            out.enabled = true;
+        }
+        else if (a == "--objects")   { ok = intArg(out.stress.objectCount);      out.stressScene = true; }
+        else if (a == "--segments")  { ok = intArg(out.stress.meshSegments);     out.stressScene = true; }
+        else if (a == "--sockets")   { ok = intArg(out.stress.socketsPerObject); out.stressScene = true; }
+        else if (a == "--instancing") {
+            ok = hasValue;
+            if (ok) out.stress.instancingRatio = (float)atof(argv[++i]);
+            out.stressScene = true;
+        }
+        else if (a == "--seed") {
+            ok = hasValue;
+            if (ok) out.stress.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+            out.stressScene = true;
+        }
+        else if (a == "--size") {
+            ok = hasValue && sscanf(argv[++i], "%dx%d", &out.width, &out.height) == 2;
+        }
+        else {
+            std::cerr << "[Benchmark] Unknown argument: " << a << "\n";
+            printUsage();
+            return false;
+        }
+        if (!ok) {
+            std::cerr << "[Benchmark] Missing or bad value for " << a << "\n";
+            printUsage();
+            return false;
+        }
+    }
+
+    if (!out.recordPath.empty() && out.enabled) {
+        std::cerr << "[Benchmark] --record cannot be combined with --benchmark or --replay\n";
+        printUsage();
+        return false;
+    }
+    // A replay times the recorded session itself, not extra frames
+    if (!out.replayPath.empty() && !warmupGiven) out.warmup = 0;
+
+    out.frames = std::max(out.frames, 1);
+    out.warmup = std::max(out.warmup, 0);
+    out.width  = std::max(out.width,  64);
+    out.height = std::max(out.height, 64);
+    // A benchmark always needs a scene — default to the stress defaults.
+    // A replay takes its scene from the recording.
+    if (out.enabled && out.scenePath.empty() && out.replayPath.empty()) out.stressScene = true;
+    return true;
+}
+
+// ============================================================
+// Script
+// ============================================================
+
+uint32_t BenchmarkMode::nextRand()
+{
+    m_rng = m_rng * 1664525u + 1013904223u;
+    return m_rng >> 8;
+}
+
+void BenchmarkMode::begin(const BenchmarkConfig& cfg, const Scene& scene)
+{
+    m_cfg    = cfg;
+    m_active = true;
+    m_frame  = 0;
+    m_rng    = cfg.stress.seed * 2654435761u + 1u;
+    m_frameMs.clear();
+    m_frameMs.reserve(cfg.frames);
+    for (auto& v : m_phaseMs) { v.clear(); v.reserve(cfg.frames); }
+    m_drawnSum = 0;
+
+    glm::vec3 lo(1e9f), hi(-1e9f);
+    for (const auto& o : scene.objects()) {
+        lo = glm::min(lo, o.position);
+        hi = glm::max(hi, o.position);
+    }
+    if (scene.objects().empty()) { lo = glm::vec3(-5.f); hi = glm::vec3(5.f); }
+    m_centre = (lo + hi) * 0.5f;
+    m_radius = std::max(glm::length(hi - lo) * 0.5f, 5.f);
+
+    std::cout << "[Benchmark] " << cfg.warmup << " warm-up + " << cfg.frames
+              << " frames over " << scene.objectCount() << " objects\n";
+}
+
+void BenchmarkMode::applyFrame(Scene& scene, Camera& cam)
+{
+    m_frameStart = m_lastLap = Clock::now();
+    for (double& v : m_phaseNow) v = 0.0;
+
+    // Camera and selection come from the recorded input
+    if (replaying()) return;
+
+    // ---- Camera: one closed loop over the whole run ----
+    // Two orbits, zooming from overview into the middle of the scene and
+    // back, with the target drifting so near views cover different areas.
+    const int   total = m_cfg.warmup + m_cfg.frames;
+    const float t     = (float)m_frame / (float)std::max(total, 1);
+    const float tau   = 6.2831853f;
+
+    cam.yaw    = -45.f + 720.f * t;
+    cam.pitch  =  35.f + 20.f * std::sin(tau * t * 3.f);
+    cam.dist   = std::min(m_radius * (0.25f + 1.1f * (0.5f + 0.5f * std::cos(tau * t))),
+                          Camera::kFar * 0.8f);
+    cam.target = m_centre + glm::vec3(std::sin(tau * t * 2.f), 0.f,
+                                      std::cos(tau * t * 3.f)) * (m_radius * 0.35f);
+
+    // ---- Selection: single → multi → none → all → none, every 15 frames ----
+    const auto& objs = scene.objects();
+    if (!objs.empty() && m_frame % 15 == 0) {
+        switch ((m_frame / 15) % 5) {
+            case 0:
+                scene.selectById(objs[nextRand() % objs.size()].id);
+                break;
+            case 1:
+                for (int k = 0; k < 16; ++k)
+                    scene.selectAdd(objs[nextRand() % objs.size()].id);
+                break;
+            case 3:
+                scene.selectAll();
+                break;
+            default:
+                scene.selectNone();
+                break;
+        }
+    }
+}
+
+void BenchmarkMode::lap(BenchPhase phase)
+{
+    if (!m_active) return;
+    const Clock::time_point now = Clock::now();
+    m_phaseNow[(int)phase] += std::chrono::duration<double, std::milli>(now - m_lastLap).count();
+    m_lastLap = now;
+}
+
+void BenchmarkMode::endFrame(int drawn)
+{
+    if (!m_active) return;
+    if (m_frame >= m_cfg.warmup && m_frame < m_cfg.warmup + m_cfg.frames) {
+        m_frameMs.push_back(std::chrono::duration<double, std::milli>(
+                                Clock::now() - m_frameStart).count());
+        for (int p = 0; p < (int)BenchPhase::Count; ++p)
+            m_phaseMs[p].push_back(m_phaseNow[p]);
+        m_drawnSum += drawn;
+    }
+    ++m_frame;
+}
+
+// ============================================================
+// Report
+// ============================================================
+
+// Nearest-rank percentile of an already sorted vector
+static double pct(const std::vector<double>& s, double p)
+{
+    if (s.empty()) return 0.0;
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)s.size());
+    return s[std::min(std::max(rank, (size_t)1), s.size()) - 1];
+}
+
+static double mean(const std::vector<double>& v)
+{
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return v.empty() ? 0.0 : sum / (double)v.size();
+}
+
+static std::string jsonStr(const std::string& s)
+{
+    std::string r = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') r += '\\';
+        if ((unsigned char)c >= 0x20) r += c;
+    }
+    return r + "\"";
+}
+
+bool BenchmarkMode::writeReport(const std::string& glRenderer, const std::string& glVersion,
+                                int fbWidth, int fbHeight,
+                                const StressSceneStats& sceneStats) const
+{
+    std::ofstream f(m_cfg.outPath, std::ios::trunc);
+    if (!f) {
+        std::cerr << "[Benchmark] Cannot write: " << m_cfg.outPath << "\n";
+        return false;
+    }
+
+    std::vector<double> frames = m_frameMs;
+    std::sort(frames.begin(), frames.end());
+    const double meanMs = mean(frames);
+
+    std::string lower = glRenderer;
+    for (auto& c : lower) c = (char)tolower((unsigned char)c);
+    const bool software = lower.find("llvmpipe") != std::string::npos ||
+                          lower.find("softpipe") != std::string::npos ||
+                          lower.find("swrast")   != std::string::npos;
+
+    f << std::fixed << std::setprecision(4);
+    f << "{\n";
+    f << "  \"tool\": \"Mythos --benchmark\",\n";
+    f << "  \"glRenderer\": " << jsonStr(glRenderer) << ",\n";
+    f << "  \"glVersion\": "  << jsonStr(glVersion)  << ",\n";
+    f << "  \"softwareGL\": " << (software ? "true" : "false") << ",\n";
+    f << "  \"framebuffer\": [" << fbWidth << ", " << fbHeight << "],\n";
+    f << "  \"mode\": \"" << (m_cfg.play ? "play" : "editor") << "\",\n";
+    if (replaying())
+        f << "  \"replay\": " << jsonStr(m_cfg.replayPath) << ",\n";
+    f << "  \"scene\": {\n";
+    if (!m_cfg.scenePath.empty())
+        f << "    \"project\": " << jsonStr(m_cfg.scenePath) << ",\n";
+    else
+        f << "    \"stress\": { \"objects\": " << m_cfg.stress.objectCount
+          << ", \"segments\": "   << m_cfg.stress.meshSegments
+          << ", \"instancing\": " << m_cfg.stress.instancingRatio
+          << ", \"sockets\": "    << m_cfg.stress.socketsPerObject
+          << ", \"seed\": "       << m_cfg.stress.seed << " },\n";
+    f << "    \"objects\": "   << sceneStats.objects   << ",\n";
+    f << "    \"meshes\": "    << sceneStats.meshes    << ",\n";
+    f << "    \"triangles\": " << sceneStats.triangles << ",\n";
+    f << "    \"buildMs\": "   << sceneStats.buildMs   << "\n";
+    f << "  },\n";
+    f << "  \"warmupFrames\": " << m_cfg.warmup << ",\n";
+    f << "  \"frames\": "       << frames.size() << ",\n";
+    f << "  \"avgDrawn\": "     << (frames.empty() ? 0.0 : (double)m_drawnSum / frames.size()) << ",\n";
+    f << "  \"frameMs\": { \"mean\": " << meanMs
+      << ", \"p50\": " << pct(frames, 50) << ", \"p90\": " << pct(frames, 90)
+      << ", \"p95\": " << pct(frames, 95) << ", \"p99\": " << pct(frames, 99)
+      << ", \"min\": " << (frames.empty() ? 0.0 : frames.front())
+      << ", \"max\": " << (frames.empty() ? 0.0 : frames.back()) << " },\n";
+    f << "  \"fps\": " << (meanMs > 0.0 ? 1000.0 / meanMs : 0.0) << ",\n";
+    f << "  \"phasesMs\": {\n";
+    for (int p = 0; p < (int)BenchPhase::Count; ++p) {
+        std::vector<double> s = m_phaseMs[p];
+        std::sort(s.begin(), s.end());
+        f << "    \"" << kPhaseNames[p] << "\": { \"mean\": " << mean(s)
+          << ", \"p50\": " << pct(s, 50) << ", \"p95\": " << pct(s, 95)
+          << ", \"max\": " << (s.empty() ? 0.0 : s.back()) << " }"
+          << (p + 1 < (int)BenchPhase::Count ? "," : "") << "\n";
+    }
+    f << "  }";
+    // Replayed sessions are not uniform, so keep the timeline (frame order)
+    if (replaying()) {
+        f << ",\n  \"frameTimesMs\": [";
+        for (size_t i = 0; i < m_frameMs.size(); ++i)
+            f << (i ? (i % 10 ? ", " : ",\n    ") : "\n    ") << m_frameMs[i];
+        f << "\n  ]";
+    }
+    f << "\n}\n";
+
+    std::cout << "[Benchmark] " << frames.size() << " frames: p50 " << pct(frames, 50)
+              << " ms, p99 " << pct(frames, 99) << " ms -> " << m_cfg.outPath << "\n";
+    return (bool)f;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "StressScene.h"
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Camera;
+class Scene;
+
+// ============================================================
+// BenchmarkMode — scripted, deterministic editor benchmark
+//
+//   Mythos --benchmark [--frames N] [--warmup N] [--out F] [--play]
+//                      [--scene F.gep | --objects N --segments N
+//                       --instancing R --sockets N --seed N] [--size WxH]
+//
+// The scene is a StressScene (or a saved project). Every frame App asks
+// applyFrame() for the camera pose and selection; the camera follows a
+// closed orbit/zoom/pan path over the scene bounds and the selection cycles
+// single → multi → none → all → none, so the outliner, inspector, culling,
+// occlusion and draw paths are all exercised. Time steps are fixed (1/60 s)
+// and the frame cap is off, so runs differ only in how long frames take.
+//
+// App marks phase boundaries with lap(); the frame ends after SwapBuffers +
+// glFinish so GPU work is included. After warm-up, frames are recorded and
+// the report (frame-time percentiles, per-phase CPU times, GL renderer
+// string) is written to JSON — tagging Mesa/llvmpipe runs automatically.
+//
+// Stress options without --benchmark just build the stress scene at startup.
+//
+// --replay F runs a session recorded with --record F (see InputRecorder)
+// instead of the scripted path: the recorded input drives camera and
+// selection, each frame uses its recorded dt, and the report adds per-frame
+// times. Warm-up defaults to 0 there, and every recorded frame after it is
+// timed.
+// ============================================================
+
+struct BenchmarkConfig {
+    bool              enabled     = false;   // --benchmark
+    bool              stressScene = false;   // any stress option given
+    bool              play        = false;   // run in PLAY mode (static batches)
+    int               frames      = 600;     // recorded frames
+    int               warmup      = 60;      // unrecorded frames first
+    int               width       = 1280;
+    int               height      = 720;
+    std::string       outPath     = "mythos_benchmark.json";
+    std::string       scenePath;             // .gep instead of a stress scene
+    std::string       recordPath;            // --record: write input to this file
+    std::string       replayPath;            // --replay: benchmark a recording
+    StressSceneParams stress;
+
+    // false on bad usage (message printed). Unknown arguments are errors.
+    static bool parse(int argc, char** argv, BenchmarkConfig& out);
+    static void printUsage();
+};
+
+// CPU phases of one editor frame, in the order App laps them
+enum class BenchPhase { Update, Visibility, Draw, Ui, Present, Count };
+
+class BenchmarkMode
+{
+public:
+    static constexpr double kFixedDt = 1.0 / 60.0;
+
+    // Captures the scene bounds for the camera path. scene must be populated.
+    void begin(const BenchmarkConfig& cfg, const Scene& scene);
+
+    bool active()   const { return m_active; }
+    bool replaying() const { return !m_cfg.replayPath.empty(); }
+    int  frame()    const { return m_frame; }
+    bool finished() const { return m_active && m_frame >= m_cfg.warmup + m_cfg.frames; }
+
+    // Start of frame: sets camera + selection for this frame index
+    // (only starts the frame timer when replaying).
+    void applyFrame(Scene& scene, Camera& cam);
+
+    // Charges the time since the previous lap (or frame start) to phase.
+    void lap(BenchPhase phase);
+
+    // End of frame (after Present). drawn = objects + chunks submitted.
+    void endFrame(int drawn);
+
+    // Writes the JSON report. glRenderer/glVersion from glGetString.
+    bool writeReport(const std::string& glRenderer, const std::string& glVersion,
+                     int fbWidth, int fbHeight, const StressSceneStats& sceneStats) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkConfig m_cfg;
+    bool            m_active = false;
+    int             m_frame  = 0;        // including warm-up
+
+    glm::vec3 m_centre = {0,0,0};
+    float     m_radius = 10.f;
+    uint32_t  m_rng    = 1;
+
+    Clock::time_point m_frameStart, m_lastLap;
+    double            m_phaseNow[(int)BenchPhase::Count] = {};
+
+    // Recorded frames only
+    std::vector<double> m_frameMs;
+    std::vector<double> m_phaseMs[(int)BenchPhase::Count];
+    int64_t             m_drawnSum = 0;
+
+    uint32_t nextRand();
+};
@@ -0,0 +1,95 @@
+#include "CommandHistory.h"
+#include <algorithm>
+
+void CommandHistory::execute(Command cmd)
+{
+    cmd.exec();
+    push(std::move(cmd));
+}
+
+void CommandHistory::push(Command cmd)
+{
+    // Trim redo tail
+    while (m_count > m_cursor) dropNewest();
+
+    if (m_count == (int)m_ring.size()) {
+        // Full — linearise oldest-first and double the ring
+        std::rotate(m_ring.begin(), m_ring.begin() + (std::ptrdiff_t)m_head, m_ring.end());
+        m_head = 0;
+        m_ring.resize(std::max<size_t>(16, m_ring.size() * 2));
+    }
+
+    m_bytes += entryBytes(cmd);
+    m_ring[slot(m_count)] = std::move(cmd);
+    ++m_count;
+    m_cursor = m_count;
+
+    enforceBudget();
+    trackMemory();
+}
+
+void CommandHistory::undo()
+{
+    if (!canUndo()) return;
+    --m_cursor;
+    m_ring[slot(m_cursor)].undo();
+}
+
+void CommandHistory::redo()
+{
+    if (!canRedo()) return;
+    m_ring[slot(m_cursor)].exec();
+    ++m_cursor;
+}
+
+void CommandHistory::clear()
+{
+    std::vector<Command>().swap(m_ring);
+    m_head = 0;
+    m_count = m_cursor = 0;
+    m_bytes = 0;
+    trackMemory();
+}
+
+void CommandHistory::setBudget(size_t bytes)
+{
+    if (bytes == m_budget) return;
+    m_budget = bytes;
+    enforceBudget();
+    trackMemory();
+}
+
+// Resetting the slot releases the captured state now rather than when the
+// slot is next reused.
+void CommandHistory::dropNewest()
+{
+    Command& c = m_ring[slot(m_count - 1)];
+    m_bytes -= entryBytes(c);
+    c = Command{};
+    --m_count;
+}
+
+void CommandHistory::dropOldest()
+{
+    Command& c = m_ring[m_head];
+    m_bytes -= entryBytes(c);
+    c = Command{};
+    m_head = (m_head + 1) % m_ring.size();
+    --m_count;
+    --m_cursor;
+}
+
+// Oldest entries go first. With everything undone the oldest entry is the
+// next redo, so the redo tail is trimmed from the far end instead.
+void CommandHistory::enforceBudget()
+{
+    while (m_count > 1 && m_bytes > m_budget) {
+        if (m_cursor > 0) dropOldest();
+        else              dropNewest();
+    }
+}
+
+void CommandHistory::trackMemory()
+{
+    m_mem.set(m_bytes + (m_ring.size() - (size_t)m_count) * sizeof(Command));
+}
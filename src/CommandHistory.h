@@ -1,4 +1,5 @@
 #pragma once
+#include "MemoryStats.h"
 #include <functional>
 #include <string>
 #include <vector>
@@ -6,68 +7,67 @@
 // ---- Command ---------------------------------------------------------------
 // A reversible editor action. exec() performs it, undo() reverses it.
 // Both are called exactly once per use — exec on first execute/redo,
-// undo on undo. Capture everything needed by value.
+// undo on undo. Capture everything needed by value — preferably a compact
+// delta (SceneDelta.h) shared by both lambdas rather than two copies.
 struct Command
 {
     std::string          name;   // shown in history panel
     std::function<void()> exec;
     std::function<void()> undo;
+    size_t               bytes = 0;   // captured state — counts against the budget
 };
 
 // ---- CommandHistory --------------------------------------------------------
-// Linear undo/redo stack. execute() discards any redo tail (standard behaviour).
-// Max depth is capped to avoid unbounded memory growth.
+// Linear undo/redo history. execute() discards any redo tail (standard
+// behaviour).
+//
+// Entries live in a ring buffer and are bounded by memory, not count: once
+// the captured state of all entries exceeds budget(), the oldest are dropped
+// in O(1) each. The newest entry is always kept, however large.
 class CommandHistory
 {
 public:
-    static constexpr int kMaxDepth = 100;
+    static constexpr size_t kDefaultBudget = 64u << 20;   // 64 MB
 
     // Execute a command immediately and push it onto the stack.
     // Clears any redo tail beyond the current cursor.
-    void execute(Command cmd)
-    {
-        // Trim redo tail
-        if (m_cursor < (int)m_stack.size())
-            m_stack.erase(m_stack.begin() + m_cursor, m_stack.end());
+    void execute(Command cmd);
 
-        cmd.exec();
-        m_stack.push_back(std::move(cmd));
-
-        // Cap depth — drop oldest entries
-        while ((int)m_stack.size() > kMaxDepth) {
-            m_stack.erase(m_stack.begin());
-        }
-        m_cursor = (int)m_stack.size();
-    }
+    // Push a command whose effect has already been applied (bulk edits
+    // diffed after the fact). exec() runs only on redo.
+    void push(Command cmd);
 
     bool canUndo() const { return m_cursor > 0; }
-    bool canRedo() const { return m_cursor < (int)m_stack.size(); }
-
-    void undo()
-    {
-        if (!canUndo()) return;
-        --m_cursor;
-        m_stack[m_cursor].undo();
-    }
+    bool canRedo() const { return m_cursor < m_count; }
 
-    void redo()
-    {
-        if (!canRedo()) return;
-        m_stack[m_cursor].exec();
-        ++m_cursor;
-    }
+    void undo();
+    void redo();
+    void clear();
 
-    void clear()
-    {
-        m_stack.clear();
-        m_cursor = 0;
-    }
+    void   setBudget(size_t bytes);
+    size_t budget()    const { return m_budget; }
+    size_t bytesUsed() const { return m_bytes; }
 
-    // For the history panel UI — entries newest-first
-    const std::vector<Command>& stack()  const { return m_stack; }
-    int                         cursor() const { return m_cursor; }
+    // For the history panel UI — i = 0 is the oldest entry
+    int            size()         const { return m_count; }
+    const Command& entry(int i)   const { return m_ring[slot(i)]; }
+    int            cursor()       const { return m_cursor; }
 
 private:
-    std::vector<Command> m_stack;
+    std::vector<Command> m_ring;        // capacity grows by doubling
+    size_t               m_head   = 0;  // slot of the oldest entry
+    int                  m_count  = 0;
     int                  m_cursor = 0;  // points AFTER last executed command
+    size_t               m_bytes  = 0;  // sum of entryBytes()
+    size_t               m_budget = kDefaultBudget;
+
+    MemoryStats::Tracked m_mem { MemTag::UndoHistory };
+
+    size_t slot(int i) const { return (m_head + (size_t)i) % m_ring.size(); }
+    static size_t entryBytes(const Command& c) { return sizeof(Command) + c.name.capacity() + c.bytes; }
+
+    void dropNewest();
+    void dropOldest();
+    void enforceBudget();
+    void trackMemory();
 };
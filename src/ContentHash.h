@@ -0,0 +1,54 @@
+#pragma once
+#include "MeshAsset.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// ContentHash — 64-bit FNV-1a over raw bytes
+//
+// Used wherever the editor needs a stable identity for content rather than
+// for a pointer: static-batch chunk hashes, thumbnail cache keys, persisted
+// asset hashes. The values are written to disk, so the algorithm and the
+// byte order of what is hashed must not change — bump the consumer's own
+// version number instead when what it hashes changes.
+// Header-only, GL-free.
+// ============================================================
+
+namespace ContentHash
+{
+    constexpr uint64_t kSeed  = 1469598103934665603ull;
+    constexpr uint64_t kPrime = 1099511628211ull;
+
+    inline uint64_t bytes(uint64_t h, const void* data, size_t n)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= kPrime; }
+        return h;
+    }
+
+    template<typename T>
+    inline uint64_t value(uint64_t h, const T& v) { return bytes(h, &v, sizeof(T)); }
+
+    inline uint64_t mat4(uint64_t h, const glm::mat4& m) { return bytes(h, &m[0][0], sizeof(float) * 16); }
+
+    // Geometry + material ranges of a mesh. Independent of GPU state and of
+    // the asset's name/path, so identical content hashes identically.
+    inline uint64_t mesh(const MeshData& data, const std::vector<SubMesh>& submeshes)
+    {
+        uint64_t h = kSeed;
+        uint64_t nv = data.vertices.size(), ni = data.indices.size(), ns = submeshes.size();
+        h = value(h, nv);
+        h = value(h, ni);
+        h = value(h, ns);
+        if (nv) h = bytes(h, data.vertices.data(), nv * sizeof(MeshVertex));
+        if (ni) h = bytes(h, data.indices.data(),  ni * sizeof(unsigned int));
+        for (const SubMesh& s : submeshes) {
+            h = value(h, s.color);
+            h = value(h, s.indexOffset);
+            h = value(h, s.indexCount);
+        }
+        return h;
+    }
+}
@@ -0,0 +1,271 @@
+#include "Culling.h"
+#include "Profiler.h"
+#include "MemoryStats.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYTHOS_CULL_SSE 1
+#endif
+
+// ============================================================
+// Frustum
+// ============================================================
+
+Frustum Frustum::fromViewProj(const glm::mat4& m)
+{
+    // glm is column-major: row i = (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum f;
+    f.planes[0] = r3 + r0;   // left
+    f.planes[1] = r3 - r0;   // right
+    f.planes[2] = r3 + r1;   // bottom
+    f.planes[3] = r3 - r1;   // top
+    f.planes[4] = r3 + r2;   // near  (GL clip space: -w ≤ z)
+    f.planes[5] = r3 - r2;   // far
+
+    for (auto& p : f.planes) {
+        float len = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+        if (len > 1e-12f) p = p / len;
+    }
+    return f;
+}
+
+Frustum::Result Frustum::testAABB(const glm::vec3& bmin, const glm::vec3& bmax) const
+{
+    Result r = Inside;
+    for (const auto& p : planes) {
+        // Positive vertex — the corner furthest along the plane normal
+        glm::vec3 pv(p.x >= 0.f ? bmax.x : bmin.x,
+                     p.y >= 0.f ? bmax.y : bmin.y,
+                     p.z >= 0.f ? bmax.z : bmin.z);
+        if (p.x*pv.x + p.y*pv.y + p.z*pv.z + p.w < 0.f) return Outside;
+
+        glm::vec3 nv(p.x >= 0.f ? bmin.x : bmax.x,
+                     p.y >= 0.f ? bmin.y : bmax.y,
+                     p.z >= 0.f ? bmin.z : bmax.z);
+        if (p.x*nv.x + p.y*nv.y + p.z*nv.z + p.w < 0.f) r = Intersects;
+    }
+    return r;
+}
+
+// ============================================================
+// SceneCuller — build
+// ============================================================
+
+void SceneCuller::worldAABB(const SceneObject& obj, glm::vec3& bmin, glm::vec3& bmax)
+{
+    glm::vec3 lmin(-0.5f), lmax(0.5f);
+    if (obj.mesh && obj.mesh->data.aabbMin.x <= obj.mesh->data.aabbMax.x) {
+        lmin = obj.mesh->data.aabbMin;
+        lmax = obj.mesh->data.aabbMax;
+    }
+
+    // Arvo: transform the centre, and the extents by |M| (upper 3×3)
+    glm::mat4 M = obj.transform();
+    glm::vec3 c = (lmin + lmax) * 0.5f;
+    glm::vec3 e = (lmax - lmin) * 0.5f;
+    glm::vec3 wc = glm::vec3(M * glm::vec4(c, 1.f));
+    glm::vec3 we(0.f);
+    for (int col = 0; col < 3; ++col)
+        for (int r = 0; r < 3; ++r)
+            we[r] += std::fabs(M[col][r]) * e[col];
+
+    bmin = wc - we;
+    bmax = wc + we;
+}
+
+void SceneCuller::rebuild(const std::vector<SceneObject>& objects)
+{
+    MYTHOS_PROFILE_SCOPE("SceneCuller::rebuild");
+    struct Entry { uint64_t key; int obj; glm::vec3 bmin, bmax; };
+    std::vector<Entry> entries;
+    entries.reserve(objects.size());
+
+    for (int i = 0; i < (int)objects.size(); ++i) {
+        const SceneObject& o = objects[i];
+        if (!o.visible) continue;
+        Entry e;
+        e.obj = i;
+        worldAABB(o, e.bmin, e.bmax);
+        glm::vec3 c = (e.bmin + e.bmax) * 0.5f;
+        int cx = (int)std::floor(c.x / kClusterSize);
+        int cz = (int)std::floor(c.z / kClusterSize);
+        e.key = SpatialGrid::mortonEncode((uint32_t)cx ^ 0x80000000u,
+                                          (uint32_t)cz ^ 0x80000000u);
+        entries.push_back(e);
+    }
+
+    // Morton order keeps clusters — and runs of clusters — spatially compact
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) {
+                  return a.key < b.key || (a.key == b.key && a.obj < b.obj);
+              });
+
+    size_t n = entries.size();
+    m_minX.resize(n); m_minY.resize(n); m_minZ.resize(n);
+    m_maxX.resize(n); m_maxY.resize(n); m_maxZ.resize(n);
+    m_objIndex.resize(n);
+    m_clusters.clear();
+    m_supers.clear();
+
+    for (size_t i = 0; i < n; ++i) {
+        const Entry& e = entries[i];
+        m_minX[i] = e.bmin.x; m_minY[i] = e.bmin.y; m_minZ[i] = e.bmin.z;
+        m_maxX[i] = e.bmax.x; m_maxY[i] = e.bmax.y; m_maxZ[i] = e.bmax.z;
+        m_objIndex[i] = e.obj;
+
+        if (i == 0 || e.key != entries[i-1].key)
+            m_clusters.push_back({ e.bmin, e.bmax, (int)i, 0 });
+        Node& c = m_clusters.back();
+        c.bmin = glm::min(c.bmin, e.bmin);
+        c.bmax = glm::max(c.bmax, e.bmax);
+        ++c.count;
+    }
+
+    for (int ci = 0; ci < (int)m_clusters.size(); ++ci) {
+        const Node& c = m_clusters[ci];
+        if (ci % kClustersPerSuper == 0)
+            m_supers.push_back({ c.bmin, c.bmax, ci, 0 });
+        Node& s = m_supers.back();
+        s.bmin = glm::min(s.bmin, c.bmin);
+        s.bmax = glm::max(s.bmax, c.bmax);
+        ++s.count;
+    }
+}
+
+// ============================================================
+// SceneCuller — query
+// ============================================================
+
+static float aabbDistance(const glm::vec3& bmin, const glm::vec3& bmax, const glm::vec3& p)
+{
+    float dx = std::max(std::max(bmin.x - p.x, 0.f), p.x - bmax.x);
+    float dy = std::max(std::max(bmin.y - p.y, 0.f), p.y - bmax.y);
+    float dz = std::max(std::max(bmin.z - p.z, 0.f), p.z - bmax.z);
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+bool SceneCuller::passesDetail(int i, const CullParams& p) const
+{
+    glm::vec3 bmin(m_minX[i], m_minY[i], m_minZ[i]);
+    glm::vec3 bmax(m_maxX[i], m_maxY[i], m_maxZ[i]);
+
+    if (p.maxDistance > 0.f && aabbDistance(bmin, bmax, p.eye) > p.maxDistance)
+        return false;
+
+    if (p.minPixels > 0.f) {
+        glm::vec3 c = (bmin + bmax) * 0.5f;
+        glm::vec3 h = (bmax - bmin) * 0.5f;
+        float radius = std::sqrt(h.x*h.x + h.y*h.y + h.z*h.z);
+        glm::vec3 d  = c - p.eye;
+        float dist   = std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
+        if (dist > radius) {
+            float tanHalf = std::tan(glm::radians(p.fovY) * 0.5f);
+            float pixels  = (radius / (dist * tanHalf)) * p.viewportHeight;   // diameter
+            if (pixels < p.minPixels) return false;
+        }
+    }
+    return true;
+}
+
+void SceneCuller::emitRange(int first, int count, const CullParams& p,
+                            std::vector<int>& out) const
+{
+    bool detail = p.maxDistance > 0.f || p.minPixels > 0.f;
+    for (int i = first; i < first + count; ++i)
+        if (!detail || passesDetail(i, p))
+            out.push_back(m_objIndex[i]);
+}
+
+void SceneCuller::testRange(int first, int count, const Frustum& f,
+                            const CullParams& p, std::vector<int>& out,
+                            CullStats* stats) const
+{
+    if (stats) stats->objectsTested += count;
+    int i   = first;
+    int end = first + count;
+
+#ifdef MYTHOS_CULL_SSE
+    // Four AABBs per iteration. For each plane the positive-vertex distance is
+    // d + Σ max(n·min, n·max) — branch-free, no per-lane vertex selection.
+    for (; i + 4 <= end; i += 4) {
+        __m128 mnx = _mm_loadu_ps(&m_minX[i]), mxx = _mm_loadu_ps(&m_maxX[i]);
+        __m128 mny = _mm_loadu_ps(&m_minY[i]), mxy = _mm_loadu_ps(&m_maxY[i]);
+        __m128 mnz = _mm_loadu_ps(&m_minZ[i]), mxz = _mm_loadu_ps(&m_maxZ[i]);
+        __m128 outside = _mm_setzero_ps();
+
+        for (const auto& pl : f.planes) {
+            __m128 nx = _mm_set1_ps(pl.x), ny = _mm_set1_ps(pl.y);
+            __m128 nz = _mm_set1_ps(pl.z), d  = _mm_set1_ps(pl.w);
+            __m128 dx = _mm_max_ps(_mm_mul_ps(nx, mnx), _mm_mul_ps(nx, mxx));
+            __m128 dy = _mm_max_ps(_mm_mul_ps(ny, mny), _mm_mul_ps(ny, mxy));
+            __m128 dz = _mm_max_ps(_mm_mul_ps(nz, mnz), _mm_mul_ps(nz, mxz));
+            __m128 dist = _mm_add_ps(_mm_add_ps(dx, dy), _mm_add_ps(dz, d));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        if (mask == 0xF) continue;
+        for (int lane = 0; lane < 4; ++lane)
+            if (!(mask & (1 << lane)) && passesDetail(i + lane, p))
+                out.push_back(m_objIndex[i + lane]);
+    }
+#endif
+
+    // Scalar tail (and the whole range without SSE) — same arithmetic
+    for (; i < end; ++i) {
+        bool outside = false;
+        for (const auto& pl : f.planes) {
+            float dist = pl.w
+                + std::max(pl.x * m_minX[i], pl.x * m_maxX[i])
+                + std::max(pl.y * m_minY[i], pl.y * m_maxY[i])
+                + std::max(pl.z * m_minZ[i], pl.z * m_maxZ[i]);
+            if (dist < 0.f) { outside = true; break; }
+        }
+        if (!outside && passesDetail(i, p))
+            out.push_back(m_objIndex[i]);
+    }
+}
+
+void SceneCuller::cull(const CullParams& p, std::vector<int>& out,
+                       CullStats* stats) const
+{
+    MYTHOS_PROFILE_SCOPE("SceneCuller::cull");
+    // Room for every object up front, so traversal itself never allocates.
+    // Callers that keep `out` between frames only pay this once.
+    size_t before = out.size();
+    out.reserve(before + m_objIndex.size());
+
+    MYTHOS_NO_ALLOC_SCOPE("SceneCuller::cull");
+    Frustum f = Frustum::fromViewProj(p.viewProj);
+
+    auto nodeFar = [&](const Node& n) {
+        return p.maxDistance > 0.f && aabbDistance(n.bmin, n.bmax, p.eye) > p.maxDistance;
+    };
+
+    for (const Node& s : m_supers) {
+        if (stats) ++stats->nodesTested;
+        if (nodeFar(s)) continue;
+        Frustum::Result rs = f.testAABB(s.bmin, s.bmax);
+        if (rs == Frustum::Outside) continue;
+
+        for (int ci = s.first; ci < s.first + s.count; ++ci) {
+            const Node& c = m_clusters[ci];
+            if (rs == Frustum::Inside) { emitRange(c.first, c.count, p, out); continue; }
+
+            if (stats) ++stats->nodesTested;
+            if (nodeFar(c)) continue;
+            Frustum::Result rc = f.testAABB(c.bmin, c.bmax);
+            if (rc == Frustum::Outside)     continue;
+            if (rc == Frustum::Inside)      emitRange(c.first, c.count, p, out);
+            else                            testRange(c.first, c.count, f, p, out, stats);
+        }
+    }
+
+    if (stats) stats->visible = (int)(out.size() - before);
+}
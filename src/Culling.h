@@ -0,0 +1,103 @@
+#pragma once
+#include "SceneObject.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// Culling — frustum / distance / screen-size visibility
+//
+// SceneCuller keeps world-space AABBs of every scene object in a small
+// bounding-volume hierarchy built from the XZ layout:
+//
+//   super-cluster  →  cluster (kClusterSize² world units)  →  objects
+//
+// Clusters are ordered by the Morton code of their XZ cell, so a run of
+// consecutive clusters is spatially compact and a fixed-size group of them
+// makes a tight super-cluster. Traversal rejects whole groups outside the
+// frustum and accepts whole groups fully inside it; only groups straddling
+// a plane are tested per object, four AABBs at a time with SSE.
+//
+// The hierarchy is rebuilt only when the scene version changes — per-frame
+// cost is proportional to what is (nearly) visible, not to scene size.
+// GL-free: the same code runs in headless tools.
+// ============================================================
+
+// ---- Frustum ---------------------------------------------------------------
+// Six planes (a,b,c,d) with normals pointing inwards: inside ⇔ dot(n,p)+d ≥ 0.
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    // Gribb–Hartmann extraction from a combined projection * view matrix.
+    static Frustum fromViewProj(const glm::mat4& viewProj);
+
+    enum Result { Outside, Intersects, Inside };
+    Result testAABB(const glm::vec3& bmin, const glm::vec3& bmax) const;
+};
+
+// ---- CullParams ------------------------------------------------------------
+struct CullParams
+{
+    glm::mat4 viewProj   = glm::mat4(1.f);
+    glm::vec3 eye        = {0,0,0};
+
+    // Distance culling — objects whose AABB lies further than this are
+    // dropped. 0 disables.
+    float maxDistance    = 0.f;
+
+    // Screen-size culling — objects whose projected bounding sphere covers
+    // fewer than this many pixels (diameter) are dropped. 0 disables.
+    float minPixels      = 0.f;
+    float viewportHeight = 720.f;
+    float fovY           = 45.f;    // degrees, must match the projection
+};
+
+struct CullStats
+{
+    int nodesTested   = 0;   // clusters + super-clusters plane-tested
+    int objectsTested = 0;   // per-object plane tests
+    int visible       = 0;
+};
+
+// ---- SceneCuller -----------------------------------------------------------
+class SceneCuller
+{
+public:
+    static constexpr float kClusterSize   = 16.f;   // world units per cluster edge
+    static constexpr int   kClustersPerSuper = 16;
+
+    // Rebuild bounds + hierarchy. Call when the scene version changed.
+    void rebuild(const std::vector<SceneObject>& objects);
+
+    // Indices (into the objects vector passed to rebuild) of survivors,
+    // appended to `out` in hierarchy order.
+    void cull(const CullParams& params, std::vector<int>& out,
+              CullStats* stats = nullptr) const;
+
+    uint64_t builtVersion() const { return m_version; }
+    void     setBuiltVersion(uint64_t v) { m_version = v; }
+
+    // World AABB of an object (mesh bounds through its transform; unit cube
+    // for objects without a mesh). Exposed for other culling stages.
+    static void worldAABB(const SceneObject& obj, glm::vec3& bmin, glm::vec3& bmax);
+
+private:
+    struct Node { glm::vec3 bmin, bmax; int first, count; };
+
+    // Object bounds in SoA, ordered by cluster
+    std::vector<float> m_minX, m_minY, m_minZ;
+    std::vector<float> m_maxX, m_maxY, m_maxZ;
+    std::vector<int>   m_objIndex;
+
+    std::vector<Node> m_clusters;   // first/count index objects
+    std::vector<Node> m_supers;     // first/count index clusters
+
+    uint64_t m_version = ~0ull;
+
+    void emitRange(int first, int count, const CullParams& p,
+                   std::vector<int>& out) const;
+    void testRange(int first, int count, const Frustum& f, const CullParams& p,
+                   std::vector<int>& out, CullStats* stats) const;
+    bool passesDetail(int i, const CullParams& p) const;
+};
@@ -1,6 +1,8 @@
 #include "EditorUI.h"
+#include "Profiler.h"
 #include "FileDialog.h"
 #include <imgui.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <cmath>
@@ -29,6 +31,7 @@ void EditorUI::init()
 
 bool EditorUI::render(EditorUIState& state)
 {
+    MYTHOS_PROFILE_SCOPE("EditorUI::render");
     bool wantQuit = false;
 
     if (state.mode == EditorMode::PLAY)
@@ -64,6 +67,7 @@ bool EditorUI::render(EditorUIState& state)
     if (!state.panelsHidden)
     {
         drawScenePanel(state);
+        drawStressWindow(state);
         drawStatusToast(state);
     }
 
@@ -138,6 +142,51 @@ void EditorUI::drawMainMenuBar(EditorUIState& state)
         ImGui::MenuItem("Grammar View",   nullptr, &state.showGrammarView);
         ImGui::MenuItem("Graph Viewer",   nullptr, &state.showGraphViewer);
         ImGui::MenuItem("Test Editbox",   nullptr, &state.showTestWindow);
+        ImGui::MenuItem("Stress Scene",   nullptr, &state.showStressWindow);
+        ImGui::MenuItem("Profiler",       nullptr, &state.showProfiler);
+        ImGui::MenuItem("Memory",         nullptr, &state.showMemory);
+        ImGui::EndMenu();
+    }
+
+    if (ImGui::BeginMenu("View"))
+    {
+        ImGui::MenuItem("Wireframe",        nullptr, &state.wireframeMode);
+        ImGui::Separator();
+        ImGui::MenuItem("Redraw On Demand", nullptr, &state.redrawOnDemand);
+        ImGui::BeginDisabled(!state.redrawOnDemand);
+        ImGui::SetNextItemWidth(120.f);
+        ImGui::SliderInt("Idle FPS", &state.idleFps, 0, 30);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Frame rate while nothing changes.\n"
+                              "0 draws only when there is input.");
+        ImGui::EndDisabled();
+        ImGui::Separator();
+        ImGui::MenuItem("Frustum Culling",  nullptr, &state.cullEnabled);
+        ImGui::BeginDisabled(!state.cullEnabled);
+        ImGui::MenuItem("Distance Culling", nullptr, &state.cullDistanceEnabled);
+        ImGui::BeginDisabled(!state.cullDistanceEnabled);
+        ImGui::SliderFloat("Max Distance", &state.cullMaxDistance, 10.f, 500.f, "%.0f");
+        ImGui::EndDisabled();
+        ImGui::SliderFloat("Min Pixels",   &state.cullMinPixels, 0.f, 8.f, "%.1f px");
+        ImGui::MenuItem("Occlusion Culling", nullptr, &state.occlusionEnabled);
+        ImGui::EndDisabled();
+        ImGui::Separator();
+        ImGui::MenuItem("Static Batching (Play)", nullptr, &state.staticBatching);
+        ImGui::Separator();
+        ImGui::SetNextItemWidth(120.f);
+        ImGui::Combo("CPU Mesh Data", &state.meshResidency, "Keep\0Compress\0Evict\0");
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("What to do with mesh data already uploaded to the GPU.\n"
+                              "Compressed / evicted data is restored when needed.");
+        ImGui::TextDisabled("  %.1f MB resident", state.meshCpuBytes / (1024.0 * 1024.0));
+        ImGui::Separator();
+        ImGui::SetNextItemWidth(120.f);
+        ImGui::SliderInt("Undo Memory", &state.undoBudgetMB, 8, 1024, "%d MB",
+                         ImGuiSliderFlags_Logarithmic);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Oldest undo steps are dropped beyond this budget.");
+        ImGui::TextDisabled("  %.1f MB in %d steps", state.undoBytes / (1024.0 * 1024.0),
+                            state.undoSteps);
         ImGui::EndMenu();
     }
 
@@ -392,6 +441,9 @@ void EditorUI::drawStatusBar(EditorUIState& state)
     else
         ImGui::Text("%d objects", state.numObjects);
 
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%d drawn)", state.numDrawn);
+
     ImGui::SameLine();
     ImGui::TextDisabled("|");
     ImGui::SameLine();
@@ -552,3 +604,35 @@ void EditorUI::drawStatusToast(EditorUIState& state)
     ImGui::PopStyleVar();
     ImGui::End();
 }
+
+// ============================================================
+// Stress scene generator
+// ============================================================
+
+void EditorUI::drawStressWindow(EditorUIState& state)
+{
+    if (!state.showStressWindow) return;
+
+    ImGui::SetNextWindowSize({300.f, 0.f}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Stress Scene", &state.showStressWindow)) { ImGui::End(); return; }
+
+    ImGui::DragInt  ("Objects",    &state.stressObjects, 100.f, 1, 1000000);
+    ImGui::SliderInt("Segments",   &state.stressSegments, 1, 32);
+    ImGui::SliderFloat("Instancing", &state.stressInstancing, 0.f, 1.f, "%.2f");
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Fraction of objects that share an existing mesh.\n"
+                          "1.0 = one mesh for everything, 0.0 = every mesh unique.");
+    ImGui::SliderInt("Sockets",    &state.stressSockets, 0, 4);
+    ImGui::InputInt ("Seed",       &state.stressSeed);
+
+    const int unique = std::max(1, (int)std::lround(state.stressObjects * (1.0 - state.stressInstancing)));
+    ImGui::TextDisabled("%d meshes, %lld triangles",
+        std::min(unique, std::max(state.stressObjects, 1)),
+        (long long)state.stressObjects * 12 * state.stressSegments * state.stressSegments);
+
+    ImGui::Separator();
+    if (ImGui::Button("Generate (replaces scene)", {-1.f, 0.f}))
+        state.stressGenerate = true;
+
+    ImGui::End();
+}
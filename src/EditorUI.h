@@ -96,6 +96,7 @@ struct EditorUIState
     float fps         = 0.f;
     int   numObjects  = 0;
     int   numSelected = 0;
+    int   numDrawn    = 0;   // survivors of culling this frame
 
     // Test editbox content
     std::string editboxText;
@@ -105,6 +106,17 @@ struct EditorUIState
     bool showAssetLibrary  = false;
     bool showGrammarView   = false;
     bool showGraphViewer   = false;   // MG-2.5 imnodes graph viewer
+    bool showStressWindow  = false;   // synthetic stress-scene generator
+    bool showProfiler      = false;   // CPU/GPU frame profiler
+    bool showMemory        = false;   // per-subsystem memory counters
+
+    // Stress scene parameters (Windows → Stress Scene). Generate is drained by App.
+    int   stressObjects    = 10000;
+    int   stressSegments   = 4;
+    float stressInstancing = 0.95f;
+    int   stressSockets    = 2;
+    int   stressSeed       = 1;
+    bool  stressGenerate   = false;
 
     // Set true by App while the user is panning/zooming/orbiting the scene.
     bool sceneInteracting = false;
@@ -123,6 +135,27 @@ struct EditorUIState
     // View mode
     bool wireframeMode = false;
 
+    // Main loop: draw only after changes; when idle wake at idleFps (0 = on events only)
+    bool redrawOnDemand = true;
+    int  idleFps        = 1;
+
+    // Culling (View menu). Distance/size culling only apply when enabled.
+    bool  cullEnabled         = true;
+    bool  cullDistanceEnabled = false;
+    float cullMaxDistance     = 150.f;   // world units
+    float cullMinPixels       = 1.5f;    // projected diameter; 0 = off
+    bool  occlusionEnabled    = true;    // CPU occlusion after the frustum pass
+    bool  staticBatching      = true;    // PLAY: draw merged chunk meshes
+
+    // CPU copy of uploaded meshes: 0 keep, 1 compress, 2 evict (MeshResidency)
+    int    meshResidency = 0;
+    size_t meshCpuBytes  = 0;            // last measured, for the View menu
+
+    // Undo history memory budget (CommandHistory) and current use
+    int    undoBudgetMB  = 64;
+    size_t undoBytes     = 0;
+    int    undoSteps     = 0;
+
     // Layout constants — read by App to position viewport / gizmo.
     float menuBarHeight   = 0.f;
     float toolbarHeight   = 40.f;
@@ -190,4 +223,5 @@ private:
     void drawStatusBar  (EditorUIState& state);
     void drawScenePanel (EditorUIState& state);
     void drawStatusToast(EditorUIState& state);
+    void drawStressWindow(EditorUIState& state);
 };
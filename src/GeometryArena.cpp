@@ -0,0 +1,229 @@
+#include "GeometryArena.h"
+#include <iostream>
+#include <algorithm>
+
+// ============================================================
+// RangeAllocator
+// ============================================================
+
+void RangeAllocator::reset(size_t capacity)
+{
+    m_free.clear();
+    m_capacity = capacity;
+    m_used     = 0;
+    if (capacity) m_free[0] = capacity;
+}
+
+size_t RangeAllocator::allocate(size_t count)
+{
+    if (count == 0) return (size_t)-1;
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (it->second < count) continue;
+        size_t offset = it->first;
+        size_t remain = it->second - count;
+        m_free.erase(it);
+        if (remain) m_free[offset + count] = remain;
+        m_used += count;
+        return offset;
+    }
+    return (size_t)-1;
+}
+
+void RangeAllocator::release(size_t offset, size_t count)
+{
+    if (count == 0) return;
+    m_used -= count;
+
+    auto next = m_free.lower_bound(offset);
+
+    // Merge with the following block
+    if (next != m_free.end() && offset + count == next->first) {
+        count += next->second;
+        next = m_free.erase(next);
+    }
+    // Merge with the preceding block
+    if (next != m_free.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += count;
+            return;
+        }
+    }
+    m_free[offset] = count;
+}
+
+void RangeAllocator::grow(size_t newCapacity)
+{
+    if (newCapacity <= m_capacity) return;
+    size_t extra = newCapacity - m_capacity;
+    size_t start = m_capacity;
+    m_capacity = newCapacity;
+    m_used += extra;            // release() subtracts it again
+    release(start, extra);
+}
+
+// ============================================================
+// GeometryArena
+// ============================================================
+
+bool GeometryArena::init(size_t vertexCapacity, size_t indexCapacity)
+{
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glGenBuffers(1, &m_ibo);
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)(vertexCapacity * sizeof(MeshVertex)), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 (GLsizeiptr)(indexCapacity * sizeof(unsigned int)), nullptr, GL_STATIC_DRAW);
+    bindVertexLayout();
+    glBindVertexArray(0);
+
+    m_vertAlloc.reset(vertexCapacity);
+    m_indexAlloc.reset(indexCapacity);
+    trackBytes();
+    return m_vao && m_vbo && m_ibo;
+}
+
+void GeometryArena::shutdown()
+{
+    if (m_vao) { glDeleteVertexArrays(1, &m_vao); m_vao = 0; }
+    if (m_vbo) { glDeleteBuffers(1, &m_vbo);      m_vbo = 0; }
+    if (m_ibo) { glDeleteBuffers(1, &m_ibo);      m_ibo = 0; }
+    m_vertAlloc.reset(0);
+    m_indexAlloc.reset(0);
+    trackBytes();
+}
+
+// Same interleaved layout as MeshAsset::upload — locations 0/1/2.
+// Must be called with m_vao bound and m_vbo bound to GL_ARRAY_BUFFER.
+void GeometryArena::bindVertexLayout()
+{
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          (void*)offsetof(MeshVertex, pos));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          (void*)offsetof(MeshVertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          (void*)offsetof(MeshVertex, uv));
+    glEnableVertexAttribArray(2);
+}
+
+// Copy-grow a buffer: allocate the larger store, copy the old bytes across
+// on the GPU, and swap the handle. Returns the new handle.
+static GLuint growBuffer(GLuint oldBuf, size_t oldBytes, size_t newBytes)
+{
+    GLuint newBuf = 0;
+    glGenBuffers(1, &newBuf);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuf);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)newBytes, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, oldBuf);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                        0, 0, (GLsizeiptr)oldBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &oldBuf);
+    return newBuf;
+}
+
+void GeometryArena::growVertices(size_t minCapacity)
+{
+    size_t oldCap = m_vertAlloc.capacity();
+    size_t newCap = std::max(minCapacity, oldCap * 2);
+    m_vbo = growBuffer(m_vbo, oldCap * sizeof(MeshVertex), newCap * sizeof(MeshVertex));
+
+    // Attribute pointers capture the buffer — re-point them at the new store
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    bindVertexLayout();
+    glBindVertexArray(0);
+
+    m_vertAlloc.grow(newCap);
+    trackBytes();
+    std::cout << "[GeometryArena] Vertex pool grown to " << newCap << " verts\n";
+}
+
+void GeometryArena::growIndices(size_t minCapacity)
+{
+    size_t oldCap = m_indexAlloc.capacity();
+    size_t newCap = std::max(minCapacity, oldCap * 2);
+    m_ibo = growBuffer(m_ibo, oldCap * sizeof(unsigned int), newCap * sizeof(unsigned int));
+
+    // The element buffer binding is VAO state
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+    glBindVertexArray(0);
+
+    m_indexAlloc.grow(newCap);
+    trackBytes();
+    std::cout << "[GeometryArena] Index pool grown to " << newCap << " indices\n";
+}
+
+bool GeometryArena::reserve(size_t nv, size_t ni, size_t& vOff, size_t& iOff)
+{
+    vOff = m_vertAlloc.allocate(nv);
+    if (vOff == (size_t)-1) {
+        growVertices(m_vertAlloc.capacity() + nv);
+        vOff = m_vertAlloc.allocate(nv);
+    }
+    iOff = m_indexAlloc.allocate(ni);
+    if (iOff == (size_t)-1) {
+        growIndices(m_indexAlloc.capacity() + ni);
+        iOff = m_indexAlloc.allocate(ni);
+    }
+    if (vOff == (size_t)-1 || iOff == (size_t)-1) {
+        std::cerr << "[GeometryArena] Allocation failed (" << nv << " verts, "
+                  << ni << " indices)\n";
+        if (vOff != (size_t)-1) m_vertAlloc.release(vOff, nv);
+        if (iOff != (size_t)-1) m_indexAlloc.release(iOff, ni);
+        return false;
+    }
+    return true;
+}
+
+bool GeometryArena::allocate(const MeshData& data, ArenaRange& out)
+{
+    if (!m_vao || data.vertices.empty() || data.indices.empty()) return false;
+
+    size_t nv = data.vertices.size();
+    size_t ni = data.indices.size();
+    size_t vOff, iOff;
+    if (!reserve(nv, ni, vOff, iOff)) return false;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(vOff * sizeof(MeshVertex)),
+                    (GLsizeiptr)(nv * sizeof(MeshVertex)), data.vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Upload indices through the copy-write target so the element binding of
+    // whatever VAO happens to be bound is left untouched.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_ibo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)(iOff * sizeof(unsigned int)),
+                    (GLsizeiptr)(ni * sizeof(unsigned int)), data.indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    out.baseVertex  = (int)vOff;
+    out.firstIndex  = (int)iOff;
+    out.vertexCount = (int)nv;
+    out.indexCount  = (int)ni;
+    trackBytes();
+    return true;
+}
+
+void GeometryArena::release(ArenaRange& range)
+{
+    if (!range.valid()) return;
+    m_vertAlloc.release((size_t)range.baseVertex, (size_t)range.vertexCount);
+    m_indexAlloc.release((size_t)range.firstIndex, (size_t)range.indexCount);
+    range = ArenaRange{};
+    trackBytes();
+}
+
+static GeometryArena* s_meshPool = nullptr;
+
+GeometryArena* GeometryArena::meshPool()                   { return s_meshPool; }
+void           GeometryArena::setMeshPool(GeometryArena* a) { s_meshPool = a; }
@@ -0,0 +1,102 @@
+#pragma once
+#include <glad/glad.h>
+#include "MeshAsset.h"
+#include <map>
+#include <cstddef>
+
+// ============================================================
+// GeometryArena — pooled GPU storage for many meshes
+//
+// Instead of one VAO/VBO/EBO per MeshAsset, meshes are packed into a single
+// large vertex buffer and a single large index buffer behind ONE shared VAO.
+// Each mesh gets a sub-range (baseVertex, firstIndex); index values stay
+// mesh-local and are offset at draw time via baseVertex.
+//
+// With everything in one VAO the whole scene can be submitted with
+// glMultiDrawElementsIndirect (or, on GL 3.3, a tight BaseVertex loop)
+// without rebinding vertex state between meshes.
+//
+// Buffers grow by doubling; existing contents are copied GPU-side with
+// glCopyBufferSubData, so ranges handed out earlier remain valid.
+// ============================================================
+
+// ---- RangeAllocator --------------------------------------------------------
+// First-fit free-list over [0, capacity) in abstract units (vertices or
+// indices). Adjacent free blocks are coalesced on release.
+class RangeAllocator
+{
+public:
+    void   reset(size_t capacity);
+    // Returns offset, or (size_t)-1 if no block is large enough.
+    size_t allocate(size_t count);
+    void   release(size_t offset, size_t count);
+    // Extend capacity (after the backing buffer has grown).
+    void   grow(size_t newCapacity);
+
+    size_t capacity() const { return m_capacity; }
+    size_t used()     const { return m_used; }
+
+private:
+    std::map<size_t, size_t> m_free;   // offset → length
+    size_t m_capacity = 0;
+    size_t m_used     = 0;
+};
+
+// ---- ArenaRange ------------------------------------------------------------
+// Where one mesh lives inside the arena.
+struct ArenaRange
+{
+    int baseVertex  = -1;   // added to every index of this mesh
+    int firstIndex  = 0;    // first index in the shared IBO
+    int vertexCount = 0;
+    int indexCount  = 0;
+
+    bool valid() const { return baseVertex >= 0; }
+};
+
+// ---- GeometryArena ---------------------------------------------------------
+class GeometryArena
+{
+public:
+    bool init(size_t vertexCapacity = 1 << 18, size_t indexCapacity = 1 << 20);
+    void shutdown();
+
+    // Copy a mesh's vertices/indices into the arena. Grows if needed.
+    bool allocate(const MeshData& data, ArenaRange& out);
+    void release(ArenaRange& range);
+
+    // The arena MeshAsset::upload() allocates from — the Renderer's, set by
+    // Renderer::init and cleared by Renderer::shutdown. Asset geometry lives
+    // only here; there are no per-asset buffers to keep in sync.
+    static GeometryArena* meshPool();
+    static void           setMeshPool(GeometryArena* arena);
+
+    GLuint vao() const { return m_vao; }
+    GLuint vbo() const { return m_vbo; }
+    GLuint ibo() const { return m_ibo; }
+
+    size_t vertexBytesUsed() const { return m_vertAlloc.used()  * sizeof(MeshVertex); }
+    size_t indexBytesUsed()  const { return m_indexAlloc.used() * sizeof(unsigned int); }
+
+private:
+    GLuint m_vao = 0;
+    GLuint m_vbo = 0;
+    GLuint m_ibo = 0;
+
+    RangeAllocator m_vertAlloc;
+    RangeAllocator m_indexAlloc;
+
+    // Unused buffer store under MemTag::RenderBuffers. The used part is
+    // charged to each MeshAsset (MemTag::GpuMesh), so the two add up to the
+    // allocated capacity without counting a mesh twice.
+    MemoryStats::Tracked m_mem { MemTag::RenderBuffers };
+    void trackBytes() {
+        m_mem.set((m_vertAlloc.capacity()  - m_vertAlloc.used())  * sizeof(MeshVertex) +
+                  (m_indexAlloc.capacity() - m_indexAlloc.used()) * sizeof(unsigned int));
+    }
+
+    void growVertices(size_t minCapacity);
+    void growIndices (size_t minCapacity);
+    void bindVertexLayout();
+    bool reserve(size_t nv, size_t ni, size_t& vOff, size_t& iOff);   // grows on demand
+};
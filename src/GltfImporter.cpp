@@ -1,4 +1,6 @@
 #include "GltfImporter.h"
+#include "Profiler.h"
+#include "MemoryStats.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -62,12 +64,14 @@ struct JVal {
 struct Parser {
     const char* p;
     const char* end;
+    size_t      nodes = 0;   // values parsed (MemoryStats estimate)
 
     Parser(const char* data, size_t len) : p(data), end(data+len) {}
 
     void skipWS() { while (p < end && (*p==' '||*p=='\t'||*p=='\n'||*p=='\r')) ++p; }
 
     JVal parse() {
+        ++nodes;
         skipWS();
         if (p >= end) return {};
         char c = *p;
@@ -220,6 +224,7 @@ static uint32_t readIndex(const uint8_t* ptr, int componentType)
 
 std::shared_ptr<MeshAsset> GltfImporter::load(const std::string& path)
 {
+    MYTHOS_PROFILE_SCOPE("GltfImporter::load");
     bool isGlb = path.size()>=4 && path.substr(path.size()-4)==".glb";
 
     std::string jsonStr;
@@ -241,6 +246,7 @@ std::shared_ptr<MeshAsset> GltfImporter::load(const std::string& path)
     // Parse JSON
     Parser jparser(jsonStr.data(), jsonStr.size());
     JVal root = jparser.parse();
+    MemoryStats::Tracked dom(MemTag::Json, jsonStr.size() + jparser.nodes * sizeof(JVal));
     if (!root.isObj()) { std::cerr<<"[GltfImporter] Invalid JSON in: "<<path<<"\n"; return nullptr; }
 
     // Resolve directory for external buffer loading
@@ -450,6 +456,7 @@ std::shared_ptr<MeshAsset> GltfImporter::load(const std::string& path)
         std::cout<<", "<<asset->submeshes.size()<<" material groups";
     std::cout<<"\n";
 
+    asset->trackCpuBytes();
     return asset;
 }
 
@@ -0,0 +1,127 @@
+#include "GpuProfiler.h"
+#include <glad/glad.h>
+#include <vector>
+
+namespace GpuProfiler
+{
+
+namespace {
+
+struct Range {
+    const char* name;
+    int         beginQuery;      // indices into Frame::queries
+    int         endQuery;
+    uint32_t    depth;
+};
+
+struct Frame {
+    std::vector<GLuint> queries;   // pooled, grows to the busiest frame
+    int                 used = 0;
+    std::vector<Range>  ranges;
+    int64_t             cpuMinusGpuNs = 0;
+    bool                pending = false;
+};
+
+Frame    s_frames[kFramesInFlight];
+uint64_t s_frameIndex = 0;
+Frame*   s_current    = nullptr;     // nullptr: this frame is not measured
+uint32_t s_depth      = 0;
+bool     s_ready      = false;
+
+int allocQuery(Frame& f)
+{
+    if (f.used == (int)f.queries.size()) {
+        GLuint q = 0;
+        glGenQueries(1, &q);
+        f.queries.push_back(q);
+    }
+    return f.used++;
+}
+
+// Publishes a finished frame's ranges. false if the GPU has not got there yet.
+bool resolve(Frame& f)
+{
+    if (!f.ranges.empty()) {
+        GLint available = 0;
+        glGetQueryObjectiv(f.queries[f.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+    }
+    for (const Range& r : f.ranges) {
+        if (r.endQuery < 0) continue;
+        GLuint64 t0 = 0, t1 = 0;
+        glGetQueryObjectui64v(f.queries[r.beginQuery], GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(f.queries[r.endQuery],   GL_QUERY_RESULT, &t1);
+        Profiler::recordOnLane("GPU", r.name,
+                               (int64_t)t0 + f.cpuMinusGpuNs,
+                               (int64_t)t1 + f.cpuMinusGpuNs, r.depth);
+    }
+    f.pending = false;
+    return true;
+}
+
+} // namespace
+
+void init()
+{
+    s_ready = true;
+}
+
+void shutdown()
+{
+    for (Frame& f : s_frames) {
+        if (!f.queries.empty())
+            glDeleteQueries((GLsizei)f.queries.size(), f.queries.data());
+        f = Frame();
+    }
+    s_current = nullptr;
+    s_ready   = false;
+}
+
+void beginFrame()
+{
+    s_current = nullptr;
+    s_depth   = 0;
+    if (!s_ready) return;
+
+    // Drain everything that has landed, oldest first — the oldest slot is
+    // the one this frame reuses
+    for (int k = kFramesInFlight; k >= 1; --k) {
+        Frame& old = s_frames[(s_frameIndex + kFramesInFlight - k) % kFramesInFlight];
+        if (old.pending) resolve(old);
+    }
+
+    Frame& f = s_frames[s_frameIndex++ % kFramesInFlight];
+    if (f.pending) return;     // GPU too far behind — skip this frame
+    if (!Profiler::enabled()) return;
+
+    f.used = 0;
+    f.ranges.clear();
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    f.cpuMinusGpuNs = Profiler::nowNs() - (int64_t)gpuNow;
+    f.pending       = true;
+    s_current       = &f;
+}
+
+Scope::Scope(const char* name)
+{
+    if (!s_current) return;
+    Frame& f = *s_current;
+    m_slot = (int)f.ranges.size();
+    f.ranges.push_back({ name, allocQuery(f), -1, s_depth++ });
+    glQueryCounter(f.queries[f.ranges.back().beginQuery], GL_TIMESTAMP);
+}
+
+Scope::~Scope()
+{
+    // A frame boundary inside a scope would leave m_slot pointing at a
+    // different frame — scopes never span beginFrame() in practice.
+    if (m_slot < 0 || !s_current) return;
+    Frame& f = *s_current;
+    const int q = allocQuery(f);
+    f.ranges[m_slot].endQuery = q;
+    glQueryCounter(f.queries[q], GL_TIMESTAMP);
+    if (s_depth > 0) --s_depth;
+}
+
+} // namespace GpuProfiler
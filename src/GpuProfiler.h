@@ -0,0 +1,49 @@
+#pragma once
+#include "Profiler.h"
+
+// ============================================================
+// GpuProfiler — GL timer queries onto the profiler's "GPU" lane
+//
+//   { MYTHOS_GPU_SCOPE("Scene"); m_renderer.drawScene(...); }
+//
+// Each scope brackets its commands with two GL_TIMESTAMP queries
+// (glQueryCounter). Unlike GL_TIME_ELAPSED, timestamps may nest, so GPU
+// scopes form the same hierarchy as CPU ones. Queries are read back
+// kFramesInFlight frames later and only once available — never stalling
+// the pipeline; if the GPU is further behind than that, the frame is
+// simply not measured. GPU times are mapped onto the CPU clock with one
+// GL_TIMESTAMP read per frame so both lanes share one timeline.
+//
+// Main thread with the context current. init() after GLAD is loaded.
+// Compiled out together with the CPU markers (MYTHOS_PROFILE=0).
+// ============================================================
+
+namespace GpuProfiler
+{
+    constexpr int kFramesInFlight = 4;
+
+    void init();
+    void shutdown();
+
+    // Once per frame, before the first GPU scope. Reads back finished frames.
+    void beginFrame();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        int m_slot = -1;     // -1 when this frame is not being measured
+    };
+}
+
+#if MYTHOS_PROFILE
+#define MYTHOS_GPU_SCOPE(name)   ::GpuProfiler::Scope MYTHOS_PROF_CAT(gpuScope_, __LINE__)(name)
+#define MYTHOS_GPU_FRAME()       ::GpuProfiler::beginFrame()
+#else
+#define MYTHOS_GPU_SCOPE(name)   ((void)0)
+#define MYTHOS_GPU_FRAME()       ((void)0)
+#endif
@@ -0,0 +1,166 @@
+#include "InputRecorder.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static const char* kMagic = "mythos-input";
+static const int   kVersion = 1;
+
+// ============================================================
+// Record
+// ============================================================
+
+bool InputRecorder::startRecording(const std::string& path, const BenchmarkConfig& startup)
+{
+    m_out.open(path, std::ios::trunc);
+    if (!m_out) {
+        std::cerr << "[InputRecorder] Cannot write: " << path << "\n";
+        return false;
+    }
+    m_out << kMagic << " " << kVersion << "\n";
+    m_out << "size " << startup.width << " " << startup.height << "\n";
+    m_out << "play " << (startup.play ? 1 : 0) << "\n";
+    if (!startup.scenePath.empty())
+        m_out << "scene project " << startup.scenePath << "\n";
+    else if (startup.stressScene)
+        m_out << "scene stress " << startup.stress.objectCount << " " << startup.stress.meshSegments
+              << " " << startup.stress.instancingRatio << " " << startup.stress.socketsPerObject
+              << " " << startup.stress.seed << "\n";
+    else
+        m_out << "scene none\n";
+
+    m_out << std::setprecision(10);
+    m_pending.clear();
+    m_written = 0;
+    std::cout << "[InputRecorder] Recording to " << path << "\n";
+    return true;
+}
+
+void InputRecorder::endFrame(double dt)
+{
+    if (!recording()) return;
+
+    m_out << "f " << dt << "\n";
+    for (const InputEvent& e : m_pending) {
+        switch (e.type) {
+            case InputEventType::MouseButton:
+                m_out << "mb " << e.i[0] << " " << e.i[1] << " " << e.i[2] << "\n"; break;
+            case InputEventType::CursorPos:
+                m_out << "cp " << e.x << " " << e.y << "\n"; break;
+            case InputEventType::Scroll:
+                m_out << "sc " << e.x << " " << e.y << "\n"; break;
+            case InputEventType::Key:
+                m_out << "key " << e.i[0] << " " << e.i[1] << " " << e.i[2] << " " << e.i[3] << "\n"; break;
+            case InputEventType::Char:
+                m_out << "ch " << e.i[0] << "\n"; break;
+            case InputEventType::CursorEnter:
+                m_out << "en " << e.i[0] << "\n"; break;
+            case InputEventType::Focus:
+                m_out << "fo " << e.i[0] << "\n"; break;
+        }
+    }
+    m_pending.clear();
+
+    // Flush now and then so a crashed session still leaves a usable file
+    if (++m_written % 120 == 0) m_out.flush();
+}
+
+void InputRecorder::stopRecording()
+{
+    if (!recording()) return;
+    m_out.close();
+    std::cout << "[InputRecorder] Recorded " << m_written << " frames\n";
+}
+
+// ============================================================
+// Replay
+// ============================================================
+
+bool InputRecorder::load(const std::string& path, BenchmarkConfig& startup)
+{
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "[InputRecorder] Cannot open: " << path << "\n";
+        return false;
+    }
+
+    std::string magic;
+    int version = 0;
+    f >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        std::cerr << "[InputRecorder] Not a version " << kVersion << " recording: " << path << "\n";
+        return false;
+    }
+
+    m_frames.clear();
+    startup.scenePath.clear();
+    startup.stressScene = false;
+
+    std::string line;
+    int lineNo = 1;
+    std::getline(f, line);   // rest of the magic line
+    while (std::getline(f, line)) {
+        ++lineNo;
+        std::istringstream in(line);
+        std::string tag;
+        if (!(in >> tag)) continue;
+
+        InputEvent e;
+        bool ok    = true;
+        bool event = true;
+        if (tag == "f") {
+            Frame fr;
+            ok = (bool)(in >> fr.dt);
+            m_frames.push_back(std::move(fr));
+            event = false;
+        }
+        else if (tag == "size") {
+            ok = (bool)(in >> startup.width >> startup.height);
+            event = false;
+        }
+        else if (tag == "play") {
+            int p = 0;
+            ok = (bool)(in >> p);
+            startup.play = p != 0;
+            event = false;
+        }
+        else if (tag == "scene") {
+            std::string kind;
+            in >> kind;
+            if (kind == "project") {
+                std::getline(in >> std::ws, startup.scenePath);
+                ok = !startup.scenePath.empty();
+            } else if (kind == "stress") {
+                StressSceneParams& st = startup.stress;
+                ok = (bool)(in >> st.objectCount >> st.meshSegments >> st.instancingRatio
+                               >> st.socketsPerObject >> st.seed);
+                startup.stressScene = true;
+            } else {
+                ok = kind == "none";
+            }
+            event = false;
+        }
+        else if (tag == "mb")  { e.type = InputEventType::MouseButton; ok = (bool)(in >> e.i[0] >> e.i[1] >> e.i[2]); }
+        else if (tag == "cp")  { e.type = InputEventType::CursorPos;   ok = (bool)(in >> e.x >> e.y); }
+        else if (tag == "sc")  { e.type = InputEventType::Scroll;      ok = (bool)(in >> e.x >> e.y); }
+        else if (tag == "key") { e.type = InputEventType::Key;         ok = (bool)(in >> e.i[0] >> e.i[1] >> e.i[2] >> e.i[3]); }
+        else if (tag == "ch")  { e.type = InputEventType::Char;        ok = (bool)(in >> e.i[0]); }
+        else if (tag == "en")  { e.type = InputEventType::CursorEnter; ok = (bool)(in >> e.i[0]); }
+        else if (tag == "fo")  { e.type = InputEventType::Focus;       ok = (bool)(in >> e.i[0]); }
+        else ok = false;
+
+        // Events belong to the frame line before them (see endFrame)
+        if (!ok || (event && m_frames.empty())) {
+            std::cerr << "[InputRecorder] " << path << ":" << lineNo << ": bad line: " << line << "\n";
+            return false;
+        }
+        if (event) m_frames.back().events.push_back(e);
+    }
+
+    if (m_frames.empty()) {
+        std::cerr << "[InputRecorder] No frames in " << path << "\n";
+        return false;
+    }
+    std::cout << "[InputRecorder] Loaded " << m_frames.size() << " frames from " << path << "\n";
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "BenchmarkMode.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+// InputRecorder — record an editor session's input, replay it as a benchmark
+//
+//   Mythos --record F [scene options]     record every GLFW input event
+//   Mythos --replay F [--out R] [--warmup N]
+//
+// A recording is a text file: a header with the startup state (window
+// size, play mode, project path or stress-scene parameters), then one
+// "f <dt>" line per drawn frame followed by the events polled for it:
+//
+//   mythos-input 1
+//   size 1280 720
+//   play 0
+//   scene stress 10000 4 0.95 2 1        (or "scene project <path>", "scene none")
+//   f 0.016667
+//   cp 640 360                            cursor pos
+//   mb 0 1 0                              mouse button  button action mods
+//   sc 0 -1                               scroll
+//   key 90 44 1 2                         key  key scancode action mods
+//   ch 97                                 char codepoint
+//   en 1  /  fo 1                         cursor enter / window focus
+//
+// Replay rebuilds the same startup state, then feeds each frame's events to
+// ImGui and App before that frame's update, with the recorded dt as the time
+// step (App and ImGui). Generation is seeded and stepped per frame, so the
+// run repeats the session; BenchmarkMode times every frame and writes its
+// report, with per-frame times, when the recording ends.
+//
+// The ImGui layout file is not used while recording or replaying, so both
+// start from the default layout. Window resizes are not replayed.
+// ============================================================
+
+enum class InputEventType : uint8_t {
+    MouseButton, CursorPos, Scroll, Key, Char, CursorEnter, Focus
+};
+
+struct InputEvent {
+    InputEventType type = InputEventType::CursorPos;
+    int    i[4] = {};            // button/action/mods, key/scancode/action/mods, codepoint, flag
+    double x = 0.0, y = 0.0;     // cursor position or scroll offset
+};
+
+class InputRecorder
+{
+public:
+    struct Frame {
+        double                  dt = 0.0;
+        std::vector<InputEvent> events;   // polled before this frame, in order
+    };
+
+    // ---- Record ----
+    bool startRecording(const std::string& path, const BenchmarkConfig& startup);
+    bool recording() const { return m_out.is_open(); }
+    void record(const InputEvent& e) { if (recording()) m_pending.push_back(e); }
+    void endFrame(double dt);     // writes the events since the last endFrame
+    void stopRecording();
+
+    // ---- Replay ----
+    // Reads the whole file; overwrites the startup fields of `startup`.
+    bool load(const std::string& path, BenchmarkConfig& startup);
+    int          frameCount()     const { return (int)m_frames.size(); }
+    const Frame& frame(int index) const { return m_frames[index]; }
+
+private:
+    std::ofstream           m_out;
+    std::vector<InputEvent> m_pending;
+    int                     m_written = 0;
+
+    std::vector<Frame>      m_frames;
+};
@@ -0,0 +1,121 @@
+#include "MemoryStats.h"
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <ostream>
+
+namespace MemoryStats
+{
+
+namespace {
+
+struct Counters {
+    std::atomic<int64_t> bytes { 0 };
+    std::atomic<int64_t> live  { 0 };
+    std::atomic<int64_t> peak  { 0 };
+};
+
+Counters s_counters[(int)MemTag::Count];
+
+const char* const kNames[(int)MemTag::Count] = {
+    "MeshData", "GpuMesh", "RenderBuffers", "Thumbnails",
+    "MerrellHierarchy", "MerrellRules", "Scene", "UndoHistory", "Json",
+};
+
+const bool kGpu[(int)MemTag::Count] = {
+    false, true, true, true, false, false, false, false, false,
+};
+
+// Plain thread_local integer: constant-initialised, safe to touch from
+// operator new even while a thread is starting up.
+thread_local uint64_t t_allocations = 0;
+std::atomic<bool>     s_hookLinked { false };
+
+} // namespace
+
+const char* tagName(MemTag tag) { return kNames[(int)tag]; }
+bool        isGpu(MemTag tag)   { return kGpu[(int)tag]; }
+
+void add(MemTag tag, int64_t deltaBytes, int64_t deltaLive)
+{
+    Counters& c = s_counters[(int)tag];
+    const int64_t now = c.bytes.fetch_add(deltaBytes, std::memory_order_relaxed) + deltaBytes;
+    if (deltaLive) c.live.fetch_add(deltaLive, std::memory_order_relaxed);
+
+    int64_t peak = c.peak.load(std::memory_order_relaxed);
+    while (now > peak &&
+           !c.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+}
+
+TagStats get(MemTag tag)
+{
+    const Counters& c = s_counters[(int)tag];
+    TagStats s { tag, tagName(tag), isGpu(tag) };
+    s.bytes = c.bytes.load(std::memory_order_relaxed);
+    s.live  = c.live.load(std::memory_order_relaxed);
+    s.peak  = c.peak.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::vector<TagStats> snapshot()
+{
+    std::vector<TagStats> r;
+    r.reserve((size_t)MemTag::Count);
+    for (int t = 0; t < (int)MemTag::Count; ++t) r.push_back(get((MemTag)t));
+    return r;
+}
+
+int64_t totalBytes(bool gpu)
+{
+    int64_t sum = 0;
+    for (int t = 0; t < (int)MemTag::Count; ++t)
+        if (kGpu[t] == gpu) sum += s_counters[t].bytes.load(std::memory_order_relaxed);
+    return sum;
+}
+
+void dump(std::ostream& out)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%-18s %4s %12s %10s %12s\n", "tag", "", "bytes", "live", "peak");
+    out << line;
+    for (const TagStats& s : snapshot()) {
+        snprintf(line, sizeof(line), "%-18s %4s %12lld %10lld %12lld\n", s.name,
+                 s.gpu ? "GPU" : "CPU", (long long)s.bytes, (long long)s.live, (long long)s.peak);
+        out << line;
+    }
+    snprintf(line, sizeof(line), "%-18s %4s %12lld\n%-18s %4s %12lld\n",
+             "total", "CPU", (long long)totalBytes(false),
+             "total", "GPU", (long long)totalBytes(true));
+    out << line;
+}
+
+// ============================================================
+// Tracked
+// ============================================================
+
+void Tracked::set(size_t bytes)
+{
+    if (bytes == m_bytes) return;
+    const int64_t live = (m_bytes == 0) - (bytes == 0);   // +1 on 0→n, -1 on n→0
+    add(m_tag, (int64_t)bytes - (int64_t)m_bytes, live);
+    m_bytes = bytes;
+}
+
+// ============================================================
+// Allocation counting
+// ============================================================
+
+uint64_t threadAllocations()      { return t_allocations; }
+bool     allocCountingAvailable() { return s_hookLinked.load(std::memory_order_relaxed); }
+
+void detail::noteAllocation() { ++t_allocations; }
+void detail::setHookLinked()  { s_hookLinked.store(true, std::memory_order_relaxed); }
+
+NoAllocScope::~NoAllocScope()
+{
+    const uint64_t n = allocations();
+    if (n) std::cerr << "[Memory] " << m_what << ": " << n
+                     << " allocation(s) in an allocation-free section\n";
+}
+
+} // namespace MemoryStats
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// ============================================================
+// MemoryStats — per-subsystem byte / live-allocation counters
+//
+// Answers "what is using the memory" without a custom allocator: each owner
+// of a large block holds a MemoryStats::Tracked handle for its tag and calls
+// set(bytes) whenever the block is created, resized or freed (GL buffers and
+// textures at glBufferData / glTexImage2D time). The handle keeps the tag's
+// totals in step and removes itself on destruction, so counters cannot leak
+// when an owner is dropped.
+//
+//   bytes  — currently accounted      live  — handles holding > 0 bytes
+//   peak   — high-water mark of bytes
+//
+// Counters are relaxed atomics; any thread may update them.
+//
+// Allocation counting: linking src/AllocHook.cpp replaces global operator
+// new and counts allocations per thread (mythos-bench always links it; the
+// editor with -DMYTHOS_COUNT_ALLOCS=ON). MYTHOS_NO_ALLOC_SCOPE("name") marks
+// a hot path that must not allocate and reports when it does.
+// GL-free; part of mythos-core.
+// ============================================================
+
+enum class MemTag : int {
+    MeshData,          // MeshAsset vertices / indices / packed form
+    GpuMesh,           // each asset's range of the geometry arena
+    RenderBuffers,     // unused arena capacity, instance / indirect / uniform buffers
+    Thumbnails,        // atlas pages + thumbnail render target
+    MerrellHierarchy,  // hierarchy nodes (graphs + boundary strings)
+    MerrellRules,      // extracted DPO rules
+    Scene,             // SceneObjects, names, sockets
+    UndoHistory,       // CommandHistory entries and captured state
+    Json,              // DOMs while a JSON document is being read
+    Count
+};
+
+namespace MemoryStats
+{
+    struct TagStats {
+        MemTag      tag;
+        const char* name;
+        bool        gpu;
+        int64_t     bytes = 0;
+        int64_t     live  = 0;
+        int64_t     peak  = 0;
+    };
+
+    const char* tagName(MemTag tag);
+    bool        isGpu(MemTag tag);
+
+    // Raw counter update. Prefer Tracked.
+    void add(MemTag tag, int64_t deltaBytes, int64_t deltaLive);
+
+    TagStats              get(MemTag tag);
+    std::vector<TagStats> snapshot();
+    int64_t               totalBytes(bool gpu);
+
+    // Human-readable table (CLI --mem, editor "Dump to console").
+    void dump(std::ostream& out);
+
+    // ---- RAII accounting handle ----
+    class Tracked
+    {
+    public:
+        explicit Tracked(MemTag tag, size_t bytes = 0) : m_tag(tag) { set(bytes); }
+        ~Tracked() { set(0); }
+
+        Tracked(const Tracked& o) : m_tag(o.m_tag) { set(o.m_bytes); }
+        Tracked(Tracked&& o) noexcept : m_tag(o.m_tag), m_bytes(o.m_bytes) { o.m_bytes = 0; }
+        Tracked& operator=(const Tracked& o) { if (this != &o) set(o.m_bytes); return *this; }
+        Tracked& operator=(Tracked&& o) noexcept {
+            if (this != &o) { set(0); m_tag = o.m_tag; m_bytes = o.m_bytes; o.m_bytes = 0; }
+            return *this;
+        }
+
+        void   set(size_t bytes);
+        size_t bytes() const { return m_bytes; }
+
+    private:
+        MemTag m_tag;
+        size_t m_bytes = 0;
+    };
+
+    // ---- Allocation counting ----
+    // Allocations made by the calling thread since it started. Always 0
+    // unless AllocHook.cpp is linked (allocCountingAvailable()).
+    uint64_t threadAllocations();
+    bool     allocCountingAvailable();
+
+    // Reports to std::cerr if the enclosed code allocated.
+    class NoAllocScope
+    {
+    public:
+        explicit NoAllocScope(const char* what) : m_what(what), m_start(threadAllocations()) {}
+        ~NoAllocScope();
+        uint64_t allocations() const { return threadAllocations() - m_start; }
+    private:
+        const char* m_what;
+        uint64_t    m_start;
+    };
+
+    namespace detail {
+        void noteAllocation();   // called by AllocHook.cpp
+        void setHookLinked();
+    }
+}
+
+#if defined(MYTHOS_COUNT_ALLOCS) && MYTHOS_COUNT_ALLOCS
+#define MYTHOS_NO_ALLOC_SCOPE(name) \
+    ::MemoryStats::NoAllocScope MYTHOS_MEM_CAT(noAlloc_, __LINE__)(name)
+#define MYTHOS_MEM_CAT2(a, b) a##b
+#define MYTHOS_MEM_CAT(a, b)  MYTHOS_MEM_CAT2(a, b)
+#else
+#define MYTHOS_NO_ALLOC_SCOPE(name) ((void)0)
+#endif
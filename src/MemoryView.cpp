@@ -0,0 +1,60 @@
+#include "MemoryView.h"
+#include <imgui.h>
+#include <iostream>
+
+static void bytesText(int64_t bytes)
+{
+    if      (bytes >= (int64_t)1 << 20) ImGui::Text("%.1f MB", bytes / (1024.0 * 1024.0));
+    else if (bytes >= (int64_t)1 << 10) ImGui::Text("%.1f KB", bytes / 1024.0);
+    else                                ImGui::Text("%lld B",  (long long)bytes);
+}
+
+// ============================================================
+// Panel
+// ============================================================
+
+void MemoryView::draw()
+{
+    if (!m_open) return;
+
+    ImGui::SetNextWindowSize({460.f, 320.f}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Memory", &m_open)) { ImGui::End(); return; }
+
+    // ---- Totals ----
+    ImGui::Text("CPU");  ImGui::SameLine(); bytesText(MemoryStats::totalBytes(false));
+    ImGui::SameLine(0.f, 24.f);
+    ImGui::Text("GPU");  ImGui::SameLine(); bytesText(MemoryStats::totalBytes(true));
+    ImGui::SameLine(0.f, 24.f);
+    if (ImGui::Button(" Dump to console "))
+        MemoryStats::dump(std::cout);
+
+    if (MemoryStats::allocCountingAvailable())
+        ImGui::TextDisabled("Main thread allocations: %llu",
+                            (unsigned long long)MemoryStats::threadAllocations());
+    ImGui::Separator();
+
+    // ---- Per-tag table ----
+    const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                  ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("##memtags", 5, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Tag");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableHeadersRow();
+
+        for (const MemoryStats::TagStats& s : MemoryStats::snapshot()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name);
+            ImGui::TableNextColumn(); ImGui::TextDisabled("%s", s.gpu ? "GPU" : "CPU");
+            ImGui::TableNextColumn(); bytesText(s.bytes);
+            ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)s.live);
+            ImGui::TableNextColumn(); bytesText(s.peak);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "MemoryStats.h"
+
+// ============================================================
+// MemoryView — ImGui panel over MemoryStats
+//
+// One row per MemTag (bytes / live handles / peak) with CPU and GPU totals.
+// Counters are read every frame — they are a handful of atomics. Scene and
+// undo figures are estimates refreshed by App on a timer.
+// ============================================================
+
+class MemoryView
+{
+public:
+    void draw();
+
+    bool isOpen()           const { return m_open; }
+    void setOpen(bool open)       { m_open = open; }
+
+private:
+    bool m_open = false;
+};
@@ -1,6 +1,12 @@
 #include "MeshAsset.h"
+#include "MeshCodec.h"
+#include "ContentHash.h"
+#include "ObjImporter.h"
+#include "GltfImporter.h"
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 
 // ---- MeshData --------------------------------------------------------------
 
@@ -14,72 +20,83 @@ void MeshData::computeAABB()
     }
 }
 
-// ---- GpuMesh ---------------------------------------------------------------
+// ---- Residency -------------------------------------------------------------
 
-void GpuMesh::destroy()
+// Same routing as the library / project importers
+static std::shared_ptr<MeshAsset> reimport(const std::string& path)
 {
-    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
-    if (vbo) { glDeleteBuffers(1, &vbo);      vbo = 0; }
-    if (ebo) { glDeleteBuffers(1, &ebo);      ebo = 0; }
-    indexCount = 0;
+    std::string lower = path;
+    for (auto& c : lower) c = (char)tolower((unsigned char)c);
+    auto endsWith = [&](const char* ext) {
+        size_t n = strlen(ext);
+        return lower.size() >= n && lower.compare(lower.size() - n, n, ext) == 0;
+    };
+    if (endsWith(".glb") || endsWith(".gltf"))
+        return GltfImporter::load(path);
+    return ObjImporter::load(path);
 }
 
-// ---- MeshAsset -------------------------------------------------------------
+size_t MeshAsset::cpuBytes() const
+{
+    return data.vertices.capacity() * sizeof(MeshVertex)
+         + data.indices.capacity()  * sizeof(unsigned int)
+         + packed.capacity();
+}
 
-bool MeshAsset::upload()
+size_t MeshAsset::releaseData(MeshResidency policy)
 {
-    if (data.vertices.empty() || data.indices.empty()) {
-        std::cerr << "[MeshAsset] '" << name << "' has no data to upload\n";
-        return false;
+    if (policy == MeshResidency::Keep || !dataResident()) return 0;
+    if (!isLoaded() || data.indices.empty()) return 0;   // CPU copy is the only copy
+
+    const size_t before = cpuBytes();
+    if (policy == MeshResidency::Evict && !sourcePath.empty()) {
+        evicted = true;
+    } else {
+        MeshCodec::encode(data, packed);
+        packed.shrink_to_fit();
     }
-
-    unload();  // free any existing GPU resources
-
-    glGenVertexArrays(1, &gpu.vao);
-    glGenBuffers(1, &gpu.vbo);
-    glGenBuffers(1, &gpu.ebo);
-
-    glBindVertexArray(gpu.vao);
-
-    // Interleaved: pos(3) + normal(3) + uv(2) = 8 floats per vertex
-    glBindBuffer(GL_ARRAY_BUFFER, gpu.vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 (GLsizeiptr)(data.vertices.size() * sizeof(MeshVertex)),
-                 data.vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 (GLsizeiptr)(data.indices.size() * sizeof(unsigned int)),
-                 data.indices.data(), GL_STATIC_DRAW);
-
-    // position  — location 0
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
-                          (void*)offsetof(MeshVertex, pos));
-    glEnableVertexAttribArray(0);
-
-    // normal    — location 1
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
-                          (void*)offsetof(MeshVertex, normal));
-    glEnableVertexAttribArray(1);
-
-    // uv        — location 2
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
-                          (void*)offsetof(MeshVertex, uv));
-    glEnableVertexAttribArray(2);
-
-    glBindVertexArray(0);
-
-    gpu.indexCount = (int)data.indices.size();
-
-    data.computeAABB();
-
-    std::cout << "[MeshAsset] Uploaded '" << name << "': "
-              << data.vertices.size() << " verts, "
-              << data.indices.size()/3 << " tris\n";
-    return true;
+    // Release the storage, not just the size; keep the bounds
+    std::vector<MeshVertex>().swap(data.vertices);
+    std::vector<unsigned int>().swap(data.indices);
+    trackCpuBytes();
+    return before - std::min(before, cpuBytes());
 }
 
-void MeshAsset::unload()
+bool MeshAsset::ensureResident()
 {
-    gpu.destroy();
+    dataAccessed = true;
+    if (dataResident()) return true;
+
+    const glm::vec3 bmin = data.aabbMin, bmax = data.aabbMax;
+    if (!packed.empty()) {
+        if (!MeshCodec::decode(packed.data(), packed.size(), data)) {
+            std::cerr << "[MeshAsset] '" << name << "' packed data is corrupt\n";
+            restoreFailed = true;
+            return false;
+        }
+        std::vector<uint8_t>().swap(packed);
+        trackCpuBytes();
+        return true;
+    }
+
+    // Evicted — the GPU copy is authoritative, so the re-import must match it
+    auto fresh = reimport(sourcePath);
+    bool match = fresh &&
+                 (int)fresh->data.vertices.size() == gpu.vertexCount &&
+                 (int)fresh->data.indices.size()  == gpu.indexCount;
+    if (match && contentHash)
+        match = ContentHash::mesh(fresh->data, submeshes) == contentHash;
+    if (!match) {
+        std::cerr << "[MeshAsset] '" << name << "' could not be restored from "
+                  << sourcePath << " (missing or changed on disk)\n";
+        restoreFailed = true;
+        return false;
+    }
+    data.vertices = std::move(fresh->data.vertices);
+    data.indices  = std::move(fresh->data.indices);
+    data.aabbMin  = bmin;
+    data.aabbMax  = bmax;
+    evicted = false;
+    trackCpuBytes();
+    return true;
 }
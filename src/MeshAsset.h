@@ -1,6 +1,7 @@
 #pragma once
-#include <glad/glad.h>
+#include "MemoryStats.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -27,12 +28,23 @@ struct MeshData {
 };
 
 // ---- GPU-side mesh ---------------------------------------------------------
+// Plain GL object names (GLuint is unsigned int) so this header stays GL-free
+// and can be shared with the headless mythos-core library.
+//
+// Either owns its own VAO/VBO/EBO (renderer helpers such as the fallback
+// cube), or — for every uploaded MeshAsset — is a range of the shared
+// GeometryArena: vao is then the arena's (not owned, vbo/ebo stay 0) and
+// draws offset by baseVertex/firstIndex. destroy() handles both.
 struct GpuMesh
 {
-    GLuint vao        = 0;
-    GLuint vbo        = 0;
-    GLuint ebo        = 0;
-    int    indexCount = 0;
+    unsigned int vao   = 0;
+    unsigned int vbo   = 0;
+    unsigned int ebo   = 0;
+    int    vertexCount = 0;
+    int    indexCount  = 0;
+    int    baseVertex  = 0;       // added to every index (arena ranges)
+    int    firstIndex  = 0;       // in indices, not bytes
+    bool   pooled      = false;   // range of GeometryArena::meshPool()
     void destroy();
 };
 
@@ -46,9 +58,17 @@ struct SubMesh {
     int          indexCount  = 0;
 };
 
+// ---- MeshResidency ---------------------------------------------------------
+// What happens to a MeshAsset's CPU copy once it is on the GPU.
+//   Keep     — data stays as imported (default)
+//   Compress — packed with MeshCodec, inflated on access
+//   Evict    — dropped, re-imported from sourcePath on access (meshes without
+//              a source file are compressed instead)
+enum class MeshResidency { Keep, Compress, Evict };
+
 // ---- MeshAsset -------------------------------------------------------------
 // One named mesh that can be shared by many SceneObjects.
-// Owns both CPU data and the uploaded GpuMesh.
+// Owns both CPU data and its range of the shared GeometryArena (GpuMesh).
 //
 // Sources:
 //   - "cube:<color>"  — procedural placeholder, generated in code
@@ -65,12 +85,47 @@ struct MeshAsset {
 
     bool isLoaded() const { return gpu.vao != 0; }
 
-    // Upload CPU data → GPU. Call after data is filled.
+    // ContentHash::mesh of data + submeshes, set when interned in a
+    // MeshRegistry (0 = not computed). Identical content ⇒ shared asset.
+    uint64_t contentHash = 0;
+
+    // Bumped by every upload() — lets caches keyed on the asset pointer
+    // notice that the contents behind it were replaced.
+    uint32_t revision = 0;
+
+    // Upload CPU data → GPU (into GeometryArena::meshPool() in the editor).
+    // Call after data is filled.
+    // Implemented per backend: MeshAssetGL.cpp (editor) or
+    // MeshAssetHeadless.cpp (mythos-cli, no GL context).
     bool upload();
 
     // Free GPU resources (CPU data kept for re-upload / export)
     void unload();
 
+    // ---- CPU data residency ----
+    // data.aabbMin/aabbMax stay valid in every state. Consumers that read
+    // vertices/indices call ensureResident() first (main thread) — merging,
+    // half-edge building, occlusion, batching.
+    std::vector<uint8_t> packed;           // MeshCodec form while compressed
+    bool evicted      = false;             // data dropped, reload from sourcePath
+    bool dataAccessed = false;             // set by ensureResident(); cleared by residency passes
+    bool restoreFailed = false;            // ensureResident() failed; cleared by upload()
+
+    bool   dataResident() const { return packed.empty() && !evicted; }
+    bool   ensureResident();                          // false if the data cannot be restored
+    size_t releaseData(MeshResidency policy);         // bytes freed; only for uploaded meshes
+    size_t cpuBytes() const;                          // current CPU footprint of data/packed
+    int    triangleCount() const {
+        return dataResident() ? (int)data.indices.size() / 3 : gpu.indexCount / 3;
+    }
+
+    // ---- Memory accounting (MemoryStats) ----
+    // memGpu is set by upload()/unload(); call trackCpuBytes() after data
+    // or packed change size (importers, residency transitions, upload).
+    MemoryStats::Tracked memCpu { MemTag::MeshData };
+    MemoryStats::Tracked memGpu { MemTag::GpuMesh };
+    void trackCpuBytes() { memCpu.set(cpuBytes()); }
+
     ~MeshAsset() { unload(); }
 
     // Non-copyable — owns GPU resources
@@ -0,0 +1,85 @@
+#include "MeshAsset.h"
+#include "GeometryArena.h"
+#include <glad/glad.h>
+#include <iostream>
+
+// ============================================================
+// MeshAsset GL backend — GpuMesh / upload / unload
+//
+// upload() allocates the mesh a range of the Renderer's GeometryArena;
+// there are no per-asset GL buffers.
+//
+// Linked into the editor only. MeshAsset.cpp (CPU data, residency) is part
+// of mythos-core; headless tools link MeshAssetHeadless.cpp instead.
+// ============================================================
+
+// ---- GpuMesh ---------------------------------------------------------------
+
+void GpuMesh::destroy()
+{
+    if (pooled) {
+        // The arena owns the objects; only hand the range back. After
+        // Renderer::shutdown there is no pool and nothing left to return.
+        if (GeometryArena* arena = GeometryArena::meshPool()) {
+            ArenaRange range{ baseVertex, firstIndex, vertexCount, indexCount };
+            arena->release(range);
+        }
+        vao = 0;
+    }
+    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
+    if (vbo) { glDeleteBuffers(1, &vbo);      vbo = 0; }
+    if (ebo) { glDeleteBuffers(1, &ebo);      ebo = 0; }
+    vertexCount = 0;
+    indexCount  = 0;
+    baseVertex  = 0;
+    firstIndex  = 0;
+    pooled      = false;
+}
+
+// ---- MeshAsset -------------------------------------------------------------
+
+bool MeshAsset::upload()
+{
+    if (data.vertices.empty() || data.indices.empty()) {
+        std::cerr << "[MeshAsset] '" << name << "' has no data to upload\n";
+        return false;
+    }
+    GeometryArena* arena = GeometryArena::meshPool();
+    if (!arena) {
+        std::cerr << "[MeshAsset] '" << name << "' uploaded before the renderer was initialised\n";
+        return false;
+    }
+
+    unload();  // return any previous range
+
+    // The arena uses MeshData's interleaved layout: pos(3) + normal(3) + uv(2)
+    ArenaRange range;
+    if (!arena->allocate(data, range)) {
+        std::cerr << "[MeshAsset] '" << name << "' does not fit in the geometry arena\n";
+        return false;
+    }
+    gpu.vao         = arena->vao();
+    gpu.baseVertex  = range.baseVertex;
+    gpu.firstIndex  = range.firstIndex;
+    gpu.vertexCount = range.vertexCount;
+    gpu.indexCount  = range.indexCount;
+    gpu.pooled      = true;
+    ++revision;
+    restoreFailed = false;
+
+    data.computeAABB();
+    trackCpuBytes();
+    memGpu.set(data.vertices.size() * sizeof(MeshVertex) +
+               data.indices.size()  * sizeof(unsigned int));
+
+    std::cout << "[MeshAsset] Uploaded '" << name << "': "
+              << data.vertices.size() << " verts, "
+              << data.indices.size()/3 << " tris\n";
+    return true;
+}
+
+void MeshAsset::unload()
+{
+    gpu.destroy();
+    memGpu.set(0);
+}
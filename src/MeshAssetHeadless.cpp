@@ -0,0 +1,42 @@
+#include "MeshAsset.h"
+#include <iostream>
+
+// ============================================================
+// MeshAsset headless backend — no GL context, no GPU objects
+//
+// Linked by mythos-cli / mythos-bench in place of MeshAssetGL.cpp. upload()
+// keeps its CPU-side contract (validate, compute AABB, bump revision, record
+// counts) so code written against the editor behaves the same; isLoaded()
+// stays false because no VAO ever exists.
+// ============================================================
+
+void GpuMesh::destroy()
+{
+    vao = vbo = ebo = 0;
+    vertexCount = 0;
+    indexCount  = 0;
+    baseVertex  = 0;
+    firstIndex  = 0;
+    pooled      = false;
+}
+
+bool MeshAsset::upload()
+{
+    if (data.vertices.empty() || data.indices.empty()) {
+        std::cerr << "[MeshAsset] '" << name << "' has no data to upload\n";
+        return false;
+    }
+    gpu.vertexCount = (int)data.vertices.size();
+    gpu.indexCount  = (int)data.indices.size();
+    ++revision;
+    restoreFailed = false;
+    data.computeAABB();
+    trackCpuBytes();
+    return true;
+}
+
+void MeshAsset::unload()
+{
+    gpu.destroy();
+    memGpu.set(0);
+}
@@ -0,0 +1,105 @@
+#include "MeshCodec.h"
+#include <cstring>
+
+static constexpr uint32_t kMagic = 0x4B43534D;   // "MSCK"
+static constexpr int      kWords = (int)(sizeof(MeshVertex) / sizeof(uint32_t));
+static_assert(sizeof(MeshVertex) == kWords * sizeof(uint32_t),
+              "MeshVertex must be a whole number of 32-bit words");
+
+// ---- Varints -----------------------------------------------------------------
+
+static inline void putVarint(std::vector<uint8_t>& out, uint32_t v)
+{
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static inline uint32_t zigzag(int32_t v)    { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t  unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// ============================================================
+// Encode / decode
+// ============================================================
+
+void MeshCodec::encode(const MeshData& data, std::vector<uint8_t>& out)
+{
+    const uint32_t nv = (uint32_t)data.vertices.size();
+    const uint32_t ni = (uint32_t)data.indices.size();
+    // Worst case 5 bytes per word; typical is far lower — reserve a guess
+    out.reserve(out.size() + 12 + (size_t)nv * kWords * 2 + (size_t)ni * 2);
+
+    const uint32_t header[3] = { kMagic, nv, ni };
+    const uint8_t* h = (const uint8_t*)header;
+    out.insert(out.end(), h, h + sizeof(header));
+
+    uint32_t prev[kWords] = {};
+    for (const MeshVertex& v : data.vertices) {
+        uint32_t w[kWords];
+        std::memcpy(w, &v, sizeof(MeshVertex));
+        for (int k = 0; k < kWords; ++k) {
+            putVarint(out, w[k] ^ prev[k]);
+            prev[k] = w[k];
+        }
+    }
+
+    uint32_t last = 0;
+    for (unsigned int idx : data.indices) {
+        putVarint(out, zigzag((int32_t)(idx - last)));
+        last = idx;
+    }
+}
+
+bool MeshCodec::decode(const uint8_t* src, size_t size, MeshData& data)
+{
+    data.vertices.clear();
+    data.indices.clear();
+
+    uint32_t header[3];
+    if (!src || size < sizeof(header)) return false;
+    std::memcpy(header, src, sizeof(header));
+    if (header[0] != kMagic) return false;
+
+    const uint8_t* p   = src + sizeof(header);
+    const uint8_t* end = src + size;
+    const uint32_t nv  = header[1], ni = header[2];
+    // Every word / index costs at least one byte — rejects absurd counts
+    if ((size_t)(end - p) < (size_t)nv * kWords + ni) return false;
+
+    data.vertices.resize(nv);
+    uint32_t prev[kWords] = {};
+    for (uint32_t i = 0; i < nv; ++i) {
+        uint32_t w[kWords];
+        for (int k = 0; k < kWords; ++k) {
+            uint32_t x;
+            if (!getVarint(p, end, x)) { data.vertices.clear(); return false; }
+            w[k] = prev[k] = x ^ prev[k];
+        }
+        std::memcpy(&data.vertices[i], w, sizeof(MeshVertex));
+    }
+
+    data.indices.resize(ni);
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < ni; ++i) {
+        uint32_t x;
+        if (!getVarint(p, end, x)) { data.vertices.clear(); data.indices.clear(); return false; }
+        last += (uint32_t)unzigzag(x);
+        data.indices[i] = last;
+    }
+    if (p != end) { data.vertices.clear(); data.indices.clear(); return false; }
+    return true;
+}
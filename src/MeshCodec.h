@@ -0,0 +1,29 @@
+#pragma once
+#include "MeshAsset.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// MeshCodec — fast lossless in-memory packing of MeshData
+//
+// Vertices are treated as 8 × 32-bit words (pos, normal, uv). Each word is
+// XOR-ed with the same word of the previous vertex and written as a LEB128
+// varint: repeated normals/UVs collapse to one byte, neighbouring positions
+// lose their shared sign/exponent bits. Indices are zig-zag deltas from the
+// previous index, also varints — typically 1–2 bytes instead of 4.
+//
+// Bit-exact round trip (floats are never interpreted), single pass each
+// way, no allocations beyond the output. The AABB is not stored — callers
+// keep it. GL-free.
+// ============================================================
+
+namespace MeshCodec
+{
+    // Appends the packed form of data.vertices / data.indices to out.
+    void encode(const MeshData& data, std::vector<uint8_t>& out);
+
+    // Restores vertices/indices (other fields untouched). false on a
+    // corrupt or truncated buffer, leaving data's vectors empty.
+    bool decode(const uint8_t* src, size_t size, MeshData& data);
+}
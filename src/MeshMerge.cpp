@@ -192,6 +192,50 @@ void weld(MeshData& data, std::vector<SubMesh>& submeshes, float epsilon)
     data.computeAABB();
 }
 
+// ============================================================
+// coalesceSubmeshes
+// ============================================================
+
+void coalesceSubmeshes(MeshData& data, std::vector<SubMesh>& submeshes)
+{
+    if (submeshes.size() < 2) return;
+
+    // Group source ranges by colour, keeping first-appearance order
+    std::vector<SubMesh>          groups;
+    std::vector<std::vector<int>> members;
+    for (int i = 0; i < (int)submeshes.size(); ++i) {
+        int g = -1;
+        for (int k = 0; k < (int)groups.size(); ++k)
+            if (glm::distance(groups[k].color, submeshes[i].color) <= 0.01f) { g = k; break; }
+        if (g < 0) {
+            g = (int)groups.size();
+            groups.push_back(submeshes[i]);
+            members.emplace_back();
+        }
+        members[g].push_back(i);
+    }
+
+    if (groups.size() == 1) { submeshes.clear(); return; }
+    if (groups.size() == submeshes.size()) return;   // nothing shares a colour
+
+    std::vector<unsigned int> newIdx;
+    newIdx.reserve(data.indices.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        groups[g].indexOffset = (int)(newIdx.size() * sizeof(unsigned int));
+        for (int i : members[g]) {
+            size_t begin = submeshes[i].indexOffset / sizeof(unsigned int);
+            newIdx.insert(newIdx.end(),
+                          data.indices.begin() + (std::ptrdiff_t)begin,
+                          data.indices.begin() + (std::ptrdiff_t)(begin + submeshes[i].indexCount));
+        }
+        groups[g].indexCount =
+            (int)(newIdx.size() - groups[g].indexOffset / sizeof(unsigned int));
+    }
+
+    data.indices = std::move(newIdx);
+    submeshes    = std::move(groups);
+}
+
 Result mergeAndWeld(const std::vector<const SceneObject*>& objects,
                     const std::string& name, float epsilon)
 {
@@ -14,6 +14,9 @@
 //
 // Welded merge additionally collapses vertices within epsilon world units.
 // Note: welding regenerates indices so per-SubMesh index ranges are recomputed.
+//
+// Source meshes must be resident (MeshAsset::ensureResident) — merge() may
+// run on worker threads, so it never inflates them itself.
 namespace MeshMerge
 {
     // Result of a merge — ready to upload after calling asset->upload().
@@ -34,4 +37,9 @@ namespace MeshMerge
     // Weld an already-merged MeshData in place (recomputes SubMesh ranges).
     void weld(MeshData& data, std::vector<SubMesh>& submeshes,
               float epsilon = 0.001f);
+
+    // Reorder indices so every SubMesh with the same colour (within 0.01)
+    // becomes one contiguous range — one draw per material instead of one
+    // per source object. Collapses to no-submesh when a single colour remains.
+    void coalesceSubmeshes(MeshData& data, std::vector<SubMesh>& submeshes);
 }
@@ -0,0 +1,88 @@
+#include "MeshRegistry.h"
+#include "ContentHash.h"
+#include <cstring>
+#include <iostream>
+
+bool MeshRegistry::sameContent(const MeshAsset& a, const MeshData& data,
+                               const std::vector<SubMesh>& submeshes)
+{
+    const MeshData& d = a.data;
+    if (d.vertices.size()  != data.vertices.size()  ||
+        d.indices.size()   != data.indices.size()   ||
+        a.submeshes.size() != submeshes.size())
+        return false;
+    if (!d.vertices.empty() &&
+        std::memcmp(d.vertices.data(), data.vertices.data(),
+                    d.vertices.size() * sizeof(MeshVertex)) != 0)
+        return false;
+    if (!d.indices.empty() &&
+        std::memcmp(d.indices.data(), data.indices.data(),
+                    d.indices.size() * sizeof(unsigned int)) != 0)
+        return false;
+    for (size_t i = 0; i < submeshes.size(); ++i) {
+        const SubMesh& x = a.submeshes[i];
+        const SubMesh& y = submeshes[i];
+        if (x.color != y.color || x.indexOffset != y.indexOffset ||
+            x.indexCount != y.indexCount)
+            return false;
+    }
+    return true;
+}
+
+std::shared_ptr<MeshAsset> MeshRegistry::find(uint64_t hash, const MeshData& data,
+                                              const std::vector<SubMesh>& submeshes)
+{
+    auto it = m_table.find(hash);
+    if (it == m_table.end()) return nullptr;
+
+    auto& bucket = it->second;
+    std::shared_ptr<MeshAsset> hit;
+    for (size_t i = 0; i < bucket.size(); ) {
+        std::shared_ptr<MeshAsset> a = bucket[i].lock();
+        if (!a) {                                   // expired — prune
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            continue;
+        }
+        // A compressed or evicted candidate has no data to compare against —
+        // restore it first; one that cannot be restored is not shared.
+        if (!hit && a->contentHash == hash && a->ensureResident() &&
+            sameContent(*a, data, submeshes))
+            hit = a;
+        ++i;
+    }
+    if (bucket.empty()) m_table.erase(it);
+    return hit;
+}
+
+std::shared_ptr<MeshAsset> MeshRegistry::intern(const std::shared_ptr<MeshAsset>& asset)
+{
+    if (!asset || asset->data.indices.empty()) return asset;
+    if (asset->contentHash == 0)
+        asset->contentHash = ContentHash::mesh(asset->data, asset->submeshes);
+
+    if (auto existing = find(asset->contentHash, asset->data, asset->submeshes)) {
+        if (existing != asset) {
+            ++m_shared;
+            std::cout << "[MeshRegistry] '" << asset->name << "' shares mesh '"
+                      << existing->name << "'\n";
+        }
+        return existing;
+    }
+    m_table[asset->contentHash].push_back(asset);
+    return asset;
+}
+
+int MeshRegistry::liveCount()
+{
+    int n = 0;
+    for (auto it = m_table.begin(); it != m_table.end(); ) {
+        auto& bucket = it->second;
+        for (size_t i = 0; i < bucket.size(); ) {
+            if (bucket[i].expired()) { bucket[i] = bucket.back(); bucket.pop_back(); }
+            else                     { ++n; ++i; }
+        }
+        it = bucket.empty() ? m_table.erase(it) : std::next(it);
+    }
+    return n;
+}
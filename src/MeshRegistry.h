@@ -0,0 +1,44 @@
+#pragma once
+#include "MeshAsset.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================
+// MeshRegistry — content-addressed intern table for MeshAssets
+//
+// Maps ContentHash::mesh (vertices, indices, submesh ranges/colours) to the
+// live assets with that content. intern() hands back an already registered
+// asset when one has byte-identical content — the same OBJ imported from
+// two paths, the same selection merged twice — so its MeshData and GpuMesh
+// are shared instead of duplicated. A hash match is always confirmed with a
+// full comparison (restoring a compressed or evicted candidate's data
+// first); collisions just register a second asset.
+//
+// Entries are weak: the registry never keeps a mesh alive. Intern before
+// upload() so duplicates never reach the GPU. Main thread only (dropping the
+// last reference to an asset makes GL calls).
+// ============================================================
+
+class MeshRegistry
+{
+public:
+    // Returns the registered asset equal to `asset`, or registers `asset`
+    // (computing its contentHash if 0) and returns it unchanged.
+    std::shared_ptr<MeshAsset> intern(const std::shared_ptr<MeshAsset>& asset);
+
+    // Registered asset with this content, or nullptr. hash = ContentHash::mesh.
+    std::shared_ptr<MeshAsset> find(uint64_t hash, const MeshData& data,
+                                    const std::vector<SubMesh>& submeshes);
+
+    int liveCount();                          // registered assets still alive
+    int sharedCount() const { return m_shared; }   // intern() calls that deduplicated
+
+    static bool sameContent(const MeshAsset& a, const MeshData& data,
+                            const std::vector<SubMesh>& submeshes);
+
+private:
+    std::unordered_map<uint64_t, std::vector<std::weak_ptr<MeshAsset>>> m_table;
+    int m_shared = 0;
+};
@@ -1,4 +1,5 @@
 #include "ObjImporter.h"
+#include "Profiler.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -50,6 +51,7 @@ static ObjIndex parseFaceVert(const std::string& tok)
 
 std::shared_ptr<MeshAsset> ObjImporter::load(const std::string& path)
 {
+    MYTHOS_PROFILE_SCOPE("ObjImporter::load");
     std::ifstream file(path);
     if (!file) {
         std::cerr << "[ObjImporter] Cannot open: " << path << "\n";
@@ -172,6 +174,7 @@ std::shared_ptr<MeshAsset> ObjImporter::load(const std::string& path)
               << (hasNormals ? "" : " [flat normals]")
               << "\n";
 
+    asset->trackCpuBytes();
     return asset;
 }
 
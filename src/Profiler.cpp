@@ -0,0 +1,292 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace Profiler
+{
+
+// ============================================================
+// Buffers
+// ============================================================
+
+namespace {
+
+constexpr uint64_t kRingMask = kEventsPerThread - 1;
+static_assert((kEventsPerThread & kRingMask) == 0, "ring size must be a power of two");
+
+// Single-writer ring. head counts every event ever written; slot = head & mask.
+struct Buffer {
+    std::string              name;                 // guarded by s_mutex
+    uint32_t                 id = 0;
+    bool                     isThread = true;      // false: GPU / named lane
+    std::unique_ptr<Event[]> ring { new Event[kEventsPerThread] };
+    std::atomic<uint64_t>    head { 0 };
+    std::atomic<bool>        retired { false };    // owning thread exited
+    uint32_t                 depth = 0;            // writer-only
+};
+
+std::mutex                           s_mutex;
+std::vector<std::unique_ptr<Buffer>> s_buffers;
+uint32_t                             s_nextId = 1;
+std::atomic<bool>                    s_enabled { true };
+
+std::vector<FrameMark> s_frames;      // ring of kFrameHistory, guarded by s_mutex
+uint64_t               s_frameCount = 0;
+int64_t                s_frameStart = -1;
+
+const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+// Marks the buffer free for reuse when its thread exits
+struct ThreadSlot {
+    Buffer* buf = nullptr;
+    ~ThreadSlot() { if (buf) buf->retired.store(true, std::memory_order_release); }
+};
+thread_local ThreadSlot t_slot;
+
+Buffer* threadBuffer()
+{
+    if (t_slot.buf) return t_slot.buf;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    Buffer* b = nullptr;
+    // Short-lived worker threads (std::async jobs) come and go constantly —
+    // hand an exited thread's buffer to the next one instead of growing.
+    for (auto& p : s_buffers)
+        if (p->isThread && p->retired.load(std::memory_order_acquire)) { b = p.get(); break; }
+    if (!b) {
+        s_buffers.push_back(std::make_unique<Buffer>());
+        b = s_buffers.back().get();
+        b->id = s_nextId++;
+    }
+    b->retired.store(false, std::memory_order_relaxed);
+    b->depth = 0;
+    b->name  = "Thread " + std::to_string(b->id);
+    t_slot.buf = b;
+    return b;
+}
+
+Buffer* laneBuffer(const char* lane)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (auto& p : s_buffers)
+        if (!p->isThread && p->name == lane) return p.get();
+    s_buffers.push_back(std::make_unique<Buffer>());
+    Buffer* b   = s_buffers.back().get();
+    b->id       = s_nextId++;
+    b->isThread = false;
+    b->name     = lane;
+    return b;
+}
+
+inline void push(Buffer* b, const char* name, int64_t s, int64_t e, uint32_t depth)
+{
+    const uint64_t h = b->head.load(std::memory_order_relaxed);
+    Event& ev  = b->ring[h & kRingMask];
+    ev.name    = name;
+    ev.startNs = s;
+    ev.endNs   = e;
+    ev.depth   = depth;
+    b->head.store(h + 1, std::memory_order_release);
+}
+
+// Copies the live part of one ring. Entries the writer may have lapped
+// while we were copying are dropped rather than risk a torn event.
+void copyRing(const Buffer& b, int64_t fromNs, int64_t toNs, std::vector<Event>& out)
+{
+    const uint64_t h1    = b.head.load(std::memory_order_acquire);
+    const uint64_t first = h1 > kEventsPerThread ? h1 - kEventsPerThread : 0;
+
+    std::vector<std::pair<uint64_t, Event>> tmp;
+    tmp.reserve((size_t)(h1 - first));
+    for (uint64_t i = first; i < h1; ++i) {
+        const Event& ev = b.ring[i & kRingMask];
+        if (ev.endNs >= fromNs && ev.startNs <= toNs) tmp.push_back({ i, ev });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t h2   = b.head.load(std::memory_order_relaxed);
+    const uint64_t safe = h2 > kEventsPerThread ? h2 - kEventsPerThread : 0;
+
+    for (auto& [i, ev] : tmp)
+        if (i >= safe) out.push_back(ev);
+}
+
+} // namespace
+
+// ============================================================
+// Recording
+// ============================================================
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+void setEnabled(bool on) { s_enabled.store(on, std::memory_order_relaxed); }
+bool enabled()           { return s_enabled.load(std::memory_order_relaxed); }
+
+void setThreadName(const char* name)
+{
+    Buffer* b = threadBuffer();
+    std::lock_guard<std::mutex> lock(s_mutex);
+    b->name = name;
+}
+
+void beginFrame()
+{
+    const int64_t now = nowNs();
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_frameStart >= 0 && enabled()) {
+        FrameMark m { s_frameCount, s_frameStart, now };
+        if (s_frames.size() < kFrameHistory) s_frames.push_back(m);
+        else s_frames[s_frameCount % kFrameHistory] = m;
+        ++s_frameCount;
+    }
+    s_frameStart = now;
+}
+
+void record(const char* name, int64_t startNs, int64_t endNs, uint32_t depth)
+{
+    push(threadBuffer(), name, startNs, endNs, depth);
+}
+
+void recordOnLane(const char* lane, const char* name,
+                  int64_t startNs, int64_t endNs, uint32_t depth)
+{
+    if (!enabled()) return;
+    push(laneBuffer(lane), name, startNs, endNs, depth);
+}
+
+Scope::Scope(const char* name)
+    : m_name(nullptr), m_start(0), m_depth(0)
+{
+    if (!enabled()) return;
+    m_name  = name;
+    m_depth = threadBuffer()->depth++;
+    m_start = nowNs();
+}
+
+Scope::~Scope()
+{
+    if (!m_name) return;
+    const int64_t end = nowNs();
+    Buffer* b = threadBuffer();
+    if (b->depth > 0) --b->depth;
+    push(b, m_name, m_start, end, m_depth);
+}
+
+// ============================================================
+// Reading
+// ============================================================
+
+void collect(int64_t fromNs, int64_t toNs, std::vector<Lane>& out)
+{
+    out.clear();
+
+    std::vector<const Buffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (auto& p : s_buffers) {
+            buffers.push_back(p.get());
+            out.push_back({ p->name, p->id, {} });
+        }
+    }
+    // Buffers are never freed, so reading them outside the lock is safe
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        copyRing(*buffers[i], fromNs, toNs, out[i].events);
+        std::sort(out[i].events.begin(), out[i].events.end(),
+                  [](const Event& a, const Event& b) {
+                      return a.startNs != b.startNs ? a.startNs < b.startNs
+                                                    : a.depth < b.depth;
+                  });
+    }
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [](const Lane& l) { return l.events.empty(); }),
+              out.end());
+}
+
+std::vector<FrameMark> frames()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::vector<FrameMark> r = s_frames;
+    std::sort(r.begin(), r.end(),
+              [](const FrameMark& a, const FrameMark& b) { return a.index < b.index; });
+    return r;
+}
+
+// ---- Chrome trace export ----
+
+static void writeJsonString(std::ostream& f, const char* s)
+{
+    f << '"';
+    for (; s && *s; ++s) {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') f << '\\' << (char)c;
+        else if (c >= 0x20)        f << (char)c;
+    }
+    f << '"';
+}
+
+bool writeChromeTrace(const std::string& path)
+{
+    std::vector<Lane> lanes;
+    collect(INT64_MIN, INT64_MAX, lanes);
+    const std::vector<FrameMark> marks = frames();
+
+    std::ofstream f(path, std::ios::trunc);
+    if (!f) {
+        std::cerr << "[Profiler] Cannot write: " << path << "\n";
+        return false;
+    }
+
+    // Chrome trace timestamps are microseconds
+    char num[64];
+    auto us = [&](int64_t ns) {
+        snprintf(num, sizeof(num), "%.3f", (double)ns / 1000.0);
+        return num;
+    };
+
+    size_t count = 0;
+    f << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto sep = [&] { f << (first ? "" : ",\n"); first = false; };
+
+    for (const Lane& l : lanes) {
+        sep();
+        f << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << l.id
+          << ",\"args\":{\"name\":";
+        writeJsonString(f, l.name.c_str());
+        f << "}}";
+        sep();
+        f << "{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":1,\"tid\":" << l.id
+          << ",\"args\":{\"sort_index\":" << l.id << "}}";
+
+        for (const Event& e : l.events) {
+            sep();
+            f << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << l.id << ",\"name\":";
+            writeJsonString(f, e.name);
+            f << ",\"ts\":" << us(e.startNs);
+            f << ",\"dur\":" << us(e.endNs - e.startNs) << "}";
+            ++count;
+        }
+    }
+    for (const FrameMark& m : marks) {
+        sep();
+        f << "{\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"name\":\"Frame "
+          << m.index << "\",\"ts\":" << us(m.startNs) << "}";
+    }
+    f << "\n]}\n";
+
+    std::cout << "[Profiler] " << count << " events, " << lanes.size()
+              << " lanes -> " << path << "\n";
+    return (bool)f;
+}
+
+} // namespace Profiler
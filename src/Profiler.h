@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Profiler — scoped CPU markers, per-thread ring buffers
+//
+//   void Foo::bar() {
+//       MYTHOS_PROFILE_FUNCTION();
+//       { MYTHOS_PROFILE_SCOPE("Foo::bar/gather"); ... }
+//   }
+//
+// Each thread writes complete events (name, start, end, depth) into its own
+// fixed-size ring buffer — one writer per buffer, no locks, no allocation on
+// the hot path. The buffer is registered once, under a mutex, the first
+// time a thread records anything; buffers of exited threads are recycled.
+// Readers (ProfilerView, trace export) copy a snapshot and drop any entries
+// the writer may have overwritten while they were copying.
+//
+// Names must be string literals (or otherwise outlive the capture) — only
+// the pointer is stored.
+//
+// App calls beginFrame() once per frame; frame marks let the view cut the
+// timeline into frames. GPU passes are recorded through GpuProfiler onto
+// a lane of their own.
+//
+// Build with MYTHOS_PROFILE=0 (CMake: -DMYTHOS_PROFILE=OFF) and every macro
+// expands to nothing. GL-free; part of mythos-core.
+// ============================================================
+
+#ifndef MYTHOS_PROFILE
+#define MYTHOS_PROFILE 1
+#endif
+
+namespace Profiler
+{
+    struct Event {
+        const char* name    = nullptr;
+        int64_t     startNs = 0;
+        int64_t     endNs   = 0;
+        uint32_t    depth   = 0;   // nesting level on its thread, 0 = outermost
+    };
+
+    struct FrameMark {
+        uint64_t index   = 0;
+        int64_t  startNs = 0;
+        int64_t  endNs   = 0;      // start of the next frame
+    };
+
+    // One lane of the timeline: a thread, or the GPU
+    struct Lane {
+        std::string        name;
+        uint32_t           id = 0;
+        std::vector<Event> events;  // sorted by start time
+    };
+
+    constexpr size_t kEventsPerThread = 1 << 15;
+    constexpr size_t kFrameHistory    = 300;
+
+    // Nanoseconds on the steady clock since the profiler started.
+    int64_t nowNs();
+
+    // Capture on/off at runtime (markers stay compiled in). Default on.
+    void setEnabled(bool on);
+    bool enabled();
+
+    // Names the calling thread's lane ("Main", "Occlusion 2", ...).
+    void setThreadName(const char* name);
+
+    // Main thread, once per frame. Closes the previous frame mark.
+    void beginFrame();
+
+    // Records a finished event on the calling thread. Used by Scope.
+    void record(const char* name, int64_t startNs, int64_t endNs, uint32_t depth);
+
+    // Records onto a named lane that is not a thread (GPU). The caller must
+    // be the only writer for that lane.
+    void recordOnLane(const char* lane, const char* name,
+                      int64_t startNs, int64_t endNs, uint32_t depth);
+
+    // Snapshot of every lane's events overlapping [fromNs, toNs].
+    void collect(int64_t fromNs, int64_t toNs, std::vector<Lane>& out);
+
+    // Completed frames, oldest first (at most kFrameHistory).
+    std::vector<FrameMark> frames();
+
+    // Everything still in the buffers as Chrome trace JSON
+    // (chrome://tracing, Perfetto, speedscope). false if the file can't be written.
+    bool writeChromeTrace(const std::string& path);
+
+    // ---- RAII marker ----
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* m_name;      // nullptr when capture was off at entry
+        int64_t     m_start;
+        uint32_t    m_depth;
+    };
+}
+
+#define MYTHOS_PROF_CAT2(a, b) a##b
+#define MYTHOS_PROF_CAT(a, b)  MYTHOS_PROF_CAT2(a, b)
+
+#if MYTHOS_PROFILE
+#define MYTHOS_PROFILE_SCOPE(name)  ::Profiler::Scope MYTHOS_PROF_CAT(profScope_, __LINE__)(name)
+#define MYTHOS_PROFILE_FUNCTION()   MYTHOS_PROFILE_SCOPE(__func__)
+#define MYTHOS_PROFILE_THREAD(name) ::Profiler::setThreadName(name)
+#define MYTHOS_PROFILE_FRAME()      ::Profiler::beginFrame()
+#else
+#define MYTHOS_PROFILE_SCOPE(name)  ((void)0)
+#define MYTHOS_PROFILE_FUNCTION()   ((void)0)
+#define MYTHOS_PROFILE_THREAD(name) ((void)0)
+#define MYTHOS_PROFILE_FRAME()      ((void)0)
+#endif
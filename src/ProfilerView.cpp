@@ -0,0 +1,279 @@
+#include "ProfilerView.h"
+#include "GpuProfiler.h"
+#include "FileDialog.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+
+// Stable colour per scope name (the pointer is a string literal)
+static ImU32 scopeColor(const char* name)
+{
+    uint32_t h = 2166136261u;
+    for (const char* p = name; p && *p; ++p) { h ^= (unsigned char)*p; h *= 16777619u; }
+    const float hue = (h % 360u) / 360.f;
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB(hue, 0.45f, 0.80f, r, g, b);
+    return ImGui::GetColorU32({ r, g, b, 1.f });
+}
+
+static double ms(int64_t ns) { return (double)ns / 1.0e6; }
+
+// ============================================================
+// Panel
+// ============================================================
+
+void ProfilerView::draw()
+{
+    if (!m_open) return;
+
+    ImGui::SetNextWindowSize({760.f, 480.f}, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", &m_open)) { ImGui::End(); return; }
+
+    // ---- Controls ----
+    bool capturing = Profiler::enabled();
+    if (ImGui::Button(capturing ? " Pause " : " Resume "))
+        Profiler::setEnabled(!capturing);
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Follow", &m_follow) && m_follow) m_zoom = 1.f;
+    ImGui::SameLine();
+    if (ImGui::Button(" Export Trace... ")) {
+        auto p = FileDialog::saveFile("Export Chrome Trace",
+                                      {{"Chrome Trace", "*.json"}}, "json");
+        if (!p.empty()) Profiler::writeChromeTrace(p);
+    }
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Everything still in the capture buffers.\n"
+                          "Open in chrome://tracing or ui.perfetto.dev");
+
+#if !MYTHOS_PROFILE
+    ImGui::TextDisabled("Built with MYTHOS_PROFILE=0 — markers are compiled out.");
+#endif
+
+    // ---- Pick the frame to show ----
+    const std::vector<Profiler::FrameMark> frames = Profiler::frames();
+    if (frames.empty()) {
+        ImGui::TextDisabled("No frames captured yet.");
+        ImGui::End();
+        return;
+    }
+
+    const Profiler::FrameMark* shown = nullptr;
+    if (m_follow) {
+        // Far enough back that the GPU lane has been read back
+        size_t back = std::min<size_t>(GpuProfiler::kFramesInFlight, frames.size() - 1);
+        shown = &frames[frames.size() - 1 - back];
+    } else {
+        for (const auto& f : frames)
+            if (f.index == m_pinned) shown = &f;
+        if (!shown) { m_follow = true; shown = &frames.back(); }   // scrolled out
+    }
+
+    // Following re-collects a few times a second, not every frame
+    const double now = ImGui::GetTime();
+    if (shown->index != m_shownFrame && (!m_follow || now - m_lastRefresh > 0.25)) {
+        refresh(*shown);
+        m_lastRefresh = now;
+    }
+
+    drawFrameStrip(frames);
+    ImGui::Text("Frame %llu  %.2f ms", (unsigned long long)m_frame.index,
+                ms(m_frame.endNs - m_frame.startNs));
+
+    if (ImGui::BeginTabBar("##proftabs")) {
+        if (ImGui::BeginTabItem("Timeline"))   { drawTimeline(); ImGui::EndTabItem(); }
+        if (ImGui::BeginTabItem("Top Scopes")) { drawTotals();   ImGui::EndTabItem(); }
+        ImGui::EndTabBar();
+    }
+
+    ImGui::End();
+}
+
+// ============================================================
+// Snapshot
+// ============================================================
+
+void ProfilerView::refresh(const Profiler::FrameMark& frame)
+{
+    m_frame      = frame;
+    m_shownFrame = frame.index;
+    Profiler::collect(frame.startNs, frame.endNs, m_lanes);
+
+    // Per-name totals; self time = duration minus direct children
+    m_totals.clear();
+    std::unordered_map<std::string, size_t> slot;
+    std::vector<int64_t> childNs;
+    std::vector<size_t>  stack;
+    for (const auto& lane : m_lanes) {
+        const auto& ev = lane.events;
+        childNs.assign(ev.size(), 0);
+        stack.clear();
+        for (size_t i = 0; i < ev.size(); ++i) {
+            while (!stack.empty() && ev[stack.back()].endNs <= ev[i].startNs) stack.pop_back();
+            if (!stack.empty() && ev[stack.back()].depth < ev[i].depth)
+                childNs[stack.back()] += ev[i].endNs - ev[i].startNs;
+            stack.push_back(i);
+        }
+        for (size_t i = 0; i < ev.size(); ++i) {
+            // Clip to the frame so scopes that straddle it aren't overcounted
+            const int64_t s = std::max(ev[i].startNs, frame.startNs);
+            const int64_t e = std::min(ev[i].endNs,   frame.endNs);
+            const std::string key = lane.name + '\x1f' + ev[i].name;
+            auto it = slot.find(key);
+            if (it == slot.end()) {
+                it = slot.emplace(key, m_totals.size()).first;
+                m_totals.push_back({ ev[i].name, lane.name });
+            }
+            ScopeTotal& t = m_totals[it->second];
+            t.totalMs += ms(e - s);
+            t.selfMs  += ms(std::max<int64_t>(ev[i].endNs - ev[i].startNs - childNs[i], 0));
+            t.calls++;
+        }
+    }
+    std::sort(m_totals.begin(), m_totals.end(),
+              [](const ScopeTotal& a, const ScopeTotal& b) { return a.selfMs > b.selfMs; });
+}
+
+// ============================================================
+// Frame strip
+// ============================================================
+
+void ProfilerView::drawFrameStrip(const std::vector<Profiler::FrameMark>& frames)
+{
+    const float  h      = 48.f;
+    const float  w      = ImGui::GetContentRegionAvail().x;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList*  dl     = ImGui::GetWindowDrawList();
+
+    double worst = 1000.0 / 60.0;
+    for (const auto& f : frames) worst = std::max(worst, ms(f.endNs - f.startNs));
+
+    const float barW = w / (float)Profiler::kFrameHistory;
+    dl->AddRectFilled(origin, {origin.x + w, origin.y + h}, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+    // 60 fps reference line
+    const float y60 = origin.y + h - (float)(1000.0 / 60.0 / worst) * h;
+    dl->AddLine({origin.x, y60}, {origin.x + w, y60}, IM_COL32(255, 255, 255, 50));
+
+    const size_t first = Profiler::kFrameHistory - frames.size();
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const double fms = ms(frames[i].endNs - frames[i].startNs);
+        const float  x   = origin.x + (first + i) * barW;
+        const float  bh  = std::max((float)(fms / worst) * h, 1.f);
+        ImU32 col = fms > 1000.0 / 30.0 ? IM_COL32(230, 90, 70, 255)
+                  : fms > 1000.0 / 60.0 ? IM_COL32(230, 190, 70, 255)
+                                        : IM_COL32(90, 190, 110, 255);
+        if (frames[i].index == m_shownFrame) col = IM_COL32(120, 170, 255, 255);
+        dl->AddRectFilled({x, origin.y + h - bh}, {x + std::max(barW - 1.f, 1.f), origin.y + h}, col);
+    }
+
+    ImGui::InvisibleButton("##framestrip", {w, h});
+    if (ImGui::IsItemHovered()) {
+        const int i = (int)((ImGui::GetIO().MousePos.x - origin.x) / barW) - (int)first;
+        if (i >= 0 && i < (int)frames.size()) {
+            ImGui::SetTooltip("Frame %llu: %.2f ms", (unsigned long long)frames[i].index,
+                              ms(frames[i].endNs - frames[i].startNs));
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+                m_follow = false;
+                m_pinned = frames[i].index;
+            }
+        }
+    }
+}
+
+// ============================================================
+// Timeline
+// ============================================================
+
+void ProfilerView::drawTimeline()
+{
+    ImGui::BeginChild("##timeline", {0.f, 0.f}, false, ImGuiWindowFlags_HorizontalScrollbar);
+
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsWindowHovered() && io.KeyCtrl && io.MouseWheel != 0.f)
+        m_zoom = std::clamp(m_zoom * (io.MouseWheel > 0.f ? 1.25f : 0.8f), 1.f, 200.f);
+
+    const float  labelW = 90.f;
+    const float  rowH   = ImGui::GetTextLineHeight() + 4.f;
+    const float  width  = std::max(ImGui::GetContentRegionAvail().x - labelW, 50.f) * m_zoom;
+    const double span   = (double)std::max<int64_t>(m_frame.endNs - m_frame.startNs, 1);
+    ImDrawList*  dl     = ImGui::GetWindowDrawList();
+    const ImVec2 clipLo = ImGui::GetWindowPos();
+    const ImVec2 clipHi = { clipLo.x + ImGui::GetWindowWidth(), clipLo.y + ImGui::GetWindowHeight() };
+
+    for (const auto& lane : m_lanes) {
+        uint32_t maxDepth = 0;
+        for (const auto& e : lane.events) maxDepth = std::max(maxDepth, e.depth);
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const float  laneH  = rowH * (maxDepth + 1);
+        dl->AddText({origin.x, origin.y + 2.f}, ImGui::GetColorU32(ImGuiCol_TextDisabled),
+                    lane.name.c_str());
+
+        const float x0 = origin.x + labelW;
+        for (const auto& e : lane.events) {
+            float a = x0 + (float)((e.startNs - m_frame.startNs) / span) * width;
+            float b = x0 + (float)((e.endNs   - m_frame.startNs) / span) * width;
+            a = std::max(a, x0);
+            b = std::min(b, x0 + width);
+            if (b < clipLo.x || a > clipHi.x || b - a < 0.5f) continue;
+            b = std::max(b, a + 1.f);
+
+            const float  y  = origin.y + e.depth * rowH;
+            const ImVec2 lo = {a, y}, hi = {b, y + rowH - 1.f};
+            dl->AddRectFilled(lo, hi, scopeColor(e.name));
+
+            const double dur = ms(e.endNs - e.startNs);
+            if (b - a > 30.f) {
+                char label[96];
+                snprintf(label, sizeof(label), "%s %.2f", e.name, dur);
+                dl->PushClipRect(lo, hi, true);
+                dl->AddText({a + 3.f, y + 2.f}, IM_COL32(20, 20, 20, 255), label);
+                dl->PopClipRect();
+            }
+            if (ImGui::IsMouseHoveringRect(lo, hi))
+                ImGui::SetTooltip("%s\n%.3f ms  (%s)", e.name, dur, lane.name.c_str());
+        }
+
+        ImGui::Dummy({labelW + width, laneH});
+        ImGui::Separator();
+    }
+    if (m_lanes.empty())
+        ImGui::TextDisabled("Nothing recorded in this frame.");
+
+    ImGui::EndChild();
+}
+
+// ============================================================
+// Top scopes
+// ============================================================
+
+void ProfilerView::drawTotals()
+{
+    const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                  ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("##totals", 5, flags)) return;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Lane");
+    ImGui::TableSetupColumn("Self ms");
+    ImGui::TableSetupColumn("Total ms");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableHeadersRow();
+
+    ImGuiListClipper clipper;
+    clipper.Begin((int)m_totals.size());
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const ScopeTotal& t = m_totals[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(t.name);
+            ImGui::TableNextColumn(); ImGui::TextDisabled("%s", t.lane.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", t.selfMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", t.totalMs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", t.calls);
+        }
+    }
+    ImGui::EndTable();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Profiler.h"
+#include <string>
+#include <vector>
+
+// ============================================================
+// ProfilerView — ImGui panel over Profiler / GpuProfiler data
+//
+//   frame strip : last Profiler::kFrameHistory frame times; click a bar to
+//                 pin that frame, "Follow" returns to the live one
+//   timeline    : one lane per thread plus the GPU lane, nested scopes
+//                 stacked by depth (flame-graph layout); Ctrl+wheel zooms
+//   top scopes  : per-name totals over the shown frame
+//
+// Follow mode shows the frame GpuProfiler::kFramesInFlight back so its GPU
+// lane has been read back. Pause stops capture so a frame can be studied.
+// ============================================================
+
+class ProfilerView
+{
+public:
+    void draw();
+
+    bool isOpen()           const { return m_open; }
+    void setOpen(bool open)       { m_open = open; }
+
+private:
+    bool     m_open   = false;
+    bool     m_follow = true;
+    uint64_t m_pinned = 0;          // frame index when !m_follow
+    float    m_zoom   = 1.f;
+    double   m_lastRefresh = 0.0;
+
+    // Snapshot of the shown frame, refreshed when the frame changes
+    uint64_t                       m_shownFrame = ~0ull;
+    Profiler::FrameMark            m_frame;
+    std::vector<Profiler::Lane>    m_lanes;
+
+    struct ScopeTotal {
+        const char* name;
+        std::string lane;
+        double      totalMs = 0.0;
+        double      selfMs  = 0.0;
+        int         calls   = 0;
+    };
+    std::vector<ScopeTotal> m_totals;
+
+    void refresh(const Profiler::FrameMark& frame);
+    void drawFrameStrip(const std::vector<Profiler::FrameMark>& frames);
+    void drawTimeline();
+    void drawTotals();
+};
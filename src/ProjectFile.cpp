@@ -1,6 +1,7 @@
 #include "ProjectFile.h"
 #include "ObjImporter.h"
 #include "GltfImporter.h"
+#include "MemoryStats.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -92,6 +93,7 @@ bool ProjectFile::save(const std::string& path,
         f << "      \"scale\": "    << vec3Json(o.scale)             << ",\n";
         f << "      \"color\": "    << vec3Json(o.color)             << ",\n";
         f << "      \"gridCell\": " << vec2iJson(o.gridCell)         << ",\n";
+        f << "      \"onGrid\": "   << (o.onGrid  ? "true" : "false") << ",\n";
         f << "      \"visible\": "  << (o.visible ? "true" : "false") << ",\n";
 
         // Mesh source — empty string for procedural cubes
@@ -168,9 +170,11 @@ struct JV {
 
 struct JP {
     const char* p; const char* end;
+    size_t nodes=0;   // values parsed (MemoryStats estimate)
     JP(const char* d,size_t l):p(d),end(d+l){}
     void ws(){while(p<end&&(*p==' '||*p=='\t'||*p=='\n'||*p=='\r'))++p;}
     JV parse(){
+        ++nodes;
         ws(); if(p>=end) return {};
         char c=*p;
         if(c=='{') return pObj();
@@ -258,6 +262,7 @@ bool ProjectFile::load(const std::string& path,
 
     JP parser(json.data(), json.size());
     JV root = parser.parse();
+    MemoryStats::Tracked dom(MemTag::Json, json.size() + parser.nodes * sizeof(JV));
     if (root.type != JV::Obj) {
         s_error = "Invalid JSON in: " + path;
         std::cerr << "[ProjectFile] " << s_error << "\n";
@@ -290,10 +295,12 @@ bool ProjectFile::load(const std::string& path,
     grammar.stopGenerating();
     scene.clear();
 
-    // Cache of already-loaded mesh assets so we don't re-import duplicates
+    // Cache of already-loaded mesh assets so we don't re-import duplicates.
+    // Different paths with identical content are shared via the registry.
     std::map<std::string, std::shared_ptr<MeshAsset>> meshCache;
 
     const JV& objs = root["objects"];
+    scene.reserve(objs.size());
     int loaded  = 0;
     int maxId   = 0;
 
@@ -315,6 +322,13 @@ bool ProjectFile::load(const std::string& path,
 
         // Restore mesh
         std::string meshSrc   = jo["meshSource"].str();
+
+        // Files from before onGrid filed every object in the grid; keep
+        // that for procedural pieces and anything away from (0,0)
+        const JV& onGrid = jo["onGrid"];
+        o.onGrid = onGrid.type == JV::Bool
+                 ? onGrid.boolean()
+                 : (meshSrc.empty() || o.gridCell != glm::ivec2(0, 0));
         std::string meshName  = jo["meshName"].str();
         glm::vec3   meshColor = jo["meshColor"].size() >= 3
                               ? readVec3(jo["meshColor"])
@@ -327,7 +341,8 @@ bool ProjectFile::load(const std::string& path,
                 o.mesh = it->second;
             } else {
                 auto asset = importMeshFile(meshSrc);
-                if (asset && asset->upload()) {
+                if (asset) asset = meshLib.registry().intern(asset);
+                if (asset && (asset->isLoaded() || asset->upload())) {
                     meshCache[meshSrc] = asset;
                     o.mesh = asset;
                 } else {
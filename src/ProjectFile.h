@@ -10,7 +10,7 @@
 // What is saved:
 //   - Camera transform (target, yaw, pitch, dist)
 //   - Grammar settings (seed, min/max prim, hardcoded flag)
-//   - Scene objects (transform, primId, mesh source path, color, sockets, gridCell)
+//   - Scene objects (transform, primId, mesh source path, color, sockets, gridCell/onGrid)
 //
 // What is NOT saved (has its own persistence):
 //   - Asset library (editor_assets.json, managed by AssetLibrary)
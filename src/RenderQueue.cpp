@@ -0,0 +1,71 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cstring>
+
+// ============================================================
+// RenderKey
+// ============================================================
+
+uint64_t RenderKey::make(uint32_t pass, uint32_t shader, uint32_t mesh,
+                         uint32_t material, float depth01)
+{
+    const uint64_t depthMax = (1ull << kDepthBits) - 1;
+    float d = std::min(std::max(depth01, 0.f), 1.f);
+    uint64_t depth = (uint64_t)(d * (float)depthMax);
+
+    // Clamped rather than masked: an overflowing id lands in one shared top
+    // bucket instead of wrapping onto a small, real one
+    mesh     = std::min(mesh,     (1u << kMeshBits)     - 1);
+    material = std::min(material, (1u << kMaterialBits) - 1);
+
+    uint64_t key = 0;
+    key |= (uint64_t)(pass     & 0xF)                          << 60;
+    key |= (uint64_t)(shader   & ((1u << kShaderBits)   - 1))  << 52;
+    key |= (uint64_t)mesh                                      << 32;
+    key |= (uint64_t)material                                  << kDepthBits;
+    key |= depth;
+    return key;
+}
+
+// ============================================================
+// RenderQueue
+// ============================================================
+
+void RenderQueue::sort()
+{
+    const size_t n = m_packets.size();
+    if (n < 2) return;
+
+    // Small queues: comparison sort is cheaper than eight histograms
+    if (n < 256) {
+        std::stable_sort(m_packets.begin(), m_packets.end(),
+            [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+        return;
+    }
+
+    // One pass builds all eight byte histograms
+    static thread_local uint32_t hist[8][256];
+    std::memset(hist, 0, sizeof(hist));
+    for (const DrawPacket& p : m_packets)
+        for (int d = 0; d < 8; ++d)
+            ++hist[d][(p.key >> (d * 8)) & 0xFF];
+
+    m_scratch.resize(n);
+    DrawPacket* src = m_packets.data();
+    DrawPacket* dst = m_scratch.data();
+
+    for (int d = 0; d < 8; ++d) {
+        uint32_t* h = hist[d];
+        // Every key has the same byte here — the pass would be a no-op
+        if (h[(src[0].key >> (d * 8)) & 0xFF] == n) continue;
+
+        uint32_t sum = 0;
+        for (int b = 0; b < 256; ++b) { uint32_t c = h[b]; h[b] = sum; sum += c; }
+        for (size_t i = 0; i < n; ++i)
+            dst[h[(src[i].key >> (d * 8)) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != m_packets.data())
+        m_packets.swap(m_scratch);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// RenderQueue — sortable draw packets + redundant-state filtering
+//
+// A frame's draws are pushed as (64-bit key, item index) packets, sorted
+// once, then walked in order. The key packs everything that decides GL
+// state so that sorting groups identical state together:
+//
+//   bits 63..60  pass      opaque first, overlays later
+//   bits 59..52  shader    program slot
+//   bits 51..32  mesh      dense per-frame mesh slot
+//   bits 31..20  material  submesh / colour group (0 = whole mesh)
+//   bits 19..0   depth     quantised view distance, front-to-back
+//
+// Consecutive packets that differ only in depth share all state and can be
+// collapsed into one instanced draw by the submitter. Mesh and material ids
+// past their field width share its top value, so the submitter must also
+// compare the draws it collapses (a mesh with 4095+ submeshes, more than a
+// million meshes in a frame).
+// ============================================================
+
+namespace RenderKey
+{
+    enum Pass : uint32_t { Opaque = 0, Overlay = 8 };
+
+    constexpr int kDepthBits    = 20;
+    constexpr int kMaterialBits = 12;
+    constexpr int kMeshBits     = 20;
+    constexpr int kShaderBits   = 8;
+
+    // depth01: 0 = near plane, 1 = far; clamped. mesh / material are
+    // clamped to their fields' top value.
+    uint64_t make(uint32_t pass, uint32_t shader, uint32_t mesh,
+                  uint32_t material, float depth01);
+
+    // Everything above the depth field — equal state means same draw.
+    inline uint64_t stateBits(uint64_t key) { return key >> kDepthBits; }
+}
+
+struct DrawPacket
+{
+    uint64_t key;
+    uint32_t item;   // index into the caller's per-draw arrays
+    uint32_t pad = 0;
+};
+
+class RenderQueue
+{
+public:
+    void clear()                { m_packets.clear(); }
+    void reserve(size_t n)      { m_packets.reserve(n); m_scratch.reserve(n); }
+    void push(uint64_t key, uint32_t item) { m_packets.push_back({key, item}); }
+
+    // Stable LSD radix sort on the key (byte digits). Digits that are the
+    // same across every packet — typically pass and shader — are skipped.
+    void sort();
+
+    const std::vector<DrawPacket>& packets() const { return m_packets; }
+    size_t size() const { return m_packets.size(); }
+
+private:
+    std::vector<DrawPacket> m_packets;
+    std::vector<DrawPacket> m_scratch;
+};
+
+// ============================================================
+// GLStateCache — skip binds that would not change anything
+//
+// Only tracks what the renderer toggles per draw. Anything else may touch
+// GL state between frames (ImGui, the thumbnail renderer), so the cache is
+// invalidated at the start of each frame and reset to 0 at the end.
+// ============================================================
+
+class GLStateCache
+{
+public:
+    void useProgram(GLuint prog)
+    {
+        if (prog == m_program) return;
+        glUseProgram(prog);
+        m_program = prog;
+    }
+    void bindVertexArray(GLuint vao)
+    {
+        if (vao == m_vao) return;
+        glBindVertexArray(vao);
+        m_vao = vao;
+    }
+    void invalidate() { m_program = ~0u; m_vao = ~0u; }
+    void reset()      { useProgram(0); bindVertexArray(0); }
+
+private:
+    GLuint m_program = ~0u;
+    GLuint m_vao     = ~0u;
+};
@@ -1,22 +1,36 @@
 #include "Renderer.h"
+#include "GpuProfiler.h"
+#include "ShaderCache.h"
 #include "SceneObject.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
 
 // ============================================================
 // Shaders embedded as string literals — no file path needed
 // ============================================================
 
-static const char* MESH_VERT = R"GLSL(
-#version 330 core
+// Per-frame camera/light block shared by every scene shader. Uploaded once
+// in beginFrame(); layout must match Renderer::FrameData (std140).
+#define FRAME_BLOCK_GLSL                        \
+    "layout(std140) uniform FrameData {\n"      \
+    "    mat4 uView;\n"                         \
+    "    mat4 uProjection;\n"                   \
+    "    mat4 uViewProj;\n"                     \
+    "    mat4 uInvViewProj;\n"                  \
+    "    vec4 uLightPos;\n"                     \
+    "    vec4 uViewPos;\n"                      \
+    "};\n"
+
+static const char* MESH_VERT = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 uniform mat3 uNormalMatrix;
 out vec3 vNormal;
 out vec3 vFragPos;
@@ -25,25 +39,22 @@ void main()
     vec4 worldPos = uModel * vec4(aPos, 1.0);
     vFragPos      = worldPos.xyz;
     vNormal       = uNormalMatrix * aNormal;
-    gl_Position   = uProjection * uView * worldPos;
+    gl_Position   = uViewProj * worldPos;
 }
 )GLSL";
 
-static const char* MESH_FRAG = R"GLSL(
-#version 330 core
+static const char* MESH_FRAG = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
 in vec3 vNormal;
 in vec3 vFragPos;
 uniform vec3 uColor;
-uniform vec3 uLightPos;
-uniform vec3 uViewPos;
 out vec4 FragColor;
 void main()
 {
     vec3 norm     = normalize(vNormal);
-    vec3 lightDir = normalize(uLightPos - vFragPos);
+    vec3 lightDir = normalize(uLightPos.xyz - vFragPos);
     float ambient = 0.25;
     float diff    = max(dot(norm, lightDir), 0.0);
-    vec3  viewDir = normalize(uViewPos - vFragPos);
+    vec3  viewDir = normalize(uViewPos.xyz - vFragPos);
     vec3  halfDir = normalize(lightDir + viewDir);
     float spec    = pow(max(dot(norm, halfDir), 0.0), 32.0) * 0.4;
     vec3 result = (ambient + diff + spec) * uColor;
@@ -51,23 +62,65 @@ void main()
 }
 )GLSL";
 
+// ---- Instanced variant of the mesh shader ----
+// Model matrix, normal matrix and colour arrive as per-instance attributes
+// (divisor 1) so a whole bucket of objects shares one draw call. Lighting
+// matches MESH_FRAG exactly.
+
+static const char* MESH_INST_VERT = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
+layout(location = 0)  in vec3 aPos;
+layout(location = 1)  in vec3 aNormal;
+layout(location = 3)  in mat4 iModel;
+layout(location = 7)  in vec3 iNormal0;
+layout(location = 8)  in vec3 iNormal1;
+layout(location = 9)  in vec3 iNormal2;
+layout(location = 10) in vec3 iColor;
+out vec3 vNormal;
+out vec3 vFragPos;
+out vec3 vColor;
+void main()
+{
+    vec4 worldPos = iModel * vec4(aPos, 1.0);
+    vFragPos      = worldPos.xyz;
+    vNormal       = mat3(iNormal0, iNormal1, iNormal2) * aNormal;
+    vColor        = iColor;
+    gl_Position   = uViewProj * worldPos;
+}
+)GLSL";
+
+static const char* MESH_INST_FRAG = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
+in vec3 vNormal;
+in vec3 vFragPos;
+in vec3 vColor;
+out vec4 FragColor;
+void main()
+{
+    vec3 norm     = normalize(vNormal);
+    vec3 lightDir = normalize(uLightPos.xyz - vFragPos);
+    float ambient = 0.25;
+    float diff    = max(dot(norm, lightDir), 0.0);
+    vec3  viewDir = normalize(uViewPos.xyz - vFragPos);
+    vec3  halfDir = normalize(lightDir + viewDir);
+    float spec    = pow(max(dot(norm, halfDir), 0.0), 32.0) * 0.4;
+    vec3 result = (ambient + diff + spec) * vColor;
+    FragColor   = vec4(result, 1.0);
+}
+)GLSL";
+
 // ---- UE5-style infinite procedural grid ----
 // Renders a giant flat quad; the fragment shader reconstructs world XZ position
 // and draws multi-level grid lines with distance fade, axis colouring, and
 // adaptive LOD that matches the camera zoom level.
 
-static const char* GRID_VERT = R"GLSL(
-#version 330 core
+static const char* GRID_VERT = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
 layout(location = 0) in vec2 aPos;
 
 out vec3 vNear;
 out vec3 vFar;
 
-uniform mat4 uInvVP;
-
 vec3 unproject(vec2 xy, float z)
 {
-    vec4 h = uInvVP * vec4(xy, z, 1.0);
+    vec4 h = uInvViewProj * vec4(xy, z, 1.0);
     return h.xyz / h.w;
 }
 
@@ -79,16 +132,14 @@ void main()
 }
 )GLSL";
 
-static const char* GRID_FRAG = R"GLSL(
-#version 330 core
+static const char* GRID_FRAG = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
 in vec3 vNear;
 in vec3 vFar;
 
 out vec4 FragColor;
 
 uniform float uCamDist;
-uniform vec3  uCamPos;
-uniform mat4  uVP;      // proj * view — needed to compute true fragment depth
+// uViewProj (frame block) is needed to compute true fragment depth
 
 // ---- noise -----------------------------------------------------------------
 
@@ -139,7 +190,7 @@ void main()
     vec2 p   = hit.xz;
 
     // Write the true depth of the grid plane hit so geometry properly occludes it.
-    vec4 clip = uVP * vec4(hit, 1.0);
+    vec4 clip = uViewProj * vec4(hit, 1.0);
     gl_FragDepth = (clip.z / clip.w) * 0.5 + 0.5;
 
     // --- LOD ----------------------------------------------------------------
@@ -164,7 +215,7 @@ void main()
     float axisZ = smoothstep(fwidth(p.x) * 2.0, 0.0, abs(p.x));
 
     // --- radial fade --------------------------------------------------------
-    float dist2cam = length(p - uCamPos.xz);
+    float dist2cam = length(p - uViewPos.xz);
     float fade     = 1.0 - smoothstep(uCamDist * 1.5, uCamDist * 7.0, dist2cam);
     if (fade < 0.001) discard;
 
@@ -247,15 +298,12 @@ void main()
 )GLSL";
 
 
-static const char* GHOST_VERT = R"GLSL(
-#version 330 core
+static const char* GHOST_VERT = "#version 330 core\n" FRAME_BLOCK_GLSL R"GLSL(
 layout(location = 0) in vec3 aPos;
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 void main()
 {
-    gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
+    gl_Position = uViewProj * uModel * vec4(aPos, 1.0);
 }
 )GLSL";
 
@@ -269,41 +317,17 @@ void main()
 }
 )GLSL";
 // ============================================================
-// Shader compiler
+// Shader programs
 // ============================================================
 
-static GLuint compileShader(GLenum type, const char* src, const char* name)
-{
-    GLuint id = glCreateShader(type);
-    glShaderSource(id, 1, &src, nullptr);
-    glCompileShader(id);
-    GLint ok;
-    glGetShaderiv(id, GL_COMPILE_STATUS, &ok);
-    if (!ok) {
-        char log[512];
-        glGetShaderInfoLog(id, 512, nullptr, log);
-        std::cerr << "[Shader] Compile error in " << name << ":\n" << log << "\n";
-    }
-    return id;
-}
-
 static GLuint buildProgram(const char* vertSrc, const char* fragSrc, const char* name)
 {
-    GLuint vert = compileShader(GL_VERTEX_SHADER,   vertSrc, name);
-    GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSrc, name);
-    GLuint prog = glCreateProgram();
-    glAttachShader(prog, vert);
-    glAttachShader(prog, frag);
-    glLinkProgram(prog);
-    GLint ok;
-    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
-    if (!ok) {
-        char log[512];
-        glGetProgramInfoLog(prog, 512, nullptr, log);
-        std::cerr << "[Shader] Link error (" << name << "): " << log << "\n";
-    }
-    glDeleteShader(vert);
-    glDeleteShader(frag);
+    GLuint prog = ShaderCache::buildProgram(vertSrc, fragSrc, name);
+
+    // Every scene shader shares the per-frame block at a fixed binding point
+    GLuint block = glGetUniformBlockIndex(prog, "FrameData");
+    if (block != GL_INVALID_INDEX)
+        glUniformBlockBinding(prog, block, 0);
     return prog;
 }
 
@@ -325,7 +349,7 @@ glm::mat4 Camera::viewMatrix() const
 
 glm::mat4 Camera::projMatrix(float aspect) const
 {
-    return glm::perspective(glm::radians(45.f), aspect, 0.01f, 500.f);
+    return glm::perspective(glm::radians(kFovY), aspect, kNear, kFar);
 }
 
 void Camera::orbit(float dYaw, float dPitch)
@@ -388,16 +412,49 @@ bool Renderer::init()
     m_meshShader  = buildProgram(MESH_VERT,  MESH_FRAG,  "mesh");
     m_gridShader  = buildProgram(GRID_VERT,  GRID_FRAG,  "grid");
     m_ghostShader = buildProgram(GHOST_VERT, GHOST_FRAG, "ghost");
+    m_instShader  = buildProgram(MESH_INST_VERT, MESH_INST_FRAG, "mesh_instanced");
 
-    if (!m_meshShader || !m_gridShader || !m_ghostShader) {
+    if (!m_meshShader || !m_gridShader || !m_ghostShader || !m_instShader) {
         std::cerr << "[Renderer] Shader build failed\n";
         return false;
     }
 
+    if (!m_arena.init()) {
+        std::cerr << "[Renderer] Geometry arena init failed\n";
+        return false;
+    }
+    GeometryArena::setMeshPool(&m_arena);
+
     buildCubeMesh();
     buildWireEdges();
     buildGrid();
 
+    // Uniform locations never change after link — look them up once
+    m_meshLoc.model        = glGetUniformLocation(m_meshShader,  "uModel");
+    m_meshLoc.normalMatrix = glGetUniformLocation(m_meshShader,  "uNormalMatrix");
+    m_meshLoc.color        = glGetUniformLocation(m_meshShader,  "uColor");
+    m_ghostLoc.model       = glGetUniformLocation(m_ghostShader, "uModel");
+    m_ghostLoc.color       = glGetUniformLocation(m_ghostShader, "uColor");
+    m_gridLoc.camDist      = glGetUniformLocation(m_gridShader,  "uCamDist");
+
+    // Camera + light for the whole frame, shared by all programs
+    glGenBuffers(1, &m_frameUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glGenBuffers(1, &m_instanceVBO);
+    glGenBuffers(1, &m_indirectBuf);
+
+    // Multi-draw indirect needs a 4.3 context at runtime, and a loader that
+    // was generated with 4.3 entry points at compile time.
+#ifdef GL_VERSION_4_3
+    m_useMultiDraw = GLAD_GL_VERSION_4_3 != 0;
+#endif
+    std::cout << "[Renderer] Scene submission: "
+              << (m_useMultiDraw ? "glMultiDrawElementsIndirect"
+                                 : "instanced base-vertex loop") << "\n";
+
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
@@ -414,76 +471,90 @@ void Renderer::shutdown()
     if (m_meshShader)  { glDeleteProgram(m_meshShader);  m_meshShader  = 0; }
     if (m_gridShader)  { glDeleteProgram(m_gridShader);  m_gridShader  = 0; }
     if (m_ghostShader) { glDeleteProgram(m_ghostShader); m_ghostShader = 0; }
+    if (m_instShader)  { glDeleteProgram(m_instShader);  m_instShader  = 0; }
+    if (m_instanceVBO) { glDeleteBuffers(1, &m_instanceVBO); m_instanceVBO = 0; }
+    if (m_indirectBuf) { glDeleteBuffers(1, &m_indirectBuf); m_indirectBuf = 0; }
+    if (m_frameUBO)    { glDeleteBuffers(1, &m_frameUBO);    m_frameUBO    = 0; }
+    m_instanceVBOCap = 0;
+    m_indirectCap    = 0;
+    m_bufferMem.set(0);
+    // Assets still holding ranges just drop them when they are destroyed
+    GeometryArena::setMeshPool(nullptr);
+    m_cubeRange = ArenaRange{};
+    m_arena.shutdown();
     m_wireEdges.destroy();
 }
 
-void Renderer::beginFrame(int w, int h)
+void Renderer::beginFrame(const Camera& cam, int w, int h)
 {
     glViewport(0, 0, w, h);
     glClearColor(0.10f, 0.11f, 0.14f, 1.f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
 
-void Renderer::endFrame() {}
+    // View/projection are computed once here instead of once per draw
+    float aspect         = h > 0 ? (float)w / (float)h : 1.f;
+    m_frame.view         = cam.viewMatrix();
+    m_frame.proj         = cam.projMatrix(aspect);
+    m_frame.viewProj     = m_frame.proj * m_frame.view;
+    m_frame.invViewProj  = glm::inverse(m_frame.viewProj);
+    m_frame.lightPos     = glm::vec4(8.f, 15.f, 10.f, 1.f);
+    m_frame.viewPos      = glm::vec4(cam.position(), 1.f);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &m_frame);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, kFrameBinding, m_frameUBO);
 
-void Renderer::drawGrid(const Camera& cam, int viewportW, int viewportH)
+    // ImGui / thumbnails may have changed bindings since last frame
+    m_state.invalidate();
+}
+
+void Renderer::endFrame()
 {
-    float aspect = viewportH > 0 ? (float)viewportW / (float)viewportH : 1.f;
-    glm::mat4 view = cam.viewMatrix();
-    glm::mat4 proj = cam.projMatrix(aspect);
-    glm::mat4 invVP = glm::inverse(proj * view);
+    // Leave clean bindings for ImGui and the thumbnail renderer
+    m_state.reset();
+}
 
+void Renderer::drawGrid(const Camera& cam, int /*viewportW*/, int /*viewportH*/)
+{
+    MYTHOS_PROFILE_SCOPE("Renderer::drawGrid");
+    MYTHOS_GPU_SCOPE("Grid");
     // Grid uses alpha blending for distance fade and anti-aliased lines.
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     // Keep depth writes ON — the frag shader writes gl_FragDepth from the
     // actual Y=0 hit point so geometry correctly occludes the grid.
 
-    glUseProgram(m_gridShader);
-    glUniformMatrix4fv(glGetUniformLocation(m_gridShader, "uInvVP"),
-                       1, GL_FALSE, glm::value_ptr(invVP));
-    glUniformMatrix4fv(glGetUniformLocation(m_gridShader, "uVP"),
-                       1, GL_FALSE, glm::value_ptr(proj * view));
-    glUniform1f(glGetUniformLocation(m_gridShader, "uCamDist"), cam.dist);
-    glm::vec3 cp = cam.position();
-    glUniform3f(glGetUniformLocation(m_gridShader, "uCamPos"), cp.x, cp.y, cp.z);
+    // Matrices and camera position come from the frame block
+    m_state.useProgram(m_gridShader);
+    glUniform1f(m_gridLoc.camDist, cam.dist);
 
-    glBindVertexArray(m_gridVAO);
+    m_state.bindVertexArray(m_gridVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);   // clip-space full-screen quad
-    glBindVertexArray(0);
-    glUseProgram(0);
 
     glDisable(GL_BLEND);
 }
 
-void Renderer::setMeshUniforms(GLuint shader, const Camera& cam,
-                               const glm::mat4& model, const glm::vec3& color,
-                               int vpW, int vpH)
+// View, projection, light and eye position live in the frame block; only the
+// per-object values are set here, through locations cached at init.
+void Renderer::setMeshUniforms(const glm::mat4& model, const glm::vec3& color)
 {
-    float aspect        = vpH > 0 ? (float)vpW / (float)vpH : 1.f;
-    glm::mat4 view      = cam.viewMatrix();
-    glm::mat4 proj      = cam.projMatrix(aspect);
     glm::mat3 normalMat = glm::mat3(glm::transpose(glm::inverse(model)));
-
-    glUniformMatrix4fv(glGetUniformLocation(shader, "uModel"),        1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(shader, "uView"),         1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(shader, "uProjection"),   1, GL_FALSE, glm::value_ptr(proj));
-    glUniformMatrix3fv(glGetUniformLocation(shader, "uNormalMatrix"), 1, GL_FALSE, glm::value_ptr(normalMat));
-    glUniform3fv(glGetUniformLocation(shader, "uColor"),    1, glm::value_ptr(color));
-    glUniform3f(glGetUniformLocation(shader,  "uLightPos"), 8.f, 15.f, 10.f);
-    glUniform3fv(glGetUniformLocation(shader, "uViewPos"),  1, glm::value_ptr(cam.position()));
+    glUniformMatrix4fv(m_meshLoc.model,        1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix3fv(m_meshLoc.normalMatrix, 1, GL_FALSE, glm::value_ptr(normalMat));
+    glUniform3fv(m_meshLoc.color, 1, glm::value_ptr(color));
 }
 
-void Renderer::drawMesh(const Camera& cam, const GpuMesh& mesh,
+void Renderer::drawMesh(const Camera& /*cam*/, const GpuMesh& mesh,
                         const glm::mat4& model, const glm::vec3& color,
-                        int vpW, int vpH)
+                        int /*vpW*/, int /*vpH*/)
 {
-    glUseProgram(m_meshShader);
-    setMeshUniforms(m_meshShader, cam, model, color, vpW, vpH);
-    glBindVertexArray(mesh.vao);
-    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
-    glUseProgram(0);
+    m_state.useProgram(m_meshShader);
+    setMeshUniforms(model, color);
+    m_state.bindVertexArray(mesh.vao);
+    glDrawElementsBaseVertex(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT,
+                             (void*)(uintptr_t)(mesh.firstIndex * sizeof(unsigned int)),
+                             mesh.baseVertex);
 }
 
 void Renderer::drawCube(const Camera& cam, const glm::mat4& model,
@@ -504,19 +575,19 @@ void Renderer::drawSceneObject(const Camera& cam, const SceneObject& obj,
         const MeshAsset& asset = *obj.mesh;
 
         if (!asset.submeshes.empty()) {
-            // Multi-material mesh — draw each submesh with its own colour
-            glUseProgram(m_meshShader);
-            setMeshUniforms(m_meshShader, cam, model, {1,1,1}, viewportW, viewportH);
-            glBindVertexArray(asset.gpu.vao);
+            // Multi-material mesh — program, VAO and matrices once, then only
+            // the colour changes between submeshes
+            m_state.useProgram(m_meshShader);
+            setMeshUniforms(model, {1,1,1});
+            m_state.bindVertexArray(asset.gpu.vao);
+            const uintptr_t base = (uintptr_t)asset.gpu.firstIndex * sizeof(unsigned int);
             for (const SubMesh& sm : asset.submeshes) {
                 glm::vec3 col = glm::min(sm.color * tint, glm::vec3(1.f));
-                glUniform3fv(glGetUniformLocation(m_meshShader, "uColor"), 1,
-                             glm::value_ptr(col));
-                glDrawElements(GL_TRIANGLES, sm.indexCount, GL_UNSIGNED_INT,
-                               (void*)(uintptr_t)sm.indexOffset);
+                glUniform3fv(m_meshLoc.color, 1, glm::value_ptr(col));
+                glDrawElementsBaseVertex(GL_TRIANGLES, sm.indexCount, GL_UNSIGNED_INT,
+                                         (void*)(base + (uintptr_t)sm.indexOffset),
+                                         asset.gpu.baseVertex);
             }
-            glBindVertexArray(0);
-            glUseProgram(0);
         } else {
             glm::vec3 col = glm::min(obj.color * tint, glm::vec3(1.f));
             drawMesh(cam, asset.gpu, model, col, viewportW, viewportH);
@@ -527,6 +598,224 @@ void Renderer::drawSceneObject(const Camera& cam, const SceneObject& obj,
     }
 }
 
+// ============================================================
+// Instanced scene drawing
+// ============================================================
+// Per frame:
+//   1. gather  — walk objects once, compute model/normal matrices and tinted
+//                colour, and push one render-queue packet per (object,
+//                submesh) keyed by shader | mesh | material | depth
+//   2. sort    — radix sort the queue; packets with equal state bits form
+//                contiguous runs, and each run becomes one instanced bucket
+//                streamed into one instance VBO (orphaned each frame)
+//   3. submit  — all meshes live in the shared GeometryArena VAO, so the
+//                buckets go out as ONE glMultiDrawElementsIndirect when GL 4.3
+//                is available, otherwise as a BaseVertex loop with no VAO
+//                switches in between
+//
+// Per-draw data is addressed through baseInstance on the instanced vertex
+// attributes rather than an SSBO — the shaders stay GLSL 330 so the same
+// program serves both paths.
+
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float) &&
+              sizeof(glm::vec3) ==  3 * sizeof(float),
+              "InstanceData must be tightly packed for the instance VBO");
+
+void Renderer::pushItem(const void* mesh, int submesh, const ArenaRange& range,
+                        int indexOffsetBytes, int indexCount,
+                        const InstanceData& inst, float depth01)
+{
+    // Dense per-frame mesh slot so the key's mesh field stays small
+    auto [it, inserted] = m_meshSlots.try_emplace(mesh, (uint32_t)m_meshSlots.size());
+    (void)inserted;
+
+    DrawBucket d;
+    d.firstIndex = range.firstIndex + indexOffsetBytes / (int)sizeof(unsigned int);
+    d.baseVertex = range.baseVertex;
+    d.indexCount = indexCount;
+
+    uint32_t item = (uint32_t)m_items.size();
+    m_items.push_back(inst);
+    m_itemDraw.push_back(d);
+    m_queue.push(RenderKey::make(RenderKey::Opaque, /*shader*/ 0, it->second,
+                                 (uint32_t)(submesh + 1), depth01),
+                 item);
+}
+
+void Renderer::drawScene(const Camera& /*cam*/,
+                         const std::vector<SceneObject>& objects,
+                         const std::vector<int>& drawList,
+                         int /*viewportW*/, int /*viewportH*/)
+{
+    MYTHOS_PROFILE_SCOPE("Renderer::drawScene");
+    MYTHOS_GPU_SCOPE("Scene");
+
+    m_meshSlots.clear();
+    m_buckets.clear();
+    m_itemDraw.clear();
+    m_items.clear();
+    m_queue.clear();
+
+    const glm::vec3 eye     = glm::vec3(m_frame.viewPos);
+    const float     invFar  = 1.f / Camera::kFar;
+
+    // ---- 1. Gather ----
+    for (int idx : drawList) {
+        const SceneObject& obj = objects[idx];
+        if (!obj.visible) continue;
+
+        InstanceData inst;
+        inst.model = obj.transform();
+        glm::mat3 nm = glm::mat3(glm::transpose(glm::inverse(inst.model)));
+        inst.normal0 = nm[0];
+        inst.normal1 = nm[1];
+        inst.normal2 = nm[2];
+        float tint  = obj.selected ? 1.7f : (obj.hovered ? 1.3f : 1.0f);
+        float depth = glm::length(glm::vec3(inst.model[3]) - eye) * invFar;
+
+        // Uploaded assets already live in the arena (MeshAsset::upload)
+        ArenaRange        meshRange;
+        const ArenaRange* range = nullptr;
+        if (obj.mesh && obj.mesh->gpu.pooled) {
+            const GpuMesh& g = obj.mesh->gpu;
+            meshRange = { g.baseVertex, g.firstIndex, g.vertexCount, g.indexCount };
+            range = &meshRange;
+        }
+
+        if (range && !obj.mesh->submeshes.empty()) {
+            // Multi-material mesh — one packet per submesh
+            const MeshAsset& asset = *obj.mesh;
+            for (int si = 0; si < (int)asset.submeshes.size(); ++si) {
+                const SubMesh& sm = asset.submeshes[si];
+                inst.color = glm::min(sm.color * tint, glm::vec3(1.f));
+                pushItem(&asset, si, *range, sm.indexOffset, sm.indexCount, inst, depth);
+            }
+        } else if (range) {
+            inst.color = glm::min(obj.color * tint, glm::vec3(1.f));
+            pushItem(obj.mesh.get(), -1, *range, 0, range->indexCount, inst, depth);
+        } else if (m_cubeRange.valid()) {
+            inst.color = glm::min(obj.color * tint, glm::vec3(1.f));
+            pushItem(&m_cubeRange, -1, m_cubeRange, 0, m_cubeRange.indexCount, inst, depth);
+        }
+    }
+    if (m_items.empty()) return;
+
+    // ---- 2. Sort; equal-state runs become instanced buckets ----
+    m_queue.sort();
+    const auto& packets = m_queue.packets();
+    m_instances.resize(packets.size());
+
+    // Equal state bits normally mean the same draw; ids that overflowed the
+    // key share a value, so the draw range is checked too
+    uint64_t prevState = ~0ull;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const DrawPacket& p = packets[i];
+        uint64_t state = RenderKey::stateBits(p.key);
+        const DrawBucket& d = m_itemDraw[p.item];
+        if (state != prevState || d.firstIndex != m_buckets.back().firstIndex ||
+                                  d.baseVertex != m_buckets.back().baseVertex ||
+                                  d.indexCount != m_buckets.back().indexCount) {
+            DrawBucket b = d;
+            b.first = (int)i;
+            b.count = 0;
+            m_buckets.push_back(b);
+            prevState = state;
+        }
+        ++m_buckets.back().count;
+        m_instances[i] = m_items[p.item];
+    }
+    uploadInstances();
+
+    // ---- 3. Submit ----
+    // Uploads since the last frame bind buffers/VAOs behind the cache's back
+    m_state.invalidate();
+    // Camera and light come from the frame block — no per-draw uniforms
+    m_state.useProgram(m_instShader);
+    m_state.bindVertexArray(m_arena.vao());
+    submitBuckets();
+}
+
+void Renderer::submitBuckets()
+{
+#ifdef GL_VERSION_4_3
+    if (m_useMultiDraw) {
+        // baseInstance offsets every divisor-1 attribute, so the instance
+        // pointers are set once at offset 0 for the whole submission.
+        bindInstanceAttribs(0);
+
+        m_commands.clear();
+        for (const DrawBucket& b : m_buckets)
+            m_commands.push_back({ (GLuint)b.indexCount, (GLuint)b.count,
+                                   (GLuint)b.firstIndex, (GLint)b.baseVertex,
+                                   (GLuint)b.first });
+
+        size_t bytes = m_commands.size() * sizeof(IndirectCommand);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuf);
+        if (bytes > m_indirectCap)
+            m_indirectCap = std::max(bytes, m_indirectCap * 2);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)m_indirectCap, nullptr, GL_STREAM_DRAW);
+        m_bufferMem.set(m_instanceVBOCap + m_indirectCap + sizeof(FrameData));
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, (GLsizeiptr)bytes, m_commands.data());
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+                                    (GLsizei)m_commands.size(), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+#endif
+    // GL 3.3 path — no baseInstance, so re-point the instance attributes at
+    // each bucket's run. Still a single VAO for the whole scene.
+    for (const DrawBucket& b : m_buckets) {
+        bindInstanceAttribs((size_t)b.first);
+        glDrawElementsInstancedBaseVertex(
+            GL_TRIANGLES, b.indexCount, GL_UNSIGNED_INT,
+            (void*)(uintptr_t)((size_t)b.firstIndex * sizeof(unsigned int)),
+            b.count, b.baseVertex);
+    }
+}
+
+void Renderer::uploadInstances()
+{
+    size_t bytes = m_instances.size() * sizeof(InstanceData);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+
+    // Grow geometrically; otherwise orphan the old storage so the driver can
+    // hand back fresh memory instead of stalling on last frame's draws.
+    if (bytes > m_instanceVBOCap)
+        m_instanceVBOCap = std::max(bytes, m_instanceVBOCap * 2);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)m_instanceVBOCap, nullptr, GL_STREAM_DRAW);
+    m_bufferMem.set(m_instanceVBOCap + m_indirectCap + sizeof(FrameData));
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)bytes, m_instances.data());
+}
+
+void Renderer::bindInstanceAttribs(size_t firstInstance)
+{
+    // Attribute pointers capture the buffer bound to GL_ARRAY_BUFFER, so the
+    // instance VBO is bound while they are specified on the arena VAO.
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    const GLsizei stride = (GLsizei)sizeof(InstanceData);
+    const size_t  base   = firstInstance * sizeof(InstanceData);
+
+    for (int c = 0; c < 4; ++c) {
+        GLuint loc = 3 + c;
+        glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(InstanceData, model) + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(loc, 1);
+        glEnableVertexAttribArray(loc);
+    }
+    const size_t perInst[4] = {
+        offsetof(InstanceData, normal0), offsetof(InstanceData, normal1),
+        offsetof(InstanceData, normal2), offsetof(InstanceData, color),
+    };
+    for (int a = 0; a < 4; ++a) {
+        GLuint loc = 7 + a;
+        glVertexAttribPointer(loc, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + perInst[a]));
+        glVertexAttribDivisor(loc, 1);
+        glEnableVertexAttribArray(loc);
+    }
+}
+
 // ============================================================
 // Private builders
 // ============================================================
@@ -590,6 +879,15 @@ void Renderer::buildCubeMesh()
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
     m_cubeMesh.indexCount = 36;
+
+    // Same cube in the shared arena — fallback for objects without a mesh
+    MeshData cube;
+    for (int v = 0; v < 24; ++v) {
+        const float* f = verts + v * 6;
+        cube.vertices.push_back({ {f[0], f[1], f[2]}, {f[3], f[4], f[5]}, {0.f, 0.f} });
+    }
+    cube.indices.assign(idx, idx + 36);
+    m_arena.allocate(cube, m_cubeRange);
 }
 
 void Renderer::buildGrid()
@@ -617,18 +915,12 @@ void Renderer::buildGrid()
 }
 
 
-void Renderer::drawGhostCube(const Camera& cam, const glm::mat4& model,
+void Renderer::drawGhostCube(const Camera& /*cam*/, const glm::mat4& model,
                               const glm::vec3& color, float alpha,
-                              int viewportW, int viewportH)
+                              int /*viewportW*/, int /*viewportH*/)
 {
-    float aspect = viewportH > 0 ? (float)viewportW / (float)viewportH : 1.f;
-    glm::mat4 view = cam.viewMatrix();
-    glm::mat4 proj = cam.projMatrix(aspect);
-
-    glUseProgram(m_ghostShader);
-    glUniformMatrix4fv(glGetUniformLocation(m_ghostShader, "uModel"),      1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(m_ghostShader, "uView"),       1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(m_ghostShader, "uProjection"), 1, GL_FALSE, glm::value_ptr(proj));
+    m_state.useProgram(m_ghostShader);
+    glUniformMatrix4fv(m_ghostLoc.model, 1, GL_FALSE, glm::value_ptr(model));
 
     // --- Transparent fill ---
     glEnable(GL_BLEND);
@@ -636,23 +928,20 @@ void Renderer::drawGhostCube(const Camera& cam, const glm::mat4& model,
     glDepthMask(GL_FALSE);          // don't write to depth — ghost passes through
     glDisable(GL_CULL_FACE);        // see all faces of ghost
 
-    glUniform4f(glGetUniformLocation(m_ghostShader, "uColor"),
+    glUniform4f(m_ghostLoc.color,
                 color.r, color.g, color.b, alpha * 0.25f);  // very faint fill
 
-    glBindVertexArray(m_cubeMesh.vao);
+    m_state.bindVertexArray(m_cubeMesh.vao);
     glDrawElements(GL_TRIANGLES, m_cubeMesh.indexCount, GL_UNSIGNED_INT, nullptr);
 
     // --- Wireframe edges — brighter, full alpha ---
-    glUniform4f(glGetUniformLocation(m_ghostShader, "uColor"),
-                color.r, color.g, color.b, alpha);
+    glUniform4f(m_ghostLoc.color, color.r, color.g, color.b, alpha);
 
     glLineWidth(1.5f);
-    glBindVertexArray(m_wireEdges.vao);
+    m_state.bindVertexArray(m_wireEdges.vao);
     glDrawElements(GL_LINES, m_wireEdges.indexCount, GL_UNSIGNED_INT, nullptr);
 
     // Restore state
-    glBindVertexArray(0);
-    glUseProgram(0);
     glDepthMask(GL_TRUE);
     glEnable(GL_CULL_FACE);
     glDisable(GL_BLEND);
@@ -2,7 +2,12 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
 #include "MeshAsset.h"
+#include "GeometryArena.h"
+#include "RenderQueue.h"
 
 // Forward declarations
 struct SceneObject;
@@ -15,6 +20,12 @@ struct Camera
     float     pitch   =  30.f;
     float     dist    =  10.f;
 
+    // Projection parameters — shared with culling, which must agree with
+    // the frustum actually drawn.
+    static constexpr float kFovY = 45.f;     // degrees
+    static constexpr float kNear = 0.01f;
+    static constexpr float kFar  = 500.f;
+
     glm::vec3 position() const;
     glm::mat4 viewMatrix() const;
     glm::mat4 projMatrix(float aspect) const;
@@ -35,11 +46,22 @@ public:
     bool init();
     void shutdown();
 
-    void beginFrame(int viewportW, int viewportH);
+    // Uploads camera + light into the per-frame uniform block that every
+    // scene shader reads. All draw calls until endFrame() use this camera.
+    void beginFrame(const Camera& cam, int viewportW, int viewportH);
     void endFrame();
 
     void drawGrid(const Camera& cam, int viewportW, int viewportH);
 
+    // Draw the objects listed in drawList (indices into objects, normally
+    // the survivors of SceneCuller) in one batched pass. Objects become
+    // sorted render-queue packets; runs with identical state (mesh, submesh)
+    // are drawn instanced, so draw calls scale with unique meshes, not objects.
+    void drawScene(const Camera& cam,
+                   const std::vector<SceneObject>& objects,
+                   const std::vector<int>& drawList,
+                   int viewportW, int viewportH);
+
     // Draw a SceneObject using its mesh asset and transform.
     // Highlights selected/hovered objects automatically.
     void drawSceneObject(const Camera& cam,
@@ -67,6 +89,27 @@ public:
                   int viewportW, int viewportH);
 
 private:
+    // ---- Per-frame uniform block (std140, binding kFrameBinding) ----
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 proj;
+        glm::mat4 viewProj;
+        glm::mat4 invViewProj;
+        glm::vec4 lightPos;
+        glm::vec4 viewPos;
+    };
+    static constexpr GLuint kFrameBinding = 0;
+    GLuint    m_frameUBO = 0;
+    FrameData m_frame;
+
+    // ---- Uniform locations, looked up once per program at init ----
+    struct MeshLocs  { GLint model = -1, normalMatrix = -1, color = -1; } m_meshLoc;
+    struct GhostLocs { GLint model = -1, color = -1; }                    m_ghostLoc;
+    struct GridLocs  { GLint camDist = -1; }                              m_gridLoc;
+
+    GLStateCache m_state;
+    RenderQueue  m_queue;
+
     GLuint  m_meshShader  = 0;
     GpuMesh m_cubeMesh;         // built-in unit cube (for legacy + ghost fill)
 
@@ -78,12 +121,64 @@ private:
     GLuint m_gridVBO       = 0;
     int    m_gridLineCount = 0;
 
+    // ---- Instanced scene path (drawScene) ----
+    // Scene meshes are drawn out of one shared GeometryArena. Per-instance
+    // data is streamed as vertex attributes:
+    // model → locations 3..6, normal matrix columns → 7..9, colour → 10.
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec3 normal0, normal1, normal2;
+        glm::vec3 color;
+    };
+
+    // One instanced draw: an arena index range plus a run of instances.
+    struct DrawBucket {
+        int firstIndex  = 0;   // in the arena IBO (indices, not bytes)
+        int baseVertex  = 0;
+        int indexCount  = 0;
+        int first       = 0;   // first instance in m_instances
+        int count       = 0;
+    };
+
+    // Matches the GL DrawElementsIndirectCommand layout.
+    struct IndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint  baseVertex;
+        GLuint baseInstance;
+    };
+
+    GeometryArena m_arena;            // also GeometryArena::meshPool()
+    ArenaRange    m_cubeRange;        // fallback for objects without a mesh
+
+    GLuint m_instShader     = 0;
+    GLuint m_instanceVBO    = 0;
+    size_t m_instanceVBOCap = 0;      // bytes currently allocated
+    GLuint m_indirectBuf    = 0;
+    size_t m_indirectCap    = 0;      // bytes currently allocated
+    MemoryStats::Tracked m_bufferMem { MemTag::RenderBuffers };   // instance + indirect + UBO
+    bool   m_useMultiDraw   = false;  // GL 4.3 glMultiDrawElementsIndirect
+
+    // Per-frame scratch — kept as members so capacity survives between frames
+    std::unordered_map<const void*, uint32_t> m_meshSlots;   // dense queue ids
+    std::vector<DrawBucket>      m_buckets;
+    std::vector<DrawBucket>      m_itemDraw;     // index range of each item
+    std::vector<InstanceData>    m_items;        // gathered in object order
+    std::vector<InstanceData>    m_instances;    // sorted by bucket for upload
+    std::vector<IndirectCommand> m_commands;
+
+    void pushItem(const void* mesh, int submesh, const ArenaRange& range,
+                  int indexOffsetBytes, int indexCount,
+                  const InstanceData& inst, float depth01);
+    void uploadInstances();
+    void bindInstanceAttribs(size_t firstInstance);
+    void submitBuckets();
+
     void buildCubeMesh();
     void buildWireEdges();
     void buildGrid();
 
-    void setMeshUniforms(GLuint shader, const Camera& cam,
-                         const glm::mat4& model, const glm::vec3& color,
-                         int vpW, int vpH);
+    void setMeshUniforms(const glm::mat4& model, const glm::vec3& color);
 };
 
@@ -33,9 +33,11 @@ std::shared_ptr<MeshAsset> MeshLibrary::importObj(const std::string& path)
 {
     auto asset = ObjImporter::load(path);
     if (!asset) return nullptr;
-    if (!asset->upload()) return nullptr;
-    m_assets[asset->name] = asset;
-    std::cout << "[MeshLibrary] Imported: " << asset->name << "\n";
+    std::string key = asset->name;
+    asset = m_registry.intern(asset);   // same content under another path
+    if (!asset->isLoaded() && !asset->upload()) return nullptr;
+    m_assets[key] = asset;
+    std::cout << "[MeshLibrary] Imported: " << key << "\n";
     return asset;
 }
 
@@ -90,15 +92,70 @@ SceneObject& Scene::addObject()
     SceneObject obj;
     obj.id = m_nextId++;
     m_objects.push_back(std::move(obj));
+    indexObject(m_objects.size() - 1);
+    touch();
     return m_objects.back();
 }
 
+SceneObject& Scene::restoreObject(const SceneObject& snap)
+{
+    m_objects.push_back(snap);
+    SceneObject& o = m_objects.back();
+
+    // Keep the original id unless something else has claimed it since
+    if (o.id <= 0 || m_index.count(o.id)) o.id = m_nextId;
+    if (o.id >= m_nextId) m_nextId = o.id + 1;
+
+    indexObject(m_objects.size() - 1);
+    touch();
+    return o;
+}
+
+void Scene::restoreObjects(const std::vector<SceneObject>& snaps,
+                           const std::vector<uint32_t>& slots)
+{
+    if (snaps.empty()) return;
+    if (slots.size() != snaps.size()) {
+        for (const SceneObject& s : snaps) restoreObject(s);
+        return;
+    }
+
+    // Merge the survivors and the snaps into a new array, then index the
+    // snaps and fix up the slots behind the first one
+    std::vector<SceneObject> merged;
+    merged.reserve(m_objects.size() + snaps.size());
+    std::vector<size_t> restored;
+    restored.reserve(snaps.size());
+    size_t r = 0;
+    for (size_t k = 0; k < snaps.size(); ++k) {
+        while (merged.size() < slots[k] && r < m_objects.size())
+            merged.push_back(std::move(m_objects[r++]));
+        merged.push_back(snaps[k]);
+        SceneObject& o = merged.back();
+        if (o.id <= 0 || m_index.count(o.id)) o.id = m_nextId;
+        if (o.id >= m_nextId) m_nextId = o.id + 1;
+        restored.push_back(merged.size() - 1);
+    }
+    while (r < m_objects.size()) merged.push_back(std::move(m_objects[r++]));
+    m_objects = std::move(merged);
+
+    for (size_t slot : restored) indexObject(slot);
+    reindexSlots(restored.front());
+    touch();
+}
+
 void Scene::removeObject(int id)
 {
-    m_objects.erase(
-        std::remove_if(m_objects.begin(), m_objects.end(),
-                       [id](const SceneObject& o){ return o.id == id; }),
-        m_objects.end());
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return;
+
+    size_t slot = it->second.slot;
+    if (it->second.inGrid) m_grid.remove(it->second.cell, id);
+    m_index.erase(it);
+
+    m_objects.erase(m_objects.begin() + (std::ptrdiff_t)slot);
+    reindexSlots(slot);
+    touch();
 
     if (m_selectedId == id) m_selectedId = -1;
     if (m_hoveredId  == id) m_hoveredId  = -1;
@@ -107,36 +164,87 @@ void Scene::removeObject(int id)
         std::remove(m_selectedIds.begin(), m_selectedIds.end(), id),
         m_selectedIds.end());
 
-    // Rebuild cell map
-    m_cellToId.clear();
-    for (auto& o : m_objects)
-        m_cellToId[{o.gridCell.x, o.gridCell.y}] = o.id;
+    syncSelectedFlag();
+}
+
+void Scene::removeObjects(const std::vector<int>& ids)
+{
+    if (ids.empty()) return;
+
+    // Unindex first, mark slots, then compact the array in a single pass
+    std::vector<char> drop(m_objects.size(), 0);
+    for (int id : ids) {
+        auto it = m_index.find(id);
+        if (it == m_index.end()) continue;
+        drop[it->second.slot] = 1;
+        if (it->second.inGrid) m_grid.remove(it->second.cell, id);
+        m_index.erase(it);
+        if (m_selectedId == id) m_selectedId = -1;
+        if (m_hoveredId  == id) m_hoveredId  = -1;
+    }
+
+    size_t w = 0;
+    for (size_t r = 0; r < m_objects.size(); ++r) {
+        if (drop[r]) continue;
+        if (w != r) m_objects[w] = std::move(m_objects[r]);
+        m_index[m_objects[w].id].slot = w;
+        ++w;
+    }
+    m_objects.erase(m_objects.begin() + (std::ptrdiff_t)w, m_objects.end());
+    touch();
+
+    m_selectedIds.erase(
+        std::remove_if(m_selectedIds.begin(), m_selectedIds.end(),
+                       [this](int id){ return m_index.count(id) == 0; }),
+        m_selectedIds.end());
 
     syncSelectedFlag();
 }
 
+void Scene::reserve(size_t count)
+{
+    m_objects.reserve(count);
+    m_index.reserve(count);
+    m_grid.reserve(count);
+}
+
 void Scene::clear()
 {
     m_objects.clear();
-    m_cellToId.clear();
+    m_index.clear();
+    m_grid.clear();
     m_selectedId  = -1;
     m_hoveredId   = -1;
     m_selectedIds.clear();
     m_nextId      = 1;
+    touch();
 }
 
 SceneObject* Scene::findById(int id)
 {
-    for (auto& o : m_objects)
-        if (o.id == id) return &o;
-    return nullptr;
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return nullptr;
+    return &m_objects[it->second.slot];
 }
 
 const SceneObject* Scene::findById(int id) const
 {
-    for (const auto& o : m_objects)
-        if (o.id == id) return &o;
-    return nullptr;
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return nullptr;
+    return &m_objects[it->second.slot];
+}
+
+void Scene::indexObject(size_t slot)
+{
+    const SceneObject& o = m_objects[slot];
+    m_index[o.id] = { slot, o.gridCell, o.onGrid };
+    if (o.onGrid) m_grid.insert(o.gridCell, o.id);
+}
+
+void Scene::reindexSlots(size_t from)
+{
+    for (size_t i = from; i < m_objects.size(); ++i)
+        m_index[m_objects[i].id].slot = i;
 }
 
 // ============================================================
@@ -272,67 +380,196 @@ int Scene::pickObject(const glm::vec3& rayOrig, const glm::vec3& rayDir) const
 
 int Scene::objectAtCell(glm::ivec2 cell) const
 {
-    auto it = m_cellToId.find({cell.x, cell.y});
-    return (it != m_cellToId.end()) ? it->second : -1;
+    const std::vector<int>* ids = m_grid.objectsAt(cell);
+    if (!ids) return -1;
+    // Most recent visible object wins — hidden ones are pending regeneration
+    for (auto it = ids->rbegin(); it != ids->rend(); ++it)
+        if (m_objects[m_index.at(*it).slot].visible) return *it;
+    return -1;
+}
+
+const std::vector<int>& Scene::objectsAtCell(glm::ivec2 cell) const
+{
+    static const std::vector<int> kEmpty;
+    const std::vector<int>* ids = m_grid.objectsAt(cell);
+    return ids ? *ids : kEmpty;
+}
+
+void Scene::objectsInRange(glm::ivec2 lo, glm::ivec2 hi, std::vector<int>& out) const
+{
+    m_grid.queryRange(lo, hi, [&](glm::ivec2, int id) { out.push_back(id); });
+}
+
+void Scene::setObjectCell(int id, glm::ivec2 cell)
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return;
+    SceneObject& o = m_objects[it->second.slot];
+    o.gridCell = cell;
+    o.onGrid   = true;
+    reindexObject(id);
+    touch();
+}
+
+void Scene::reindexObject(int id)
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return;
+    const SceneObject& o = m_objects[it->second.slot];
+    IndexEntry&        e = it->second;
+    if (e.inGrid && o.onGrid)  m_grid.move(e.cell, o.gridCell, id);
+    else if (e.inGrid)         m_grid.remove(e.cell, id);
+    else if (o.onGrid)         m_grid.insert(o.gridCell, id);
+    e.cell   = o.gridCell;
+    e.inGrid = o.onGrid;
 }
 
 void Scene::setCursorCell(glm::ivec2 cell, bool valid)
 {
-    if (m_hoveredId != -1) {
+    int id = valid ? objectAtCell(cell) : -1;
+    if (id == m_hoveredId) return;   // hover unchanged — nothing to touch
+
+    if (m_hoveredId != -1)
         if (auto* o = findById(m_hoveredId)) o->hovered = false;
-        m_hoveredId = -1;
-    }
-    if (!valid) return;
-    int id = objectAtCell(cell);
-    if (id == -1) return;
     m_hoveredId = id;
-    if (auto* o = findById(id)) o->hovered = true;
+    if (id != -1)
+        if (auto* o = findById(id)) o->hovered = true;
 }
 
 void Scene::rebuildCellMap()
 {
-    m_cellToId.clear();
-    for (auto& o : m_objects)
-        m_cellToId[{o.gridCell.x, o.gridCell.y}] = o.id;
+    m_index.clear();
+    m_grid.clear();
+    m_grid.reserve(m_objects.size());
+    for (size_t i = 0; i < m_objects.size(); ++i)
+        indexObject(i);
+    touch();
 }
 
 // ============================================================
-// Grammar integration
+// Memory accounting
 // ============================================================
 
-void Scene::populateFromGrammar(const grammar::Grammar& gram, MeshLibrary& lib)
+static size_t strHeap(const std::string& s) { return s.capacity() > 15 ? s.capacity() + 1 : 0; }
+
+size_t Scene::objectsBytes(const std::vector<SceneObject>& objects)
 {
-    clear();
+    size_t n = objects.capacity() * sizeof(SceneObject);
+    for (const auto& o : objects)
+        n += strHeap(o.name) + strHeap(o.primId)
+           + o.sockets.capacity() * sizeof(WorldSocket);
+    return n;
+}
 
-    if (gram.placed.empty()) return;
+size_t Scene::memoryBytes() const
+{
+    // unordered_map node ≈ entry + next pointer + cached hash; plus buckets
+    const size_t indexBytes = m_index.size() * (sizeof(std::pair<const int, IndexEntry>) + 2 * sizeof(void*))
+                            + m_index.bucket_count() * sizeof(void*);
+    const size_t gridBytes  = m_grid.chunkCount() * SpatialGrid::kChunkCells * sizeof(std::vector<int>)
+                            + m_grid.objectCount() * sizeof(int);
+    return objectsBytes(m_objects) + indexBytes + gridBytes
+         + m_selectedIds.capacity() * sizeof(int);
+}
 
+// ============================================================
+// Grammar integration
+// ============================================================
+
+// Population is a diff against whatever the scene already holds rather than
+// clear()+rebuild. Objects are matched to placements by (gridCell, primId):
+//   - matched   → updated in place (id, slot and index entry are kept)
+//   - unmatched → removed in one compaction pass
+//   - new       → appended into storage reserved up front
+// Re-seeding a large layout therefore only touches the cells that changed
+// and never reallocates the object array once it has reached full size.
+
+void Scene::populateFromGrammar(const grammar::Grammar& gram, MeshLibrary& lib)
+{
     // Assign colours — cycle through a palette
     static const glm::vec3 palette[] = {
         {0.30f,0.55f,0.90f}, {0.85f,0.35f,0.25f}, {0.25f,0.75f,0.45f},
         {0.90f,0.75f,0.20f}, {0.70f,0.30f,0.80f}, {0.20f,0.75f,0.85f},
     };
-    int ci = 0;
 
-    for (const auto& p : gram.placed) {
-        if (!p.def) continue;
+    // One getOrCreateCube lookup per prim type, not per piece
+    std::unordered_map<const grammar::PrimDef*, std::shared_ptr<MeshAsset>> meshFor;
+
+    auto applyPlacement = [&](SceneObject& obj, const grammar::Placed& p, int ci) {
         const std::string& primId = p.def->id;
         const glm::vec3&   color  = palette[ci % 6];
 
-        auto mesh = lib.getOrCreateCube(primId, color);
+        auto& mesh = meshFor[p.def];
+        if (!mesh) mesh = lib.getOrCreateCube(primId, color);
 
-        SceneObject& obj = addObject();
-        obj.name     = primId;
-        obj.primId   = primId;
+        if (obj.primId != primId) { obj.name = primId; obj.primId = primId; }
         obj.mesh     = mesh;
         obj.color    = color;
         obj.position = glm::vec3((float)p.cell.x, 0.f, (float)p.cell.y);
         obj.rotation = glm::vec3(0.f, -(float)p.rot, 0.f);
         obj.scale    = glm::vec3(1.f, 0.5f, 1.f);
-        obj.gridCell = p.cell;
+        obj.visible  = true;
+        obj.hovered  = false;
+    };
+
+    // ---- Pass 1: match placements against existing objects ----
+    std::vector<char> claimed(m_objects.size(), 0);
+    std::vector<std::pair<size_t,int>> fresh;   // (placed index, palette index)
+    int ci = 0;
+
+    for (size_t i = 0; i < gram.placed.size(); ++i) {
+        const auto& p = gram.placed[i];
+        if (!p.def) continue;
+
+        size_t match = (size_t)-1;
+        for (int id : objectsAtCell(p.cell)) {
+            size_t slot = m_index[id].slot;
+            if (!claimed[slot] && m_objects[slot].primId == p.def->id) {
+                match = slot;
+                break;
+            }
+        }
+
+        if (match != (size_t)-1) {
+            claimed[match] = 1;
+            applyPlacement(m_objects[match], p, ci);
+        } else {
+            fresh.push_back({i, ci});
+        }
         ++ci;
+    }
 
-        m_cellToId[{p.cell.x, p.cell.y}] = obj.id;
+    // ---- Pass 2: drop everything the new layout no longer contains ----
+    std::vector<int> stale;
+    for (size_t slot = 0; slot < claimed.size(); ++slot)
+        if (!claimed[slot]) stale.push_back(m_objects[slot].id);
+    removeObjects(stale);
+
+    // ---- Pass 3: append new pieces ----
+    reserve(m_objects.size() + fresh.size());
+    for (auto& [i, pci] : fresh) {
+        const auto& p = gram.placed[i];
+        SceneObject& obj = addObject();
+        applyPlacement(obj, p, pci);
+        setObjectCell(obj.id, p.cell);
     }
+
+    m_hoveredId = -1;
+    touch();   // matched objects were updated in place
+
+    std::cout << "[Scene] Populated " << (ci - (int)fresh.size()) << " kept, "
+              << fresh.size() << " added, " << stale.size() << " removed\n";
+}
+
+void Scene::beginRepopulate()
+{
+    // Hide rather than clear — the old objects are the diff base for the
+    // next populateFromGrammar(), and hidden objects are skipped by drawing,
+    // picking and the hover cursor.
+    selectNone();
+    for (auto& o : m_objects) { o.visible = false; o.hovered = false; }
+    m_hoveredId = -1;
+    touch();
 }
 
 void Scene::populateFromInduced(const grammar::InducedGenerator& /*gen*/,
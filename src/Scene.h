@@ -2,8 +2,11 @@
 #include "SceneObject.h"
 #include "MeshAsset.h"
 #include "ObjImporter.h"
+#include "SpatialGrid.h"
+#include "MeshRegistry.h"
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include <string>
 #include <functional>
@@ -28,7 +31,11 @@ public:
     std::shared_ptr<MeshAsset> find(const std::string& name) const;
     const std::map<std::string, std::shared_ptr<MeshAsset>>& all() const { return m_assets; }
 
+    // Content dedup shared by every importer / merge path in the editor
+    MeshRegistry& registry() { return m_registry; }
+
 private:
+    MeshRegistry m_registry;
     std::map<std::string, std::shared_ptr<MeshAsset>> m_assets;
     std::map<std::string, std::shared_ptr<MeshAsset>> m_primOverrides;
     std::shared_ptr<MeshAsset> makeCube(const std::string& name);
@@ -41,7 +48,17 @@ public:
     // --- Object management ---
     SceneObject& addObject();
     void         removeObject(int id);
+    void         removeObjects(const std::vector<int>& ids);  // one compaction pass
     void         clear();
+    void         reserve(size_t count);
+
+    // Re-insert a previously removed object keeping its id (undo paths).
+    // Plain addObject()+assignment would overwrite the id behind the index.
+    SceneObject& restoreObject(const SceneObject& snap);
+    // Same for many, at the slots they had (ascending, one per snap) in a
+    // single pass. Without slots they are appended in order.
+    void         restoreObjects(const std::vector<SceneObject>& snaps,
+                                const std::vector<uint32_t>& slots);
 
     SceneObject*       findById(int id);
     const SceneObject* findById(int id) const;
@@ -52,7 +69,10 @@ public:
     int objectCount() const { return (int)m_objects.size(); }
 
     // --- Grammar integration ---
+    // Diffs the placement against the current objects (see Scene.cpp).
     void populateFromGrammar(const grammar::Grammar& gram, MeshLibrary& lib);
+    // Hide current objects ahead of a regeneration; they stay as diff base.
+    void beginRepopulate();
     void populateFromInduced(const grammar::InducedGenerator& gen,
                              AssetLibrary& assetLib);
 
@@ -79,20 +99,56 @@ public:
     int pickObject(const glm::vec3& rayOrig, const glm::vec3& rayDir) const;
 
     // --- Grid lookup (grammar hover cursor) ---
+    // Every onGrid object is indexed at its gridCell in a sparse hashed grid.
+    // objectAtCell returns the most recently placed object in the cell.
     int  objectAtCell(glm::ivec2 cell) const;
+    const std::vector<int>& objectsAtCell(glm::ivec2 cell) const;
+    // All ids in the inclusive cell rectangle [lo, hi] (neighbour queries).
+    void objectsInRange(glm::ivec2 lo, glm::ivec2 hi, std::vector<int>& out) const;
+
+    // Move an object to a new cell (putting it on the grid) — updates
+    // gridCell, onGrid and the index together.
+    void setObjectCell(int id, glm::ivec2 cell);
+    // Re-sync the index after gridCell / onGrid were written directly.
+    void reindexObject(int id);
+
     void setCursorCell(glm::ivec2 cell, bool valid);
-    void rebuildCellMap();
+    void rebuildCellMap();   // full rebuild — only needed after bulk loads
     void setNextId(int id) { m_nextId = id; }
 
+    const SpatialGrid& grid() const { return m_grid; }
+
+    // --- Change tracking ---
+    // Bumped by every structural change made through Scene. Code that edits
+    // object transforms/visibility directly through objects() or findById()
+    // must call touch() so caches keyed on the version (culling) refresh.
+    uint64_t version() const { return m_version; }
+    void     touch()         { ++m_version; }
+
+    // --- Memory accounting (MemoryStats, estimate) ---
+    // Objects with their names/sockets, the id index and the cell grid. Meshes are
+    // shared and accounted by MeshAsset. O(n) — sample, don't call per frame.
+    size_t        memoryBytes() const;
+    static size_t objectsBytes(const std::vector<SceneObject>& objects);
+
 private:
     std::vector<SceneObject> m_objects;
     int m_nextId     = 1;
     int m_selectedId = -1;   // primary (drives gizmo pivot)
     int m_hoveredId  = -1;
+    uint64_t m_version = 0;
 
     std::vector<int> m_selectedIds;  // all selected, including primary
 
-    std::map<std::pair<int,int>, int> m_cellToId;
+    // id → slot in m_objects plus the cell the id is filed under in m_grid
+    // (inGrid false: not filed). The cell is tracked separately from
+    // SceneObject::gridCell so a stale entry can always be found and removed.
+    struct IndexEntry { size_t slot; glm::ivec2 cell; bool inGrid; };
+    std::unordered_map<int, IndexEntry> m_index;
+    SpatialGrid m_grid;
+
+    void indexObject(size_t slot);
+    void reindexSlots(size_t from);   // slot fix-up after an erase
 
     void syncSelectedFlag();   // keeps SceneObject::selected in sync
 };
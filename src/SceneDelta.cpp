@@ -0,0 +1,196 @@
+#include "SceneDelta.h"
+#include <unordered_map>
+
+// ============================================================
+// TransformDelta
+// ============================================================
+
+void TransformDelta::add(int id, const Trs& pre, const Trs& post)
+{
+    if (pre.pos == post.pos && pre.rot == post.rot && pre.scl == post.scl) return;
+    ids.push_back(id);
+    before[0].push_back(pre.pos);  after[0].push_back(post.pos);
+    before[1].push_back(pre.rot);  after[1].push_back(post.rot);
+    before[2].push_back(pre.scl);  after[2].push_back(post.scl);
+}
+
+void TransformDelta::finish()
+{
+    channels = 0;
+    for (int c = 0; c < 3; ++c) {
+        bool changed = false;
+        for (size_t i = 0; i < ids.size() && !changed; ++i)
+            changed = before[c][i] != after[c][i];
+
+        if (changed) {
+            channels |= (uint8_t)(1u << c);
+            before[c].shrink_to_fit();
+            after[c].shrink_to_fit();
+        } else {
+            std::vector<glm::vec3>().swap(before[c]);
+            std::vector<glm::vec3>().swap(after[c]);
+        }
+    }
+    ids.shrink_to_fit();
+}
+
+void TransformDelta::apply(Scene& scene, bool redo) const
+{
+    const std::vector<glm::vec3>* src = redo ? after : before;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        SceneObject* o = scene.findById(ids[i]);
+        if (!o) continue;
+        if (channels & Position) o->position = src[0][i];
+        if (channels & Rotation) o->rotation = src[1][i];
+        if (channels & Scale)    o->scale    = src[2][i];
+    }
+    scene.touch();
+}
+
+size_t TransformDelta::bytes() const
+{
+    size_t n = ids.capacity() * sizeof(int);
+    for (int c = 0; c < 3; ++c)
+        n += (before[c].capacity() + after[c].capacity()) * sizeof(glm::vec3);
+    return n;
+}
+
+// ============================================================
+// SceneDelta
+// ============================================================
+
+// Everything but id, transform and the per-session flags
+static bool sameState(const SceneObject& a, const SceneObject& b)
+{
+    if (a.name != b.name || a.primId != b.primId || a.mesh != b.mesh ||
+        a.color != b.color || a.gridCell != b.gridCell || a.onGrid != b.onGrid ||
+        a.visible != b.visible ||
+        a.sockets.size() != b.sockets.size())
+        return false;
+    for (size_t i = 0; i < a.sockets.size(); ++i) {
+        const WorldSocket& s = a.sockets[i];
+        const WorldSocket& t = b.sockets[i];
+        if (s.worldPos != t.worldPos || s.worldNorm != t.worldNorm || s.gridDir != t.gridDir ||
+            s.connected != t.connected || s.connectedTo != t.connectedTo)
+            return false;
+    }
+    return true;
+}
+
+SceneObject SceneDelta::stored(const SceneObject& o)
+{
+    SceneObject s = o;
+    s.selected = false;
+    s.hovered  = false;
+    return s;
+}
+
+SceneDelta SceneDelta::diff(const std::vector<SceneObject>& before, const Scene& after)
+{
+    SceneDelta d;
+
+    std::unordered_map<int, const SceneObject*> prev;
+    prev.reserve(before.size());
+    for (const SceneObject& o : before) prev[o.id] = &o;
+
+    const auto& objects = after.objects();
+    for (size_t slot = 0; slot < objects.size(); ++slot) {
+        const SceneObject& o = objects[slot];
+        auto it = prev.find(o.id);
+        if (it == prev.end()) {
+            d.added.push_back(stored(o));
+            d.addedSlots.push_back((uint32_t)slot);
+            continue;
+        }
+
+        const SceneObject& b = *it->second;
+        prev.erase(it);
+        if (!sameState(b, o)) {
+            d.changedBefore.push_back(stored(b));
+            d.changedAfter.push_back(stored(o));
+        } else {
+            d.moved.add(o.id, { b.position, b.rotation, b.scale },
+                              { o.position, o.rotation, o.scale });
+        }
+    }
+
+    // Left over = removed; walk `before` so undo can put them back in their
+    // old slots
+    if (!prev.empty())
+        for (size_t slot = 0; slot < before.size(); ++slot)
+            if (prev.count(before[slot].id)) {
+                d.removed.push_back(stored(before[slot]));
+                d.removedSlots.push_back((uint32_t)slot);
+            }
+
+    d.moved.finish();
+    d.removed.shrink_to_fit();
+    d.added.shrink_to_fit();
+    d.removedSlots.shrink_to_fit();
+    d.addedSlots.shrink_to_fit();
+    d.changedBefore.shrink_to_fit();
+    d.changedAfter.shrink_to_fit();
+    return d;
+}
+
+// Overwrite objects in place by id, keeping their current selection state
+static void restoreState(Scene& scene, const std::vector<SceneObject>& states)
+{
+    for (const SceneObject& s : states) {
+        SceneObject* o = scene.findById(s.id);
+        if (!o) continue;
+        const bool sel = o->selected, hov = o->hovered;
+        *o = s;
+        o->selected = sel;
+        o->hovered  = hov;
+        scene.reindexObject(s.id);
+    }
+    scene.touch();
+}
+
+static std::vector<int> idsOf(const std::vector<SceneObject>& objects)
+{
+    std::vector<int> ids;
+    ids.reserve(objects.size());
+    for (const SceneObject& o : objects) ids.push_back(o.id);
+    return ids;
+}
+
+void SceneDelta::undo(Scene& scene) const
+{
+    scene.removeObjects(idsOf(added));
+    scene.restoreObjects(removed, removedSlots);
+    restoreState(scene, changedBefore);
+    moved.apply(scene, false);
+}
+
+void SceneDelta::redo(Scene& scene) const
+{
+    scene.removeObjects(idsOf(removed));
+    scene.restoreObjects(added, addedSlots);
+    restoreState(scene, changedAfter);
+    moved.apply(scene, true);
+}
+
+bool SceneDelta::empty() const
+{
+    return removed.empty() && added.empty() && changedBefore.empty() && moved.empty();
+}
+
+size_t SceneDelta::bytes() const
+{
+    return Scene::objectsBytes(removed) + Scene::objectsBytes(added)
+         + Scene::objectsBytes(changedBefore) + Scene::objectsBytes(changedAfter)
+         + (removedSlots.size() + addedSlots.size()) * sizeof(uint32_t)
+         + moved.bytes();
+}
+
+Command makeDeltaCommand(std::string name, Scene& scene, SceneDelta delta)
+{
+    auto d = std::make_shared<const SceneDelta>(std::move(delta));
+    const size_t bytes = sizeof(SceneDelta) + d->bytes();
+    return { std::move(name),
+             [&scene, d]() { d->redo(scene); },
+             [&scene, d]() { d->undo(scene); },
+             bytes };
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Scene.h"
+#include "CommandHistory.h"
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// SceneDelta — compact undo records for scene edits
+//
+// Undo entries store what changed, not the scene around it:
+//
+//   TransformDelta  ids plus before/after arrays (struct of arrays) for only
+//                   the channels that moved — a 10k-object drag that only
+//                   translates costs 28 bytes per object
+//   SceneDelta      objects removed / added (full state, needed to bring
+//                   them back), objects whose non-transform state changed
+//                   (before and after), and a TransformDelta for the rest
+//
+// SceneDelta::diff compares a copy of objects() taken before a bulk edit
+// (grammar generation, decode) with the scene after it, so the copy is
+// transient and only the delta is kept in CommandHistory.
+// Stored objects have selected/hovered cleared — selection is not undone.
+// ============================================================
+
+struct TransformDelta
+{
+    struct Trs { glm::vec3 pos, rot, scl; };
+
+    enum Channel : uint8_t { Position = 1, Rotation = 2, Scale = 4 };
+
+    uint8_t                channels = 0;   // set by finish()
+    std::vector<int>       ids;
+    std::vector<glm::vec3> before[3];      // indexed by channel bit: pos, rot, scl
+    std::vector<glm::vec3> after[3];
+
+    // Appends one object; unchanged objects are skipped.
+    void add(int id, const Trs& pre, const Trs& post);
+    // Drops channels nobody changed and trims capacity. Call once after add().
+    void finish();
+
+    void   apply(Scene& scene, bool redo) const;
+    bool   empty() const { return ids.empty(); }
+    size_t bytes() const;
+};
+
+struct SceneDelta
+{
+    std::vector<SceneObject> removed;        // present before, gone after
+    std::vector<SceneObject> added;          // absent before, present after
+    std::vector<uint32_t>    removedSlots;   // diff(): slots of removed in before,
+    std::vector<uint32_t>    addedSlots;     //   of added in after; empty = append
+    std::vector<SceneObject> changedBefore;  // same id, non-transform state changed
+    std::vector<SceneObject> changedAfter;
+    TransformDelta           moved;          // same id, only the transform changed
+
+    static SceneDelta diff(const std::vector<SceneObject>& before, const Scene& after);
+
+    // Copy for storage — clears per-session flags (selected / hovered).
+    static SceneObject stored(const SceneObject& o);
+
+    void   undo(Scene& scene) const;
+    void   redo(Scene& scene) const;
+    bool   empty() const;
+    size_t bytes() const;
+};
+
+// Command over a delta that has already been applied (push(), not execute()).
+// Both lambdas share one copy of the delta.
+Command makeDeltaCommand(std::string name, Scene& scene, SceneDelta delta);
@@ -43,8 +43,11 @@ struct SceneObject {
     // Sockets (world-space connection points)
     std::vector<WorldSocket> sockets;
 
-    // Grid cell (kept for grammar grid lookups; {0,0} if not grammar-placed)
+    // Grid cell (kept for grammar grid lookups). Only objects with onGrid set
+    // — grammar-placed ones — are filed in Scene's grid; imports, pastes and
+    // merges have no cell.
     glm::ivec2  gridCell = {0,0};
+    bool        onGrid   = false;
 
     // State
     bool selected = false;
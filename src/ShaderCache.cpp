@@ -0,0 +1,265 @@
+#include "ShaderCache.h"
+#include "ContentHash.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderCache
+{
+
+namespace {
+
+constexpr uint32_t kMagic         = 0x4353594D;   // "MYSC"
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kMaxBinarySize = 16u << 20;     // far above any real program
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t driverHash;
+    uint32_t count;
+    uint32_t pad;
+};
+
+struct EntryHeader
+{
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+
+struct Binary
+{
+    GLenum               format = 0;
+    std::vector<uint8_t> data;
+    bool                 used   = false;   // built this run — kept by save()
+};
+
+std::string                          s_path;
+uint64_t                             s_driver    = 0;
+bool                                 s_supported = false;
+bool                                 s_dirty     = false;
+int                                  s_loaded    = 0;    // programs from binaries
+int                                  s_compiled  = 0;
+std::unordered_map<uint64_t, Binary> s_binaries;
+
+uint64_t hashString(uint64_t h, const char* s)
+{
+    const size_t n = s ? strlen(s) : 0;
+    h = ContentHash::value(h, (uint64_t)n);
+    return ContentHash::bytes(h, s, n);
+}
+
+uint64_t driverHash()
+{
+    uint64_t h = ContentHash::kSeed;
+    for (GLenum e : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+        h = hashString(h, (const char*)glGetString(e));
+    return h;
+}
+
+GLuint compileShader(GLenum type, const char* src, const char* name)
+{
+    GLuint id = glCreateShader(type);
+    glShaderSource(id, 1, &src, nullptr);
+    glCompileShader(id);
+    GLint ok;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetShaderInfoLog(id, 512, nullptr, log);
+        std::cerr << "[Shader] Compile error in " << name << ":\n" << log << "\n";
+    }
+    return id;
+}
+
+// The driver's binary for key, or 0 if there is none or it was rejected
+GLuint loadBinary(uint64_t key, const char* name)
+{
+    auto it = s_binaries.find(key);
+    if (it == s_binaries.end()) return 0;
+
+    const Binary& b = it->second;
+    GLuint prog = glCreateProgram();
+    glProgramBinary(prog, b.format, b.data.data(), (GLsizei)b.data.size());
+    GLint ok = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        // Allowed at any time, e.g. after a driver setting changed
+        std::cout << "[ShaderCache] Binary for " << name << " rejected — recompiling\n";
+        glDeleteProgram(prog);
+        s_binaries.erase(it);
+        s_dirty = true;
+        return 0;
+    }
+    it->second.used = true;
+    return prog;
+}
+
+void storeBinary(uint64_t key, GLuint prog)
+{
+    GLint length = 0;
+    glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    Binary b;
+    b.data.resize((size_t)length);
+    GLsizei written = 0;
+    glGetProgramBinary(prog, length, &written, &b.format, b.data.data());
+    if (written <= 0) return;
+    b.data.resize((size_t)written);
+    b.used = true;
+    s_binaries[key] = std::move(b);
+    s_dirty = true;
+}
+
+} // namespace
+
+// ============================================================
+// Open / save
+// ============================================================
+
+void open(const std::string& path)
+{
+    s_path = path;
+    s_binaries.clear();
+    s_dirty = false;
+    s_loaded = s_compiled = 0;
+
+    GLint formats = 0;
+    s_supported = glGetProgramBinary && glProgramBinary && glProgramParameteri;
+    if (s_supported) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    s_supported = formats > 0;
+    if (!s_supported) {
+        std::cout << "[ShaderCache] Program binaries not supported — compiling every run\n";
+        return;
+    }
+    s_driver = driverHash();
+
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) {
+        std::cout << "[ShaderCache] No cache at " << path << " — starting empty\n";
+        return;
+    }
+    const std::streamoff fileSize = f.tellg();
+    f.seekg(0);
+    FileHeader hdr{};
+    f.read((char*)&hdr, sizeof(hdr));
+    if (!f || hdr.magic != kMagic || hdr.version != kFormatVersion || hdr.driverHash != s_driver) {
+        std::cout << "[ShaderCache] " << path << " is from another version or driver — ignoring\n";
+        s_dirty = true;   // replace it with ours on save
+        return;
+    }
+
+    for (uint32_t i = 0; i < hdr.count; ++i) {
+        EntryHeader e{};
+        f.read((char*)&e, sizeof(e));
+        // Check the size before allocating for it — a damaged header must
+        // not turn into a multi-gigabyte resize
+        const std::streamoff left = f ? fileSize - (std::streamoff)f.tellg() : 0;
+        bool ok = f && e.size > 0 && e.size <= kMaxBinarySize && (std::streamoff)e.size <= left;
+        Binary b;
+        if (ok) {
+            b.format = e.format;
+            b.data.resize(e.size);
+            ok = (bool)f.read((char*)b.data.data(), (std::streamsize)e.size);
+        }
+        if (!ok) {
+            std::cerr << "[ShaderCache] " << path << " is truncated or damaged — ignoring\n";
+            s_binaries.clear();
+            s_dirty = true;
+            return;
+        }
+        s_binaries[e.key] = std::move(b);
+    }
+    std::cout << "[ShaderCache] " << s_binaries.size() << " program binaries in " << path << "\n";
+}
+
+bool save()
+{
+    if (!s_supported || s_path.empty()) return false;
+
+    // Binaries nobody asked for belong to shaders that have since changed
+    for (auto it = s_binaries.begin(); it != s_binaries.end(); )
+        if (!it->second.used) { it = s_binaries.erase(it); s_dirty = true; }
+        else ++it;
+
+    std::cout << "[ShaderCache] " << s_loaded << " programs from binaries, "
+              << s_compiled << " compiled\n";
+    if (!s_dirty) return true;
+
+    const std::string tmp = s_path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) {
+            std::cerr << "[ShaderCache] Cannot write: " << tmp << "\n";
+            return false;
+        }
+        FileHeader hdr{ kMagic, kFormatVersion, s_driver, (uint32_t)s_binaries.size(), 0 };
+        f.write((const char*)&hdr, sizeof(hdr));
+        for (const auto& [key, b] : s_binaries) {
+            EntryHeader e{ key, (uint32_t)b.format, (uint32_t)b.data.size() };
+            f.write((const char*)&e, sizeof(e));
+            f.write((const char*)b.data.data(), (std::streamsize)b.data.size());
+        }
+        if (!f) {
+            std::cerr << "[ShaderCache] Write failed: " << tmp << "\n";
+            f.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    std::remove(s_path.c_str());
+    if (std::rename(tmp.c_str(), s_path.c_str()) != 0) {
+        std::cerr << "[ShaderCache] Cannot replace: " << s_path << "\n";
+        return false;
+    }
+    s_dirty = false;
+    return true;
+}
+
+// ============================================================
+// Build
+// ============================================================
+
+GLuint buildProgram(const char* vertSrc, const char* fragSrc, const char* name)
+{
+    MYTHOS_PROFILE_SCOPE("ShaderCache::buildProgram");
+
+    uint64_t key = 0;
+    if (s_supported) {
+        key = hashString(hashString(ContentHash::kSeed, vertSrc), fragSrc);
+        if (GLuint prog = loadBinary(key, name)) {
+            ++s_loaded;
+            return prog;
+        }
+    }
+
+    GLuint vert = compileShader(GL_VERTEX_SHADER,   vertSrc, name);
+    GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSrc, name);
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, vert);
+    glAttachShader(prog, frag);
+    if (s_supported) glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(prog);
+    GLint ok;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetProgramInfoLog(prog, 512, nullptr, log);
+        std::cerr << "[Shader] Link error (" << name << "): " << log << "\n";
+    }
+    glDeleteShader(vert);
+    glDeleteShader(frag);
+
+    ++s_compiled;
+    if (ok && s_supported) storeBinary(key, prog);
+    return prog;
+}
+
+} // namespace ShaderCache
@@ -0,0 +1,44 @@
+#pragma once
+#include <glad/glad.h>
+#include <string>
+
+// ============================================================
+// ShaderCache — GL program binaries kept between runs
+//
+//   ShaderCache::open(exeDir() + "editor_shaders.bin");   // after GLAD
+//   GLuint p = ShaderCache::buildProgram(VERT, FRAG, "mesh");
+//   ShaderCache::save();                                  // once init is done
+//
+// Compiling and linking the embedded GLSL is a visible part of startup on
+// Mesa and some Windows drivers. buildProgram() looks the program up by a
+// hash of its two sources and hands the stored glGetProgramBinary blob to
+// glProgramBinary; if there is none, or the driver rejects it, it compiles
+// and links as before and keeps the new binary for save().
+//
+// The file is only valid for the driver that wrote it:
+//
+//   Header   { magic, format version, driver hash, count }
+//   Entry    { source hash, binary format, size, bytes[size] } × count
+//
+// The driver hash covers GL_VENDOR, GL_RENDERER and GL_VERSION, so a driver
+// update or another GPU ignores the whole file. Without program binary
+// support (GL < 4.1 and no ARB_get_program_binary, or no binary formats)
+// every call just compiles. Uniform values and block bindings are not part
+// of a binary — set them after buildProgram() on both paths.
+//
+// Main thread with the context current.
+// ============================================================
+
+namespace ShaderCache
+{
+    // Reads the cache file for the current driver. A missing, truncated,
+    // damaged (entry sizes past the end of the file) or mismatched file
+    // leaves the cache empty.
+    void open(const std::string& path);
+
+    // Linked program (link errors are logged, as for a plain compile).
+    GLuint buildProgram(const char* vertSrc, const char* fragSrc, const char* name);
+
+    // Rewrites the file if buildProgram() compiled anything since open().
+    bool save();
+}
@@ -0,0 +1,416 @@
+#include "SoftwareOcclusion.h"
+#include "Profiler.h"
+#include "Culling.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYTHOS_OCCLUSION_SSE 1
+#endif
+
+static_assert(SoftwareOcclusion::kWidth % 4 == 0, "rows are processed in 4-pixel spans");
+static_assert(SoftwareOcclusion::kWidth  % SoftwareOcclusion::kTileSize == 0, "whole tiles");
+static_assert((SoftwareOcclusion::kHeight / SoftwareOcclusion::kBands)
+              % SoftwareOcclusion::kTileSize == 0, "bands must hold whole tile rows");
+
+// Points closer than this in clip w are treated as crossing the near plane
+static constexpr float kMinW = 1e-3f;
+
+// Relative slack so an object is never hidden by its own rasterised surface
+static constexpr float kDepthBias = 1e-4f;
+
+static constexpr int kTilesX = SoftwareOcclusion::kWidth  / SoftwareOcclusion::kTileSize;
+static constexpr int kTilesY = SoftwareOcclusion::kHeight / SoftwareOcclusion::kTileSize;
+
+// ============================================================
+// Worker pool — a few persistent threads for per-frame fan-out.
+// run() blocks until every index has been processed; the caller works too.
+// ============================================================
+
+namespace {
+
+class WorkerPool
+{
+public:
+    static WorkerPool& instance() { static WorkerPool pool; return pool; }
+
+    void run(int count, const std::function<void(int)>& fn)
+    {
+        if (m_threads.empty() || count <= 1) {
+            for (int i = 0; i < count; ++i) fn(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fn      = &fn;
+            m_count   = count;
+            m_next    = 0;
+            m_pending = (int)m_threads.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        drain();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        m_fn = nullptr;
+    }
+
+private:
+    std::vector<std::thread>        m_threads;
+    std::mutex                      m_mutex;
+    std::condition_variable         m_wake, m_done;
+    const std::function<void(int)>* m_fn = nullptr;
+    std::atomic<int>                m_next{0};
+    int                             m_count      = 0;
+    int                             m_pending    = 0;
+    uint64_t                        m_generation = 0;
+    bool                            m_quit       = false;
+
+    WorkerPool()
+    {
+        unsigned hw = std::thread::hardware_concurrency();
+        int workers = std::min<int>(hw > 1 ? (int)hw - 1 : 0, SoftwareOcclusion::kBands - 1);
+        for (int i = 0; i < workers; ++i)
+            m_threads.emplace_back([this] { MYTHOS_PROFILE_THREAD("Occlusion worker"); loop(); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    void drain()
+    {
+        for (int i = m_next++; i < m_count; i = m_next++)
+            (*m_fn)(i);
+    }
+
+    void loop()
+    {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_quit || m_generation != seen; });
+                if (m_quit) return;
+                seen = m_generation;
+            }
+            drain();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_pending;
+            }
+            m_done.notify_one();
+        }
+    }
+};
+
+} // namespace
+
+// ============================================================
+// Setup
+// ============================================================
+
+SoftwareOcclusion::SoftwareOcclusion()
+    : m_depth((size_t)kWidth * kHeight, 0.f)
+    , m_tileMin((size_t)kTilesX * kTilesY, 0.f)
+{
+}
+
+void SoftwareOcclusion::clear()
+{
+    std::fill(m_depth.begin(),   m_depth.end(),   0.f);
+    std::fill(m_tileMin.begin(), m_tileMin.end(), 0.f);
+    m_tris.clear();
+}
+
+void SoftwareOcclusion::setupTriangles(const std::vector<glm::vec4>& clip)
+{
+    m_tris.clear();
+    m_tris.reserve(clip.size() / 3);
+
+    for (size_t i = 0; i + 2 < clip.size(); i += 3) {
+        const glm::vec4* c = &clip[i];
+
+        // Near-plane crossing — dropping the triangle only loses occlusion
+        if (c[0].w < kMinW || c[1].w < kMinW || c[2].w < kMinW) continue;
+
+        // Trivially outside one side of the frustum
+        if ((c[0].x < -c[0].w && c[1].x < -c[1].w && c[2].x < -c[2].w) ||
+            (c[0].x >  c[0].w && c[1].x >  c[1].w && c[2].x >  c[2].w) ||
+            (c[0].y < -c[0].w && c[1].y < -c[1].w && c[2].y < -c[2].w) ||
+            (c[0].y >  c[0].w && c[1].y >  c[1].w && c[2].y >  c[2].w))
+            continue;
+
+        float x[3], y[3], iw[3];
+        for (int k = 0; k < 3; ++k) {
+            iw[k] = 1.f / c[k].w;
+            x[k]  = (c[k].x * iw[k] * 0.5f + 0.5f) * (float)kWidth;
+            y[k]  = (c[k].y * iw[k] * 0.5f + 0.5f) * (float)kHeight;
+        }
+
+        float area = (x[1]-x[0]) * (y[2]-y[0]) - (x[2]-x[0]) * (y[1]-y[0]);
+        if (std::fabs(area) < 1e-6f) continue;
+        if (area < 0.f) {   // two-sided: flip to counter-clockwise
+            std::swap(x[1], x[2]); std::swap(y[1], y[2]); std::swap(iw[1], iw[2]);
+            area = -area;
+        }
+
+        Tri t;
+        for (int k = 0; k < 3; ++k) {
+            int a = k, b = (k + 1) % 3;
+            t.e[k][0] = -(y[b] - y[a]);
+            t.e[k][1] =  (x[b] - x[a]);
+            t.e[k][2] =  (y[b] - y[a]) * x[a] - (x[b] - x[a]) * y[a];
+        }
+        float inv = 1.f / area;
+        t.z[0] = ((iw[1]-iw[0]) * (y[2]-y[0]) - (iw[2]-iw[0]) * (y[1]-y[0])) * inv;
+        t.z[1] = ((iw[2]-iw[0]) * (x[1]-x[0]) - (iw[1]-iw[0]) * (x[2]-x[0])) * inv;
+        t.z[2] = iw[0] - t.z[0] * x[0] - t.z[1] * y[0];
+
+        t.minX = std::max(0,           (int)std::floor(std::min({x[0], x[1], x[2]})));
+        t.minY = std::max(0,           (int)std::floor(std::min({y[0], y[1], y[2]})));
+        t.maxX = std::min(kWidth  - 1, (int)std::ceil (std::max({x[0], x[1], x[2]})));
+        t.maxY = std::min(kHeight - 1, (int)std::ceil (std::max({y[0], y[1], y[2]})));
+        if (t.minX > t.maxX || t.minY > t.maxY) continue;
+
+        m_tris.push_back(t);
+    }
+}
+
+// ============================================================
+// Rasterisation
+// ============================================================
+
+void SoftwareOcclusion::rasterizeBand(int band)
+{
+    MYTHOS_PROFILE_SCOPE("SoftwareOcclusion::rasterizeBand");
+    const int rowsPerBand = kHeight / kBands;
+    const int y0 = band * rowsPerBand;
+    const int y1 = y0 + rowsPerBand;   // exclusive
+
+    for (const Tri& t : m_tris) {
+        int ya = std::max(t.minY, y0);
+        int yb = std::min(t.maxY, y1 - 1);
+        if (ya > yb) continue;
+
+        int xa = t.minX & ~3;   // 4-aligned spans; kWidth % 4 == 0
+        for (int y = ya; y <= yb; ++y) {
+            float py  = (float)y + 0.5f;
+            float* row = &m_depth[(size_t)y * kWidth];
+            float r0 = t.e[0][1] * py + t.e[0][2];
+            float r1 = t.e[1][1] * py + t.e[1][2];
+            float r2 = t.e[2][1] * py + t.e[2][2];
+            float rz = t.z[1]    * py + t.z[2];
+
+#ifdef MYTHOS_OCCLUSION_SSE
+            const __m128 lane = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 a0 = _mm_set1_ps(t.e[0][0]), a1 = _mm_set1_ps(t.e[1][0]);
+            const __m128 a2 = _mm_set1_ps(t.e[2][0]), az = _mm_set1_ps(t.z[0]);
+            const __m128 zero = _mm_setzero_ps();
+            for (int x = xa; x <= t.maxX; x += 4) {
+                __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane);
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), _mm_set1_ps(r0));
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), _mm_set1_ps(r1));
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), _mm_set1_ps(r2));
+                __m128 in = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero),
+                                                  _mm_cmpge_ps(e1, zero)),
+                                       _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(in) == 0) continue;
+
+                __m128 z   = _mm_add_ps(_mm_mul_ps(az, px), _mm_set1_ps(rz));
+                __m128 cur = _mm_loadu_ps(row + x);
+                __m128 upd = _mm_max_ps(cur, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(in, upd),
+                                                 _mm_andnot_ps(in, cur)));
+            }
+#else
+            for (int x = xa; x <= t.maxX; ++x) {
+                float px = (float)x + 0.5f;
+                if (t.e[0][0] * px + r0 < 0.f) continue;
+                if (t.e[1][0] * px + r1 < 0.f) continue;
+                if (t.e[2][0] * px + r2 < 0.f) continue;
+                float z = t.z[0] * px + rz;
+                if (z > row[x]) row[x] = z;
+            }
+#endif
+        }
+    }
+
+    updateTiles(band);
+}
+
+void SoftwareOcclusion::updateTiles(int band)
+{
+    const int tileRows = kHeight / kBands / kTileSize;
+    for (int ty = band * tileRows; ty < (band + 1) * tileRows; ++ty) {
+        for (int tx = 0; tx < kTilesX; ++tx) {
+            float m = 1e30f;
+            for (int y = ty * kTileSize; y < (ty + 1) * kTileSize; ++y) {
+                const float* row = &m_depth[(size_t)y * kWidth + tx * kTileSize];
+                for (int x = 0; x < kTileSize; ++x) m = std::min(m, row[x]);
+            }
+            m_tileMin[(size_t)ty * kTilesX + tx] = m;
+        }
+    }
+}
+
+void SoftwareOcclusion::rasterizeTriangles(const std::vector<glm::vec4>& clipVerts)
+{
+    setupTriangles(clipVerts);
+    // Bands own disjoint rows — no sharing, and each pixel ends as the max
+    // over all triangles whatever order they were drawn in.
+    WorkerPool::instance().run(kBands, [this](int band) { rasterizeBand(band); });
+}
+
+// ============================================================
+// Testing
+// ============================================================
+
+bool SoftwareOcclusion::isOccluded(const glm::vec3& bmin, const glm::vec3& bmax,
+                                   const glm::mat4& viewProj) const
+{
+    float sx0 = 1e30f, sy0 = 1e30f, sx1 = -1e30f, sy1 = -1e30f;
+    float nearest = 0.f;   // max 1/w over the corners
+
+    for (int k = 0; k < 8; ++k) {
+        glm::vec3 p((k & 1) ? bmax.x : bmin.x,
+                    (k & 2) ? bmax.y : bmin.y,
+                    (k & 4) ? bmax.z : bmin.z);
+        glm::vec4 c = viewProj * glm::vec4(p, 1.f);
+        if (c.w < kMinW) return false;   // camera inside / behind — keep
+        float iw = 1.f / c.w;
+        float x  = (c.x * iw * 0.5f + 0.5f) * (float)kWidth;
+        float y  = (c.y * iw * 0.5f + 0.5f) * (float)kHeight;
+        sx0 = std::min(sx0, x); sx1 = std::max(sx1, x);
+        sy0 = std::min(sy0, y); sy1 = std::max(sy1, y);
+        nearest = std::max(nearest, iw);
+    }
+
+    // One pixel of padding covers centre-sampled occluder edges
+    int x0 = std::max(0,           (int)std::floor(sx0) - 1);
+    int y0 = std::max(0,           (int)std::floor(sy0) - 1);
+    int x1 = std::min(kWidth  - 1, (int)std::ceil (sx1) + 1);
+    int y1 = std::min(kHeight - 1, (int)std::ceil (sy1) + 1);
+    if (x0 > x1 || y0 > y1) return false;   // off-screen — frustum's call
+
+    const float threshold = nearest * (1.f + kDepthBias);
+
+    for (int ty = y0 / kTileSize; ty <= y1 / kTileSize; ++ty) {
+        for (int tx = x0 / kTileSize; tx <= x1 / kTileSize; ++tx) {
+            // Whole tile nearer than the object's nearest point
+            if (m_tileMin[(size_t)ty * kTilesX + tx] > threshold) continue;
+
+            int px0 = std::max(x0, tx * kTileSize), px1 = std::min(x1, (tx + 1) * kTileSize - 1);
+            int py0 = std::max(y0, ty * kTileSize), py1 = std::min(y1, (ty + 1) * kTileSize - 1);
+            for (int y = py0; y <= py1; ++y) {
+                const float* row = &m_depth[(size_t)y * kWidth];
+                for (int x = px0; x <= px1; ++x)
+                    if (row[x] <= threshold) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================
+// Frame entry point
+// ============================================================
+
+void SoftwareOcclusion::cull(const std::vector<SceneObject>& objects,
+                             std::vector<int>& indices,
+                             const OcclusionParams& params,
+                             OcclusionStats* stats)
+{
+    MYTHOS_PROFILE_SCOPE("SoftwareOcclusion::cull");
+    clear();
+    if (indices.empty()) return;
+
+    // ---- 1. Occluder selection by projected AABB area ----
+    struct Candidate { float area; int idx; };
+    std::vector<Candidate> cands;
+
+    for (int idx : indices) {
+        const SceneObject& o = objects[idx];
+        if (!o.mesh) continue;
+        int tris = o.mesh->triangleCount();
+        if (tris == 0 || tris > params.maxOccluderTris) continue;
+
+        glm::vec3 bmin, bmax;
+        SceneCuller::worldAABB(o, bmin, bmax);
+
+        float x0 = 1e30f, y0 = 1e30f, x1 = -1e30f, y1 = -1e30f;
+        bool behind = false;
+        for (int k = 0; k < 8 && !behind; ++k) {
+            glm::vec3 p((k & 1) ? bmax.x : bmin.x,
+                        (k & 2) ? bmax.y : bmin.y,
+                        (k & 4) ? bmax.z : bmin.z);
+            glm::vec4 c = params.viewProj * glm::vec4(p, 1.f);
+            if (c.w < kMinW) { behind = true; break; }
+            float x = std::min(std::max(c.x / c.w, -1.f), 1.f);
+            float y = std::min(std::max(c.y / c.w, -1.f), 1.f);
+            x0 = std::min(x0, x); x1 = std::max(x1, x);
+            y0 = std::min(y0, y); y1 = std::max(y1, y);
+        }
+        if (behind) continue;
+        float area = (x1 - x0) * (y1 - y0) * 0.25f;   // NDC area → screen fraction
+        if (area >= params.minOccluderArea) cands.push_back({ area, idx });
+    }
+
+    std::sort(cands.begin(), cands.end(), [](const Candidate& a, const Candidate& b) {
+        return a.area > b.area || (a.area == b.area && a.idx < b.idx);
+    });
+    if ((int)cands.size() > params.maxOccluders) cands.resize(params.maxOccluders);
+
+    // ---- 2. Transform occluder triangles to clip space ----
+    m_clipScratch.clear();
+    for (const Candidate& c : cands) {
+        const SceneObject& o = objects[c.idx];
+        if (!o.mesh->ensureResident()) continue;   // compressed/evicted copy
+        const MeshData&    d = o.mesh->data;
+        glm::mat4 mvp = params.viewProj * o.transform();
+        for (unsigned int vi : d.indices)
+            m_clipScratch.push_back(mvp * glm::vec4(d.vertices[vi].pos, 1.f));
+    }
+    rasterizeTriangles(m_clipScratch);
+
+    if (stats) {
+        stats->occluders = (int)cands.size();
+        stats->triangles = (int)m_tris.size();
+        stats->tested    = (int)indices.size();
+    }
+    if (m_tris.empty()) return;
+
+    // ---- 3. Test every candidate, in parallel chunks ----
+    const int n = (int)indices.size();
+    m_keep.assign(n, 1);
+    const int chunk = (n + kBands - 1) / kBands;
+    WorkerPool::instance().run(kBands, [&](int part) {
+        int end = std::min(n, (part + 1) * chunk);
+        for (int i = part * chunk; i < end; ++i) {
+            glm::vec3 bmin, bmax;
+            SceneCuller::worldAABB(objects[indices[i]], bmin, bmax);
+            m_keep[i] = isOccluded(bmin, bmax, params.viewProj) ? 0 : 1;
+        }
+    });
+
+    // Compact in place — original order is preserved
+    int w = 0;
+    for (int i = 0; i < n; ++i)
+        if (m_keep[i]) indices[w++] = indices[i];
+    if (stats) stats->occluded = n - w;
+    indices.resize(w);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "SceneObject.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// SoftwareOcclusion — CPU depth buffer for occlusion culling
+//
+// Runs after frustum culling. A handful of large occluders (the objects
+// covering the most screen area, with modest triangle counts — wall tiles,
+// floor slabs) are rasterised into a low-resolution depth buffer, then every
+// remaining candidate's AABB is tested against it:
+//
+//   1. selectOccluders  — rank frustum survivors by projected area
+//   2. rasterise        — screen split into horizontal bands, one band per
+//                         worker; 4-pixel SSE spans of edge functions
+//   3. test             — AABB screen rect vs per-tile minimum depth, then
+//                         per-pixel only for tiles that do not decide it
+//
+// Depth is stored as 1/w (affine in screen space, larger = closer), so the
+// buffer keeps the max over occluders per pixel. max is order-independent,
+// which is what makes the output deterministic regardless of thread count.
+//
+// Conservative by construction: triangles touching the near plane are
+// skipped (less occlusion, never wrong occlusion) and so are AABBs that
+// cross it. GL-free — runs headless.
+// ============================================================
+
+struct OcclusionParams
+{
+    glm::mat4 viewProj = glm::mat4(1.f);
+
+    int   maxOccluders     = 48;
+    int   maxOccluderTris  = 1024;   // skip detailed meshes as occluders
+    float minOccluderArea  = 0.01f;  // fraction of the screen, AABB estimate
+};
+
+struct OcclusionStats
+{
+    int occluders  = 0;
+    int triangles  = 0;   // occluder triangles rasterised
+    int tested     = 0;
+    int occluded   = 0;
+};
+
+class SoftwareOcclusion
+{
+public:
+    static constexpr int kWidth    = 256;
+    static constexpr int kHeight   = 128;
+    static constexpr int kTileSize = 8;
+    static constexpr int kBands    = 8;    // fixed, so work split never varies
+
+    SoftwareOcclusion();
+
+    // Filters `indices` (into objects) in place, keeping order. Candidates
+    // hidden behind the chosen occluders are removed.
+    void cull(const std::vector<SceneObject>& objects,
+              std::vector<int>& indices,
+              const OcclusionParams& params,
+              OcclusionStats* stats = nullptr);
+
+    // Individual stages — exposed for tools and headless tests.
+    void clear();
+    void rasterizeTriangles(const std::vector<glm::vec4>& clipVerts);   // 3 per tri
+    bool isOccluded(const glm::vec3& bmin, const glm::vec3& bmax,
+                    const glm::mat4& viewProj) const;
+
+    const std::vector<float>& depth() const { return m_depth; }
+
+private:
+    // Screen-space triangle after setup — edge functions and 1/w plane
+    struct Tri
+    {
+        float e[3][3];      // a, b, c per edge: a*x + b*y + c >= 0 inside
+        float z[3];         // invW = z0*x + z1*y + z2
+        int   minX, minY, maxX, maxY;
+    };
+
+    std::vector<float> m_depth;     // kWidth * kHeight, 1/w, 0 = empty
+    std::vector<float> m_tileMin;   // per tile: min 1/w (farthest occluder)
+    std::vector<Tri>   m_tris;
+
+    std::vector<glm::vec4> m_clipScratch;
+    std::vector<char>      m_keep;
+
+    void setupTriangles(const std::vector<glm::vec4>& clipVerts);
+    void rasterizeBand(int band);
+    void updateTiles(int band);
+};
@@ -0,0 +1,313 @@
+#include "SoftwareRasterizer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYTHOS_RASTER_SSE 1
+#endif
+
+// Matches THUMB_FRAG / the GL clear in ThumbnailRenderer
+static const glm::vec3 kClearColor   = {0.15f, 0.16f, 0.20f};
+static const glm::vec3 kDefaultColor = {0.75f, 0.78f, 0.85f};
+static const glm::vec3 kLightDir     = glm::normalize(glm::vec3(1.5f, 2.0f, 1.0f));
+
+// Fixed-point edge functions stay within int32 for viewports up to this
+// size with a one-viewport guard band on every side.
+static constexpr int kMaxSize = 512;
+
+static uint32_t packColor(const glm::vec3& c)
+{
+    auto q = [](float v) {
+        v = std::min(std::max(v, 0.f), 1.f);
+        return (uint32_t)(v * 255.f + 0.5f);
+    };
+    return q(c.r) | (q(c.g) << 8) | (q(c.b) << 16);
+}
+
+// ============================================================
+// Camera — shared with ThumbnailRenderer
+// ============================================================
+
+void SoftwareRasterizer::thumbnailCamera(const MeshData& d, const glm::mat4& calib,
+                                         glm::mat4& view, glm::mat4& proj)
+{
+    // Camera: fit the mesh in view using its AABB
+    glm::vec3 centre = d.centre();
+    glm::vec3 size   = d.size();
+
+    // Use the longest axis as radius — guarantees non-zero even for flat tiles
+    float radius = std::max({size.x, size.y, size.z}) * 0.6f;
+    if (radius < 0.01f) radius = 1.f;
+
+    // Apply calibration so the thumbnail matches what you'll see in-scene
+    centre = glm::vec3(calib * glm::vec4(centre, 1.f));
+
+    // Orbit camera — fixed 45°/35°
+    float dist = radius * 2.5f;
+    float yaw  = glm::radians(45.f);
+    float pit  = glm::radians(35.f);
+    glm::vec3 camPos = centre + dist * glm::vec3(
+        std::cos(pit) * std::sin(yaw),
+        std::sin(pit),
+        std::cos(pit) * std::cos(yaw));
+
+    // Safe up vector — if viewing almost straight down, use Z instead
+    glm::vec3 up  = {0,1,0};
+    glm::vec3 fwd = glm::normalize(centre - camPos);
+    if (std::abs(glm::dot(fwd, up)) > 0.99f) up = {0,0,1};
+
+    // Robust near/far — never allow near < 0.001
+    float nearZ = std::max(radius * 0.01f, 0.001f);
+    float farZ  = radius * 15.f;
+
+    view = glm::lookAt(camPos, centre, up);
+    proj = glm::perspective(glm::radians(40.f), 1.f, nearZ, farZ);
+}
+
+SoftwareRasterizer::Image SoftwareRasterizer::renderThumbnail(
+    const MeshData& data, const std::vector<SubMesh>& submeshes,
+    const glm::mat4& calib, int size)
+{
+    SoftwareRasterizer r;
+    r.begin(size, size, kClearColor);
+
+    glm::mat4 view, proj;
+    thumbnailCamera(data, calib, view, proj);
+    glm::mat4 viewProj = proj * view;
+
+    // Degenerate framing (NaN bounds) — leave the cleared image
+    if (!std::isfinite(viewProj[0][0]) || !std::isfinite(viewProj[3][2])) {
+        // fall through to resolve
+    } else if (!submeshes.empty()) {
+        for (const SubMesh& sm : submeshes)
+            r.drawRange(data, viewProj, calib,
+                        sm.indexOffset / (int)sizeof(unsigned int), sm.indexCount, sm.color);
+    } else {
+        r.drawRange(data, viewProj, calib, 0, (int)data.indices.size(), kDefaultColor);
+    }
+
+    Image img;
+    r.resolve(img);
+    return img;
+}
+
+// ============================================================
+// Setup
+// ============================================================
+
+void SoftwareRasterizer::begin(int width, int height, const glm::vec3& clearColor)
+{
+    m_width  = std::min(std::max(width,  1), kMaxSize);
+    m_height = std::min(std::max(height, 1), kMaxSize);
+    m_tilesX = (m_width  + kTileSize - 1) / kTileSize;
+    m_tilesY = (m_height + kTileSize - 1) / kTileSize;
+    m_stride = m_tilesX * kTileSize;
+
+    size_t px = (size_t)m_stride * (size_t)(m_tilesY * kTileSize);
+    m_depth.assign(px, 1.f);                  // far plane in NDC-z/2+0.5 terms
+    m_color.assign(px, packColor(clearColor));
+    m_tris.clear();
+    m_bins.assign((size_t)m_tilesX * m_tilesY, {});
+}
+
+void SoftwareRasterizer::drawRange(const MeshData& data, const glm::mat4& viewProj,
+                                   const glm::mat4& model, int firstIndex,
+                                   int indexCount, const glm::vec3& color)
+{
+    const glm::mat4 mvp = viewProj * model;
+    const glm::mat3 nm  = glm::mat3(glm::transpose(glm::inverse(model)));
+    const float     sub = (float)(1 << kSubpixelBits);
+    const float guardX0 = -(float)m_width,  guardX1 = 2.f * (float)m_width;
+    const float guardY0 = -(float)m_height, guardY1 = 2.f * (float)m_height;
+
+    int end = std::min(firstIndex + indexCount, (int)data.indices.size());
+    for (int i = std::max(firstIndex, 0); i + 2 < end; i += 3) {
+        const MeshVertex* v[3] = { &data.vertices[data.indices[i]],
+                                   &data.vertices[data.indices[i+1]],
+                                   &data.vertices[data.indices[i+2]] };
+
+        // ---- Project ----
+        float sx[3], sy[3], sz[3];
+        bool  reject = false;
+        for (int k = 0; k < 3 && !reject; ++k) {
+            glm::vec4 c = mvp * glm::vec4(v[k]->pos, 1.f);
+            if (c.w <= 1e-6f) { reject = true; break; }
+            float iw = 1.f / c.w;
+            sx[k] = (c.x * iw * 0.5f + 0.5f) * (float)m_width;
+            sy[k] = (c.y * iw * 0.5f + 0.5f) * (float)m_height;
+            sz[k] =  c.z * iw * 0.5f + 0.5f;   // window depth, as GL stores it
+            if (sx[k] < guardX0 || sx[k] > guardX1 || sy[k] < guardY0 || sy[k] > guardY1)
+                reject = true;
+        }
+        if (reject) continue;
+
+        // ---- Snap to 28.4 ----
+        int32_t X[3], Y[3];
+        for (int k = 0; k < 3; ++k) {
+            X[k] = (int32_t)std::lround(sx[k] * sub);
+            Y[k] = (int32_t)std::lround(sy[k] * sub);
+        }
+        int64_t area = (int64_t)(X[1]-X[0]) * (Y[2]-Y[0]) - (int64_t)(X[2]-X[0]) * (Y[1]-Y[0]);
+        if (area == 0) continue;
+
+        // ---- Flat Lambert (world-space face normal, oriented like the vertex normals) ----
+        glm::vec3 w0 = glm::vec3(model * glm::vec4(v[0]->pos, 1.f));
+        glm::vec3 w1 = glm::vec3(model * glm::vec4(v[1]->pos, 1.f));
+        glm::vec3 w2 = glm::vec3(model * glm::vec4(v[2]->pos, 1.f));
+        glm::vec3 fn = glm::cross(w1 - w0, w2 - w0);
+        glm::vec3 vn = nm * (v[0]->normal + v[1]->normal + v[2]->normal);
+        float fl = glm::length(fn);
+        glm::vec3 N;
+        if (fl > 1e-12f) {
+            N = fn / fl;
+            if (glm::dot(N, vn) < 0.f) N = -N;
+        } else {
+            float vl = glm::length(vn);
+            N = vl > 1e-12f ? vn / vl : glm::vec3(0.f, 1.f, 0.f);
+        }
+        float diff = std::max(glm::dot(N, kLightDir), 0.f);
+
+        // Two-sided: order counter-clockwise (y up) so inside ⇔ all edges ≥ 0
+        if (area < 0) {
+            std::swap(X[1], X[2]); std::swap(Y[1], Y[2]); std::swap(sz[1], sz[2]);
+            area = -area;
+        }
+
+        Tri t;
+        t.color = packColor(color * (0.25f + 0.75f * diff));
+        for (int k = 0; k < 3; ++k) {
+            int a = k, b = (k + 1) % 3;
+            int32_t A = Y[a] - Y[b];
+            int32_t B = X[b] - X[a];
+            int64_t C = -((int64_t)A * X[a] + (int64_t)B * Y[a]);
+            // Top-left rule: pixels exactly on other edges belong to the neighbour
+            bool topLeft = A > 0 || (A == 0 && B < 0);
+            t.a[k] = A;
+            t.b[k] = B;
+            t.c[k] = (int32_t)(C - (topLeft ? 0 : 1));
+        }
+
+        // Depth plane in pixel units
+        float fx[3], fy[3];
+        for (int k = 0; k < 3; ++k) { fx[k] = (float)X[k] / sub; fy[k] = (float)Y[k] / sub; }
+        float fa = (fx[1]-fx[0]) * (fy[2]-fy[0]) - (fx[2]-fx[0]) * (fy[1]-fy[0]);
+        float inv = 1.f / fa;
+        t.za = ((sz[1]-sz[0]) * (fy[2]-fy[0]) - (sz[2]-sz[0]) * (fy[1]-fy[0])) * inv;
+        t.zb = ((sz[2]-sz[0]) * (fx[1]-fx[0]) - (sz[1]-sz[0]) * (fx[2]-fx[0])) * inv;
+        t.zc = sz[0] - t.za * fx[0] - t.zb * fy[0];
+
+        int minXf = std::min({X[0], X[1], X[2]}), maxXf = std::max({X[0], X[1], X[2]});
+        int minYf = std::min({Y[0], Y[1], Y[2]}), maxYf = std::max({Y[0], Y[1], Y[2]});
+        t.minX = std::max(0,            minXf >> kSubpixelBits);
+        t.minY = std::max(0,            minYf >> kSubpixelBits);
+        t.maxX = std::min(m_width  - 1, maxXf >> kSubpixelBits);
+        t.maxY = std::min(m_height - 1, maxYf >> kSubpixelBits);
+        if (t.minX > t.maxX || t.minY > t.maxY) continue;
+
+        // ---- Bin ----
+        int idx = (int)m_tris.size();
+        m_tris.push_back(t);
+        for (int ty = t.minY / kTileSize; ty <= t.maxY / kTileSize; ++ty)
+            for (int tx = t.minX / kTileSize; tx <= t.maxX / kTileSize; ++tx)
+                m_bins[(size_t)ty * m_tilesX + tx].push_back(idx);
+    }
+}
+
+// ============================================================
+// Rasterisation
+// ============================================================
+
+void SoftwareRasterizer::rasterTile(int tx, int ty)
+{
+    const int tileX0 = tx * kTileSize, tileY0 = ty * kTileSize;
+    const int tileX1 = std::min(tileX0 + kTileSize, m_width)  - 1;
+    const int tileY1 = std::min(tileY0 + kTileSize, m_height) - 1;
+    const int32_t step = 1 << kSubpixelBits;
+    const int32_t half = step >> 1;
+
+    for (int ti : m_bins[(size_t)ty * m_tilesX + tx]) {
+        const Tri& t = m_tris[ti];
+        int x0 = std::max(t.minX, tileX0) & ~3;   // tile starts are 4-aligned
+        int x1 = std::min(t.maxX, tileX1);
+        int y0 = std::max(t.minY, tileY0);
+        int y1 = std::min(t.maxY, tileY1);
+
+        for (int y = y0; y <= y1; ++y) {
+            const int32_t py = y * step + half;
+            float*    drow = &m_depth[(size_t)y * m_stride];
+            uint32_t* crow = &m_color[(size_t)y * m_stride];
+            const float zrow = t.zb * ((float)y + 0.5f) + t.zc;
+
+#ifdef MYTHOS_RASTER_SSE
+            const __m128i s0 = _mm_setr_epi32(0, t.a[0] * step, 2 * t.a[0] * step, 3 * t.a[0] * step);
+            const __m128i s1 = _mm_setr_epi32(0, t.a[1] * step, 2 * t.a[1] * step, 3 * t.a[1] * step);
+            const __m128i s2 = _mm_setr_epi32(0, t.a[2] * step, 2 * t.a[2] * step, 3 * t.a[2] * step);
+            const __m128  lane = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128  za   = _mm_set1_ps(t.za);
+            const __m128  zr   = _mm_set1_ps(zrow);
+            const __m128i col  = _mm_set1_epi32((int)t.color);
+
+            for (int x = x0; x <= x1; x += 4) {
+                const int32_t px = x * step + half;
+                __m128i e0 = _mm_add_epi32(_mm_set1_epi32(t.a[0] * px + t.b[0] * py + t.c[0]), s0);
+                __m128i e1 = _mm_add_epi32(_mm_set1_epi32(t.a[1] * px + t.b[1] * py + t.c[1]), s1);
+                __m128i e2 = _mm_add_epi32(_mm_set1_epi32(t.a[2] * px + t.b[2] * py + t.c[2]), s2);
+                // Inside ⇔ no edge negative ⇔ sign bit of the OR is clear
+                __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), e2);
+                __m128i in  = _mm_cmpgt_epi32(_mm_set1_epi32(0), any);   // negative lanes
+                in = _mm_xor_si128(in, _mm_set1_epi32(-1));
+                if (_mm_movemask_epi8(in) == 0) continue;
+
+                __m128 z    = _mm_add_ps(_mm_mul_ps(za, _mm_add_ps(_mm_set1_ps((float)x), lane)), zr);
+                __m128 zold = _mm_loadu_ps(drow + x);
+                __m128 pass = _mm_and_ps(_mm_castsi128_ps(in), _mm_cmplt_ps(z, zold));
+                _mm_storeu_ps(drow + x, _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, zold)));
+
+                __m128i passi = _mm_castps_si128(pass);
+                __m128i cold  = _mm_loadu_si128((const __m128i*)(crow + x));
+                _mm_storeu_si128((__m128i*)(crow + x),
+                                 _mm_or_si128(_mm_and_si128(passi, col),
+                                              _mm_andnot_si128(passi, cold)));
+            }
+#else
+            for (int x = x0; x <= x1; ++x) {
+                const int32_t px = x * step + half;
+                if (t.a[0] * px + t.b[0] * py + t.c[0] < 0) continue;
+                if (t.a[1] * px + t.b[1] * py + t.c[1] < 0) continue;
+                if (t.a[2] * px + t.b[2] * py + t.c[2] < 0) continue;
+                float z = t.za * ((float)x + 0.5f) + zrow;
+                if (z < drow[x]) { drow[x] = z; crow[x] = t.color; }
+            }
+#endif
+        }
+    }
+}
+
+void SoftwareRasterizer::flush()
+{
+    for (int ty = 0; ty < m_tilesY; ++ty)
+        for (int tx = 0; tx < m_tilesX; ++tx)
+            rasterTile(tx, ty);
+    m_tris.clear();
+    for (auto& b : m_bins) b.clear();
+}
+
+void SoftwareRasterizer::resolve(Image& out)
+{
+    flush();
+    out.width  = m_width;
+    out.height = m_height;
+    out.rgb.resize((size_t)m_width * m_height * 3);
+    uint8_t* dst = out.rgb.data();
+    for (int y = 0; y < m_height; ++y) {
+        const uint32_t* row = &m_color[(size_t)y * m_stride];
+        for (int x = 0; x < m_width; ++x) {
+            uint32_t c = row[x];
+            *dst++ = (uint8_t)( c        & 0xFF);
+            *dst++ = (uint8_t)((c >> 8)  & 0xFF);
+            *dst++ = (uint8_t)((c >> 16) & 0xFF);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "MeshAsset.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// SoftwareRasterizer — headless triangle rasteriser for thumbnails
+//
+// Renders MeshData into an RGB8 image with the same framing and shading as
+// ThumbnailRenderer (fixed orbit camera, flat Lambert, same light, same
+// clear colour), without a GL context — so thumbnails can be produced on
+// worker threads and only the pixel upload touches GL.
+//
+//   - screen coordinates snapped to 28.4 fixed point
+//   - integer edge functions with a top-left fill rule, stepped 4 pixels at
+//     a time with SSE2 (scalar fallback)
+//   - float z-buffer, GL_LESS semantics
+//   - triangles binned into kTileSize² tiles, rasterised tile by tile
+//
+// Output is byte-deterministic: no threading inside a render, triangle order
+// is preserved per tile, and coverage is exact integer arithmetic. Rows are
+// stored bottom-up like a GL framebuffer, so atlas UVs are unchanged.
+// GL-free apart from MeshAsset's header types.
+// ============================================================
+
+class SoftwareRasterizer
+{
+public:
+    static constexpr int kTileSize    = 32;
+    static constexpr int kSubpixelBits = 4;
+
+    struct Image
+    {
+        int width  = 0;
+        int height = 0;
+        std::vector<uint8_t> rgb;   // width * height * 3, bottom row first
+    };
+
+    // Shared with ThumbnailRenderer so both paths frame identically.
+    static void thumbnailCamera(const MeshData& data, const glm::mat4& calib,
+                                glm::mat4& view, glm::mat4& proj);
+
+    // Full thumbnail: clear, draw every submesh (or the default colour),
+    // resolve. Safe to call concurrently on separate rasteriser instances.
+    static Image renderThumbnail(const MeshData& data,
+                                 const std::vector<SubMesh>& submeshes,
+                                 const glm::mat4& calib, int size);
+
+    // ---- Lower-level interface ----
+    void begin(int width, int height, const glm::vec3& clearColor);
+    // Draw an index range (flat Lambert, two-sided — no face culling, as GL).
+    void drawRange(const MeshData& data, const glm::mat4& viewProj,
+                   const glm::mat4& model, int firstIndex, int indexCount,
+                   const glm::vec3& color);
+    void resolve(Image& out);
+
+private:
+    struct Tri
+    {
+        int32_t  a[3], b[3], c[3];   // edge functions in 28.4 (c incl. fill bias)
+        float    za, zb, zc;         // z = za*x + zb*y + zc (pixel units)
+        uint32_t color;              // packed 0x00BBGGRR
+        int      minX, minY, maxX, maxY;
+    };
+
+    int m_width = 0, m_height = 0;
+    int m_stride = 0;                // padded to a whole number of tiles
+    int m_tilesX = 0, m_tilesY = 0;
+
+    std::vector<float>    m_depth;
+    std::vector<uint32_t> m_color;
+    std::vector<Tri>      m_tris;
+    std::vector<std::vector<int>> m_bins;   // per tile, triangle indices in order
+
+    void flush();
+    void rasterTile(int tx, int ty);
+};
@@ -0,0 +1,176 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+
+// ============================================================
+// Morton helpers
+// ============================================================
+
+static uint64_t spreadBits(uint32_t v)
+{
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x <<  8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x <<  4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x <<  2)) & 0x3333333333333333ULL;
+    x = (x | (x <<  1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+static uint32_t compactBits(uint64_t x)
+{
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >>  1)) & 0x3333333333333333ULL;
+    x = (x | (x >>  2)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >>  4)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >>  8)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t)x;
+}
+
+uint64_t SpatialGrid::mortonEncode(uint32_t x, uint32_t y)
+{
+    return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+void SpatialGrid::mortonDecode(uint64_t code, uint32_t& x, uint32_t& y)
+{
+    x = compactBits(code);
+    y = compactBits(code >> 1);
+}
+
+// Chunk coordinates are signed; bias them into unsigned space so that
+// neighbouring chunks across the origin still get neighbouring codes.
+uint64_t SpatialGrid::chunkKey(glm::ivec2 chunk)
+{
+    return mortonEncode((uint32_t)chunk.x ^ 0x80000000u,
+                        (uint32_t)chunk.y ^ 0x80000000u);
+}
+
+int SpatialGrid::localIndex(glm::ivec2 cell)
+{
+    return (int)mortonEncode((uint32_t)(cell.x & kChunkMask),
+                             (uint32_t)(cell.y & kChunkMask));
+}
+
+// ============================================================
+// Maintenance
+// ============================================================
+
+SpatialGrid::Chunk* SpatialGrid::findChunk(glm::ivec2 chunk)
+{
+    auto it = m_chunks.find(chunkKey(chunk));
+    return (it != m_chunks.end()) ? it->second.get() : nullptr;
+}
+
+const SpatialGrid::Chunk* SpatialGrid::findChunk(glm::ivec2 chunk) const
+{
+    auto it = m_chunks.find(chunkKey(chunk));
+    return (it != m_chunks.end()) ? it->second.get() : nullptr;
+}
+
+void SpatialGrid::insert(glm::ivec2 cell, int id)
+{
+    glm::ivec2 cc = chunkOf(cell);
+    auto& slot = m_chunks[chunkKey(cc)];
+    if (!slot) {
+        slot = std::make_unique<Chunk>();
+        slot->coord = cc;
+    }
+    slot->cells[localIndex(cell)].push_back(id);
+    ++slot->count;
+    ++m_count;
+}
+
+bool SpatialGrid::remove(glm::ivec2 cell, int id)
+{
+    glm::ivec2 cc = chunkOf(cell);
+    auto it = m_chunks.find(chunkKey(cc));
+    if (it == m_chunks.end()) return false;
+
+    Chunk& c = *it->second;
+    auto& ids = c.cells[localIndex(cell)];
+    auto pos = std::find(ids.begin(), ids.end(), id);
+    if (pos == ids.end()) return false;
+
+    // Keep insertion order — objectAtCell() reports the most recent entry
+    ids.erase(pos);
+    --c.count;
+    --m_count;
+
+    // Drop empty chunks so the table tracks the live footprint
+    if (c.count == 0) m_chunks.erase(it);
+    return true;
+}
+
+void SpatialGrid::move(glm::ivec2 from, glm::ivec2 to, int id)
+{
+    if (from == to) return;
+    remove(from, id);
+    insert(to, id);
+}
+
+void SpatialGrid::clear()
+{
+    m_chunks.clear();
+    m_count = 0;
+}
+
+void SpatialGrid::reserve(size_t cellCount)
+{
+    // Assume moderately dense layouts — a quarter of each chunk occupied
+    size_t chunks = cellCount / (kChunkCells / 4) + 1;
+    m_chunks.reserve(chunks);
+}
+
+// ============================================================
+// Queries
+// ============================================================
+
+const std::vector<int>* SpatialGrid::objectsAt(glm::ivec2 cell) const
+{
+    const Chunk* c = findChunk(chunkOf(cell));
+    if (!c) return nullptr;
+    const auto& ids = c->cells[localIndex(cell)];
+    return ids.empty() ? nullptr : &ids;
+}
+
+void SpatialGrid::visitChunk(const Chunk& c, glm::ivec2 lo, glm::ivec2 hi,
+                             const std::function<void(glm::ivec2, int)>& fn) const
+{
+    glm::ivec2 base = c.coord * kChunkSize;
+    for (int i = 0; i < kChunkCells; ++i) {
+        const auto& ids = c.cells[i];
+        if (ids.empty()) continue;
+        uint32_t lx, ly;
+        mortonDecode((uint64_t)i, lx, ly);
+        glm::ivec2 cell = base + glm::ivec2((int)lx, (int)ly);
+        if (cell.x < lo.x || cell.y < lo.y || cell.x > hi.x || cell.y > hi.y)
+            continue;
+        for (int id : ids) fn(cell, id);
+    }
+}
+
+void SpatialGrid::queryRange(glm::ivec2 lo, glm::ivec2 hi,
+                             const std::function<void(glm::ivec2, int)>& fn) const
+{
+    if (lo.x > hi.x || lo.y > hi.y || m_chunks.empty()) return;
+
+    glm::ivec2 c0 = chunkOf(lo);
+    glm::ivec2 c1 = chunkOf(hi);
+    long long spanned = (long long)(c1.x - c0.x + 1) * (long long)(c1.y - c0.y + 1);
+
+    if (spanned <= (long long)m_chunks.size()) {
+        // Small window — probe each covered chunk directly
+        for (int cy = c0.y; cy <= c1.y; ++cy)
+            for (int cx = c0.x; cx <= c1.x; ++cx)
+                if (const Chunk* c = findChunk({cx, cy}))
+                    visitChunk(*c, lo, hi, fn);
+    } else {
+        // Window larger than the populated world — walk the live chunks
+        for (const auto& [key, c] : m_chunks) {
+            if (c->coord.x < c0.x || c->coord.y < c0.y ||
+                c->coord.x > c1.x || c->coord.y > c1.y) continue;
+            visitChunk(*c, lo, hi, fn);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================
+// SpatialGrid — hashed sparse grid of object ids
+//
+// The world is split into square chunks of kChunkSize × kChunkSize cells.
+// Chunks live in a hash map keyed by the Morton (Z-order) code of their
+// chunk coordinate, so only populated regions cost memory and a cell lookup
+// is one hash probe plus an array index. Inside a chunk the cells are stored
+// in Morton order, which keeps 2D-adjacent cells close in memory for
+// neighbourhood / range queries.
+//
+// Each cell holds a small list of ids (several objects may share a cell).
+// The grid is maintained incrementally — insert/remove/move touch only the
+// cells involved — so it never needs a full rebuild while editing.
+// ============================================================
+
+class SpatialGrid
+{
+public:
+    static constexpr int kChunkBits = 4;                       // 16×16 cells per chunk
+    static constexpr int kChunkSize = 1 << kChunkBits;
+    static constexpr int kChunkMask = kChunkSize - 1;
+    static constexpr int kChunkCells = kChunkSize * kChunkSize;
+
+    // --- Incremental maintenance ---
+    void insert(glm::ivec2 cell, int id);
+    bool remove(glm::ivec2 cell, int id);            // false if id was not in cell
+    void move  (glm::ivec2 from, glm::ivec2 to, int id);
+    void clear ();
+
+    // Pre-size the chunk table for roughly `cellCount` occupied cells.
+    void reserve(size_t cellCount);
+
+    // --- Queries ---
+    // Ids in a cell, in insertion order. Returns nullptr for an empty cell.
+    const std::vector<int>* objectsAt(glm::ivec2 cell) const;
+
+    // Visit every (cell, id) inside the inclusive rectangle [lo, hi].
+    // Cells are visited chunk by chunk, Morton order within a chunk.
+    void queryRange(glm::ivec2 lo, glm::ivec2 hi,
+                    const std::function<void(glm::ivec2 cell, int id)>& fn) const;
+
+    size_t chunkCount()  const { return m_chunks.size(); }
+    size_t objectCount() const { return m_count; }
+
+    // --- Morton helpers (also useful for other spatial structures) ---
+    // Interleave the bits of two 32-bit values: x in even bits, y in odd bits.
+    static uint64_t mortonEncode(uint32_t x, uint32_t y);
+    static void     mortonDecode(uint64_t code, uint32_t& x, uint32_t& y);
+
+    // Chunk coordinate containing `cell` (floor division, handles negatives).
+    static glm::ivec2 chunkOf(glm::ivec2 cell)
+    {
+        return { cell.x >> kChunkBits, cell.y >> kChunkBits };
+    }
+
+private:
+    struct Chunk
+    {
+        glm::ivec2 coord = {0,0};
+        int        count = 0;                               // ids across all cells
+        std::array<std::vector<int>, kChunkCells> cells;    // Morton-ordered
+    };
+
+    // Hash for Morton keys — the low bits of a Morton code are highly
+    // regular, so mix before handing them to the bucket modulo.
+    struct KeyHash
+    {
+        size_t operator()(uint64_t k) const
+        {
+            k ^= k >> 33; k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return (size_t)k;
+        }
+    };
+
+    std::unordered_map<uint64_t, std::unique_ptr<Chunk>, KeyHash> m_chunks;
+    size_t m_count = 0;
+
+    static uint64_t chunkKey(glm::ivec2 chunk);
+    static int      localIndex(glm::ivec2 cell);
+
+    Chunk*       findChunk(glm::ivec2 chunk);
+    const Chunk* findChunk(glm::ivec2 chunk) const;
+    void visitChunk(const Chunk& c, glm::ivec2 lo, glm::ivec2 hi,
+                    const std::function<void(glm::ivec2, int)>& fn) const;
+};
@@ -0,0 +1,261 @@
+#include "StaticBatcher.h"
+#include "Profiler.h"
+#include "ContentHash.h"
+#include "MeshMerge.h"
+#include "Scene.h"
+#include "SpatialGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// ============================================================
+// Hashing / partitioning
+// ============================================================
+
+uint64_t StaticBatcher::hashObject(uint64_t h, const SceneObject& o)
+{
+    const MeshAsset* mesh = o.mesh.get();
+    h = ContentHash::bytes(h, &o.id,       sizeof(o.id));
+    h = ContentHash::bytes(h, &o.position, sizeof(o.position));
+    h = ContentHash::bytes(h, &o.rotation, sizeof(o.rotation));
+    h = ContentHash::bytes(h, &o.scale,    sizeof(o.scale));
+    h = ContentHash::bytes(h, &o.color,    sizeof(o.color));
+    h = ContentHash::bytes(h, &mesh,       sizeof(mesh));
+    if (mesh) h = ContentHash::value(h, mesh->revision);   // lazily loaded contents
+    return h;
+}
+
+// Meshes whose CPU data could not be restored stay loose — the GPU copy
+// still draws, but there is nothing to merge.
+static bool isBatchable(const SceneObject& o)
+{
+    return o.visible && o.mesh && !o.mesh->restoreFailed && o.mesh->triangleCount() > 0;
+}
+
+static uint64_t chunkKey(const glm::vec3& p)
+{
+    int cx = (int)std::floor(p.x / StaticBatcher::kChunkSize);
+    int cz = (int)std::floor(p.z / StaticBatcher::kChunkSize);
+    return SpatialGrid::mortonEncode((uint32_t)cx ^ 0x80000000u,
+                                     (uint32_t)cz ^ 0x80000000u);
+}
+
+void StaticBatcher::partition(const Scene& scene)
+{
+    const auto& objects = scene.objects();
+    m_objectCount = objects.size();
+
+    for (auto& [key, c] : m_chunks) c.slots.clear();
+    for (int i = 0; i < (int)objects.size(); ++i)
+        if (isBatchable(objects[i]))
+            m_chunks[chunkKey(objects[i].position)].slots.push_back(i);
+
+    for (auto it = m_chunks.begin(); it != m_chunks.end(); ) {
+        Chunk& c = it->second;
+        if (c.slots.empty()) {
+            // Never block on a job here — park it until it finishes
+            if (c.building) m_orphans.push_back(std::move(c.job));
+            it = m_chunks.erase(it);
+            continue;
+        }
+        uint64_t h = ContentHash::kSeed;
+        for (int slot : c.slots) h = hashObject(h, objects[slot]);
+        c.hash = h;
+        ++it;
+    }
+}
+
+// ============================================================
+// Background merge
+// ============================================================
+
+bool StaticBatcher::launch(const Scene& scene, uint64_t key, Chunk& c)
+{
+    const auto& objects = scene.objects();
+
+    // Workers read mesh data — inflate compressed/evicted copies here. A
+    // mesh that cannot be restored is now rejected by isBatchable(), so
+    // re-partition instead of merging a chunk with a hole in it.
+    for (int slot : c.slots) {
+        const SceneObject& o = objects[slot];
+        if (!o.mesh->ensureResident()) {
+            std::cerr << "[StaticBatcher] Mesh data unavailable for '" << o.name
+                      << "' — left unbatched\n";
+            m_sceneVersion = ~0ull;
+            return false;
+        }
+    }
+
+    c.job.input = std::make_unique<std::vector<SceneObject>>();
+    c.job.input->reserve(c.slots.size());
+    for (int slot : c.slots) c.job.input->push_back(objects[slot]);
+    c.job.hash = c.hash;
+    c.building = true;
+
+    const std::vector<SceneObject>* input = c.job.input.get();
+    std::string name = "chunk:" + std::to_string(key);
+
+    c.job.result = std::async(std::launch::async, [input, name]() {
+        std::vector<const SceneObject*> ptrs;
+        ptrs.reserve(input->size());
+        for (const SceneObject& o : *input) ptrs.push_back(&o);
+
+        Build b;
+        const SceneObject& first = input->front();
+        b.color = first.mesh->submeshes.empty() ? first.color
+                                                : first.mesh->submeshes[0].color;
+
+        MeshMerge::Result res = MeshMerge::merge(ptrs, name);
+        MeshMerge::coalesceSubmeshes(res.asset->data, res.asset->submeshes);
+        MeshMerge::weld(res.asset->data, res.asset->submeshes);
+        b.asset = std::move(res.asset);
+        return b;
+    });
+    return true;
+}
+
+template <class T>
+static bool ready(const std::future<T>& f)
+{
+    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void StaticBatcher::update(const Scene& scene)
+{
+    MYTHOS_PROFILE_SCOPE("StaticBatcher::update");
+    if (scene.version() != m_sceneVersion) {
+        partition(scene);
+        m_sceneVersion = scene.version();
+        m_outputDirty  = true;
+    }
+
+    retireOrphans();
+
+    // ---- Collect finished merges; upload on this (GL) thread ----
+    int uploads  = 0;
+    int inFlight = 0;
+    for (auto& [key, c] : m_chunks) {
+        if (!c.building) continue;
+        if (uploads >= kUploadsPerFrame || !ready(c.job.result)) { ++inFlight; continue; }
+
+        Build b = c.job.result.get();
+        c.building = false;
+        uint64_t builtFrom = c.job.hash;
+        c.job.input.reset();
+
+        // Contents moved on while merging — result is stale, rebuild below
+        if (builtFrom != c.hash) continue;
+
+        // Nothing drawable came out — remember that, or it would be retried
+        // every frame; the chunk's objects simply stay loose.
+        if (!b.asset || !b.asset->upload()) b.asset.reset();
+
+        c.mesh      = std::move(b.asset);
+        c.color     = b.color;
+        c.builtHash = builtFrom;
+        m_outputDirty = true;
+        ++uploads;
+    }
+
+    // ---- Launch merges for dirty chunks ----
+    for (auto& [key, c] : m_chunks) {
+        if (inFlight >= kMaxInFlight) break;
+        if (c.building || c.hash == c.builtHash) continue;
+        if (!launch(scene, key, c)) break;   // re-partitioned next update
+        ++inFlight;
+    }
+
+    if (m_outputDirty) rebuildOutput();
+}
+
+// ============================================================
+// Output
+// ============================================================
+
+void StaticBatcher::rebuildOutput()
+{
+    m_outputDirty = false;
+    m_chunkObjects.clear();
+    m_batched.assign(m_objectCount, 0);
+
+    for (auto& [key, c] : m_chunks) {
+        // A batch built from older contents would draw stale geometry —
+        // its objects stay loose until the rebuild lands.
+        if (!c.mesh || c.builtHash != c.hash) continue;
+
+        SceneObject o;
+        o.name   = c.mesh->name;
+        o.primId = c.mesh->name;
+        o.mesh   = c.mesh;
+        o.color  = c.color;
+        m_chunkObjects.push_back(std::move(o));
+
+        for (int slot : c.slots) m_batched[slot] = 1;
+    }
+    ++m_version;
+}
+
+int StaticBatcher::pendingCount() const
+{
+    int n = 0;
+    for (const auto& [key, c] : m_chunks)
+        if (c.hash != c.builtHash) ++n;
+    return n;
+}
+
+bool StaticBatcher::busy() const
+{
+    for (const auto& [key, c] : m_chunks)
+        if (c.building && !ready(c.job.result)) return true;
+    for (const auto& j : m_orphans)
+        if (!ready(j.result)) return true;
+    return false;
+}
+
+void StaticBatcher::retireOrphans()
+{
+    for (auto it = m_orphans.begin(); it != m_orphans.end(); ) {
+        if (ready(it->result)) { it->result.get(); it = m_orphans.erase(it); }
+        else ++it;
+    }
+}
+
+void StaticBatcher::waitAll()
+{
+    for (auto& [key, c] : m_chunks)
+        if (c.building) { c.job.result.wait(); c.building = false; }
+    for (auto& j : m_orphans) j.result.wait();
+    m_orphans.clear();
+}
+
+void StaticBatcher::clear()
+{
+    waitAll();
+    m_chunks.clear();
+    m_chunkObjects.clear();
+    m_batched.clear();
+    m_objectCount  = 0;
+    m_sceneVersion = ~0ull;
+    ++m_version;
+}
+
+void StaticBatcher::release()
+{
+    retireOrphans();
+    if (m_chunks.empty() && m_chunkObjects.empty()) return;
+
+    for (auto& [key, c] : m_chunks)
+        if (c.building) m_orphans.push_back(std::move(c.job));
+    m_chunks.clear();                 // chunk meshes and their GPU buffers
+    m_chunkObjects.clear();
+    m_batched.clear();
+    m_objectCount  = 0;
+    m_sceneVersion = ~0ull;
+    ++m_version;
+}
+
+StaticBatcher::~StaticBatcher()
+{
+    waitAll();
+}
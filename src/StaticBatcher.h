@@ -0,0 +1,118 @@
+#pragma once
+#include "SceneObject.h"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Scene;
+
+// ============================================================
+// StaticBatcher — merged per-chunk meshes for PLAY mode
+//
+// Static scene objects are partitioned into kChunkSize × kChunkSize world
+// chunks on XZ. Each chunk is merged (MeshMerge::merge), its submeshes
+// coalesced per colour and welded, giving one mesh whose draws are one per
+// material — so PLAY mode submits a few hundred chunk draws regardless of
+// object count.
+//
+// Merging runs on std::async workers over copies of the chunk's objects;
+// upload happens on the main thread in poll(). Each chunk carries a content
+// hash (ids, transforms, colours, meshes) and is only re-merged when the hash
+// changes. Objects whose chunk has no current batch yet are reported as
+// loose and drawn individually, so the view is never missing geometry.
+//
+// The scene objects themselves are never modified — EDITOR mode keeps
+// editing them as usual.
+// ============================================================
+
+class StaticBatcher
+{
+public:
+    static constexpr float kChunkSize     = 16.f;
+    static constexpr int   kMaxInFlight   = 4;     // concurrent merge jobs
+    static constexpr int   kUploadsPerFrame = 8;
+
+    ~StaticBatcher();
+
+    // Re-partition when the scene version changed, launch merges for dirty
+    // chunks and upload finished ones. Call once per frame while batching.
+    void update(const Scene& scene);
+
+    // Drop all batches and wait for outstanding jobs.
+    void clear();
+
+    // Drop all batches without blocking: running jobs are parked and retired
+    // by later calls. Call once per frame while not batching (PLAY left or
+    // batching turned off) — cheap once everything is gone.
+    void release();
+
+    // One identity-transform object per ready chunk — feed to the culler
+    // and Renderer::drawScene like scene objects.
+    const std::vector<SceneObject>& chunkObjects() const { return m_chunkObjects; }
+
+    // Per scene-object slot: 1 if drawn by a current chunk batch.
+    const std::vector<char>& batchedMask() const { return m_batched; }
+
+    // Bumped whenever chunkObjects() or batchedMask() change.
+    uint64_t version() const { return m_version; }
+
+    int chunkCount()   const { return (int)m_chunks.size(); }
+    int pendingCount() const;
+
+    // A merge job is still running (orphaned ones included) — workers read
+    // the scene objects' mesh data until then.
+    bool busy() const;
+
+private:
+    // Worker output. The merged asset is created off-thread but only ever
+    // uploaded and destroyed on the main thread.
+    struct Build
+    {
+        std::shared_ptr<MeshAsset> asset;
+        glm::vec3 color = {0.8f, 0.8f, 0.8f};   // used when submeshes collapse
+    };
+
+    // Object copies a job reads. Owned outside the job so the shared mesh
+    // references are never released on a worker thread.
+    using JobInput = std::unique_ptr<std::vector<SceneObject>>;
+
+    struct Job
+    {
+        std::future<Build> result;
+        JobInput           input;
+        uint64_t           hash = 0;
+    };
+
+    struct Chunk
+    {
+        std::vector<int> slots;        // scene object slots, ascending
+        uint64_t hash      = 0;        // content hash of slots' objects
+        uint64_t builtHash = 0;        // hash the current mesh was built from
+        std::shared_ptr<MeshAsset> mesh;
+        glm::vec3 color    = {0.8f, 0.8f, 0.8f};
+
+        bool building = false;
+        Job  job;
+    };
+
+    std::unordered_map<uint64_t, Chunk> m_chunks;   // Morton chunk key → chunk
+    std::vector<Job>                    m_orphans;  // jobs of chunks that vanished
+    size_t                              m_objectCount = 0;
+    std::vector<SceneObject>            m_chunkObjects;
+    std::vector<char>                   m_batched;
+
+    uint64_t m_sceneVersion = ~0ull;
+    uint64_t m_version      = 0;
+    bool     m_outputDirty  = false;
+
+    void partition(const Scene& scene);
+    // false if a mesh's data could not be restored (nothing launched)
+    bool launch(const Scene& scene, uint64_t key, Chunk& c);
+    void retireOrphans();
+    void waitAll();
+    void rebuildOutput();
+
+    static uint64_t hashObject(uint64_t h, const SceneObject& o);
+};
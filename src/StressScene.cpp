@@ -0,0 +1,173 @@
+#include "StressScene.h"
+#include "Scene.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// ---- Deterministic hashing -------------------------------------------------
+
+static inline uint32_t mix32(uint32_t h)
+{
+    h ^= h >> 16; h *= 0x7FEB352Du;
+    h ^= h >> 15; h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline float unit(uint32_t h) { return (float)(mix32(h) >> 8) * (1.f / 16777216.f); }
+
+struct Lcg {
+    uint32_t s;
+    explicit Lcg(uint32_t seed) : s(mix32(seed) | 1u) {}
+    uint32_t next()        { s = s * 1664525u + 1013904223u; return mix32(s); }
+    int      range(int n)  { return (int)(next() % (uint32_t)n); }
+    float    unitf()       { return (float)(next() >> 8) * (1.f / 16777216.f); }
+};
+
+// ============================================================
+// Mesh pool
+// ============================================================
+
+// One box face: pos = origin + u·a + v·b, a,b ∈ [0,1], u × v = normal (CCW out)
+struct BoxFace { glm::vec3 origin, u, v, n; };
+
+static const BoxFace kFaces[6] = {
+    {{ 0.5f,-0.5f,-0.5f}, {0,1,0}, {0,0,1}, { 1, 0, 0}},
+    {{-0.5f,-0.5f,-0.5f}, {0,0,1}, {0,1,0}, {-1, 0, 0}},
+    {{-0.5f, 0.5f,-0.5f}, {0,0,1}, {1,0,0}, { 0, 1, 0}},
+    {{-0.5f,-0.5f,-0.5f}, {1,0,0}, {0,0,1}, { 0,-1, 0}},
+    {{-0.5f,-0.5f, 0.5f}, {1,0,0}, {0,1,0}, { 0, 0, 1}},
+    {{-0.5f,-0.5f,-0.5f}, {0,1,0}, {1,0,0}, { 0, 0,-1}},
+};
+
+static std::shared_ptr<MeshAsset> makeStressMesh(int index, int segs, uint32_t seed)
+{
+    auto asset  = std::make_shared<MeshAsset>();
+    asset->name = "stress:" + std::to_string(index);
+
+    MeshData& d = asset->data;
+    d.vertices.reserve((size_t)6 * (segs + 1) * (segs + 1));
+    d.indices.reserve((size_t)36 * segs * segs);
+
+    const uint32_t meshSeed = mix32(seed * 0x9E3779B9u + (uint32_t)index);
+    for (const BoxFace& f : kFaces) {
+        const unsigned int base = (unsigned int)d.vertices.size();
+        for (int b = 0; b <= segs; ++b)
+            for (int a = 0; a <= segs; ++a) {
+                const float fa = (float)a / segs, fb = (float)b / segs;
+                glm::vec3 p = f.origin + f.u * fa + f.v * fb;
+                // Radial bump keyed on the quantised position, so vertices on
+                // shared box edges move together and the shell stays closed
+                const uint32_t q = mix32((uint32_t)(int)std::lround(p.x * 1024.f) * 73856093u ^
+                                         (uint32_t)(int)std::lround(p.y * 1024.f) * 19349663u ^
+                                         (uint32_t)(int)std::lround(p.z * 1024.f) * 83492791u);
+                p *= 1.f + 0.15f * (unit(q ^ meshSeed) - 0.5f);
+
+                MeshVertex v;
+                v.pos    = p;
+                v.normal = f.n;
+                v.uv     = { fa, fb };
+                d.vertices.push_back(v);
+            }
+        for (int b = 0; b < segs; ++b)
+            for (int a = 0; a < segs; ++a) {
+                const unsigned int i00 = base + b * (segs + 1) + a;
+                const unsigned int i10 = i00 + 1;
+                const unsigned int i01 = i00 + (segs + 1);
+                const unsigned int i11 = i01 + 1;
+                d.indices.insert(d.indices.end(), { i00, i10, i11, i00, i11, i01 });
+            }
+    }
+    d.computeAABB();
+    return asset;
+}
+
+std::vector<std::shared_ptr<MeshAsset>> StressScene::buildMeshes(const StressSceneParams& p)
+{
+    const int count  = std::max(p.objectCount, 1);
+    const int segs   = std::clamp(p.meshSegments, 1, 64);
+    const float inst = std::clamp(p.instancingRatio, 0.f, 1.f);
+    const int unique = std::clamp((int)std::lround(count * (1.0 - inst)), 1, count);
+
+    std::vector<std::shared_ptr<MeshAsset>> meshes;
+    meshes.reserve(unique);
+    for (int i = 0; i < unique; ++i)
+        meshes.push_back(makeStressMesh(i, segs, p.seed));
+    return meshes;
+}
+
+// ============================================================
+// Scene population
+// ============================================================
+
+StressSceneStats StressScene::populate(Scene& scene, const StressSceneParams& p)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    StressSceneStats st;
+    const int count   = std::max(p.objectCount, 1);
+    const int sockets = std::clamp(p.socketsPerObject, 0, 4);
+    const int spacing = std::max(p.spacing, 1);
+    const int side    = (int)std::ceil(std::sqrt((double)count));
+
+    auto meshes = buildMeshes(p);
+    for (auto& m : meshes) m->upload();
+
+    scene.clear();
+    scene.reserve(count);
+
+    static const glm::ivec2 kDirs[4] = { {1,0}, {0,1}, {-1,0}, {0,-1} };
+    Lcg rng(p.seed);
+
+    for (int i = 0; i < count; ++i) {
+        const glm::ivec2 gridPos = { i % side, i / side };
+        const glm::ivec2 cell    = gridPos * spacing;
+        const float      scale   = 0.6f + 0.4f * rng.unitf();
+
+        SceneObject& o = scene.addObject();
+        o.name     = "Stress_" + std::to_string(o.id);
+        o.primId   = "stress";
+        // The first `unique` objects take one mesh each, the rest are instances
+        o.mesh     = meshes[i < (int)meshes.size() ? i : rng.range((int)meshes.size())];
+        o.gridCell = cell;
+        o.onGrid   = true;
+        o.position = { (float)cell.x * kGridCell, 0.5f * scale, (float)cell.y * kGridCell };
+        o.rotation = { 0.f, 90.f * rng.range(4), 0.f };
+        o.scale    = glm::vec3(scale);
+        o.color    = { 0.35f + 0.5f * rng.unitf(), 0.35f + 0.5f * rng.unitf(),
+                       0.35f + 0.5f * rng.unitf() };
+
+        const int first = rng.range(4);
+        for (int k = 0; k < sockets; ++k) {
+            const glm::ivec2 dir = kDirs[(first + k) % 4];
+            const glm::ivec2 nb  = gridPos + dir;
+            const int        j   = nb.y * side + nb.x;
+
+            WorldSocket s;
+            s.gridDir   = dir;
+            s.worldNorm = { (float)dir.x, 0.f, (float)dir.y };
+            s.worldPos  = o.position + s.worldNorm * (0.5f * scale);
+            if (nb.x >= 0 && nb.x < side && nb.y >= 0 && j < count) {
+                s.connected   = true;
+                s.connectedTo = j;
+            }
+            o.sockets.push_back(s);
+        }
+
+        st.triangles += o.mesh->triangleCount();
+        st.sockets   += sockets;
+    }
+    scene.rebuildCellMap();
+    scene.touch();
+
+    st.objects = count;
+    st.meshes  = (int)meshes.size();
+    st.buildMs = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "[StressScene] " << st.objects << " objects, " << st.meshes
+              << " meshes, " << st.triangles << " tris, " << st.sockets
+              << " sockets in " << st.buildMs << " ms\n";
+    return st;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "MeshAsset.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Scene;
+
+// ============================================================
+// StressScene — deterministic synthetic scenes for profiling
+//
+// Fills a Scene with objectCount objects on a square grid. Each object uses
+// one of a pool of procedurally displaced, subdivided boxes:
+//   meshSegments    — subdivisions per box edge (12·s² triangles per mesh)
+//   instancingRatio — fraction of objects that reuse an existing mesh;
+//                     1.0 = every object shares one mesh, 0.0 = all unique
+//   socketsPerObject— WorldSockets per object (0–4, one per grid direction),
+//                     linked to the neighbour in that direction when present
+//
+// Same params + seed ⇒ identical scene, so benchmark runs are comparable.
+// Windows → Stress Scene in the editor, or --objects/--segments/… on the
+// command line (see BenchmarkMode).
+// ============================================================
+
+struct StressSceneParams {
+    int      objectCount      = 10000;
+    int      meshSegments     = 4;
+    float    instancingRatio  = 0.95f;
+    int      socketsPerObject = 2;
+    int      spacing          = 2;      // grid cells between neighbours
+    uint32_t seed             = 1;
+};
+
+struct StressSceneStats {
+    int     objects   = 0;
+    int     meshes    = 0;      // unique MeshAssets
+    int64_t triangles = 0;      // summed over objects (what a full draw submits)
+    int     sockets   = 0;
+    double  buildMs   = 0.0;    // CPU generation + upload
+};
+
+namespace StressScene
+{
+    // CPU-only: the unique mesh pool for these params (not uploaded).
+    std::vector<std::shared_ptr<MeshAsset>> buildMeshes(const StressSceneParams& p);
+
+    // Replaces the scene contents. Uploads the meshes — main thread only.
+    StressSceneStats populate(Scene& scene, const StressSceneParams& p);
+}
@@ -0,0 +1,90 @@
+#include "ThumbnailAtlas.h"
+#include <iostream>
+
+// ============================================================
+// Pages
+// ============================================================
+
+bool ThumbnailAtlas::addPage()
+{
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    if (!tex) return false;
+
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, kPageSize, kPageSize, 0,
+                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    int page = (int)m_pages.size();
+    m_pages.push_back(tex);
+    m_mem.set(m_pages.size() * (size_t)kPageSize * kPageSize * 3);
+
+    // Push in reverse so slot 0 is handed out first (rows fill top-down)
+    for (int s = kSlotsPerPage - 1; s >= 0; --s)
+        m_free.push_back(page * kSlotsPerPage + s);
+
+    std::cout << "[ThumbnailAtlas] Page " << page << " created ("
+              << kPageSize << "x" << kPageSize << ", " << kSlotsPerPage << " slots)\n";
+    return true;
+}
+
+void ThumbnailAtlas::shutdown()
+{
+    if (!m_pages.empty())
+        glDeleteTextures((GLsizei)m_pages.size(), m_pages.data());
+    m_pages.clear();
+    m_mem.set(0);
+    m_free.clear();
+    m_used = 0;
+}
+
+// ============================================================
+// Slots
+// ============================================================
+
+bool ThumbnailAtlas::allocate(int& page, int& slot)
+{
+    if (m_free.empty() && !addPage()) return false;
+    int code = m_free.back();
+    m_free.pop_back();
+    page = code / kSlotsPerPage;
+    slot = code % kSlotsPerPage;
+    ++m_used;
+    return true;
+}
+
+void ThumbnailAtlas::release(int page, int slot)
+{
+    if (page < 0 || page >= (int)m_pages.size() || slot < 0) return;
+    m_free.push_back(page * kSlotsPerPage + slot);
+    --m_used;
+}
+
+GLuint ThumbnailAtlas::pageTexture(int page) const
+{
+    return (page >= 0 && page < (int)m_pages.size()) ? m_pages[page] : 0;
+}
+
+void ThumbnailAtlas::slotOrigin(int slot, int& x, int& y)
+{
+    x = (slot % kSlotsPerRow) * kSlotSize;
+    y = (slot / kSlotsPerRow) * kSlotSize;
+}
+
+void ThumbnailAtlas::slotUV(int slot, glm::vec2& uv0, glm::vec2& uv1)
+{
+    int x, y;
+    slotOrigin(slot, x, y);
+    const float inv = 1.f / (float)kPageSize;
+    float u0 = ((float)x + 0.5f) * inv;
+    float u1 = ((float)(x + kSlotSize) - 0.5f) * inv;
+    float vb = ((float)y + 0.5f) * inv;                   // bottom row of the copy
+    float vt = ((float)(y + kSlotSize) - 0.5f) * inv;     // top row
+    uv0 = { u0, vt };
+    uv1 = { u1, vb };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <glad/glad.h>
+#include "MemoryStats.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+// ============================================================
+// ThumbnailAtlas — fixed-size thumbnail slots packed into shared pages
+//
+// Each page is one GL_TEXTURE_2D of kPageSize² texels split into a grid of
+// kSlotSize² slots. Pages are allocated on demand; freed slots are reused
+// before a new page is created. Thousands of assets therefore cost a handful
+// of textures instead of one each.
+//
+// Pages are plain 2D textures (not a GL_TEXTURE_2D_ARRAY) because ImGui's
+// OpenGL backend binds every ImTextureID as GL_TEXTURE_2D.
+// ============================================================
+
+class ThumbnailAtlas
+{
+public:
+    static constexpr int kSlotSize     = 128;
+    static constexpr int kPageSize     = 2048;
+    static constexpr int kSlotsPerRow  = kPageSize / kSlotSize;
+    static constexpr int kSlotsPerPage = kSlotsPerRow * kSlotsPerRow;
+
+    void shutdown();
+
+    // Reserve a slot, creating a page if all are full. false on GL failure.
+    bool allocate(int& page, int& slot);
+    void release(int page, int slot);
+
+    GLuint pageTexture(int page) const;
+    int    pageCount() const { return (int)m_pages.size(); }
+    int    usedSlots() const { return m_used; }
+
+    // Texel origin of a slot within its page
+    static void slotOrigin(int slot, int& x, int& y);
+
+    // ImGui::Image UVs (top-left, bottom-right) for a slot, inset by half a
+    // texel so linear filtering never samples a neighbour. V is flipped —
+    // the slot holds an FBO copy, which is stored bottom-up.
+    static void slotUV(int slot, glm::vec2& uv0, glm::vec2& uv1);
+
+private:
+    std::vector<GLuint> m_pages;
+    MemoryStats::Tracked m_mem { MemTag::Thumbnails };   // RGB8 page storage
+    std::vector<int>    m_free;   // page * kSlotsPerPage + slot
+    int                 m_used = 0;
+
+    bool addPage();
+};
@@ -0,0 +1,238 @@
+#include "ThumbnailCache.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace
+{
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotSize;
+        uint32_t count;
+    };
+}
+
+std::string ThumbnailCache::pathFor(const std::string& jsonPath)
+{
+    size_t slash = jsonPath.find_last_of("/\\");
+    std::string dir = (slash == std::string::npos) ? "" : jsonPath.substr(0, slash + 1);
+    return dir + "editor_thumbs.bin";
+}
+
+// ============================================================
+// Mapping
+// ============================================================
+
+bool ThumbnailCache::mapFile(const std::string& path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!map) { CloseHandle(file); return false; }
+
+    void* view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(map); CloseHandle(file); return false; }
+
+    m_hFile = file;
+    m_hMap  = map;
+    m_base  = (const uint8_t*)view;
+    m_size  = (size_t)size.QuadPart;
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+
+    m_base = (const uint8_t*)view;
+    m_size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+void ThumbnailCache::unmapFile()
+{
+    if (!m_base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    if (m_hMap)  CloseHandle((HANDLE)m_hMap);
+    if (m_hFile) CloseHandle((HANDLE)m_hFile);
+    m_hMap = m_hFile = nullptr;
+#else
+    munmap((void*)m_base, m_size);
+#endif
+    m_base = nullptr;
+    m_size = 0;
+}
+
+// ============================================================
+// Open / close
+// ============================================================
+
+bool ThumbnailCache::open(const std::string& path, int slotSize)
+{
+    close();
+    m_path      = path;
+    m_slotSize  = slotSize;
+    m_slotBytes = (size_t)slotSize * (size_t)slotSize * 3;
+
+    if (!mapFile(path)) {
+        std::cout << "[ThumbnailCache] No cache at " << path << " — starting empty\n";
+        return false;
+    }
+
+    FileHeader hdr;
+    if (m_size < sizeof(hdr)) { unmapFile(); return false; }
+    std::memcpy(&hdr, m_base, sizeof(hdr));
+
+    if (hdr.magic != kMagic || hdr.version != kFormatVersion ||
+        hdr.slotSize != (uint32_t)slotSize) {
+        std::cout << "[ThumbnailCache] " << path << " is from another version — ignoring\n";
+        unmapFile();
+        return false;
+    }
+
+    const size_t keysBytes = (size_t)hdr.count * sizeof(uint64_t);
+    const size_t need      = sizeof(hdr) + keysBytes + (size_t)hdr.count * m_slotBytes;
+    if (m_size < need) {
+        std::cerr << "[ThumbnailCache] " << path << " is truncated — ignoring\n";
+        unmapFile();
+        return false;
+    }
+
+    const uint8_t* keys   = m_base + sizeof(hdr);
+    const uint8_t* pixels = keys + keysBytes;
+    m_index.reserve(hdr.count);
+    for (uint32_t i = 0; i < hdr.count; ++i) {
+        uint64_t key;
+        std::memcpy(&key, keys + i * sizeof(uint64_t), sizeof(key));
+        m_index[key] = pixels + (size_t)i * m_slotBytes;
+    }
+
+    std::cout << "[ThumbnailCache] Mapped " << hdr.count << " thumbnails from " << path << "\n";
+    return true;
+}
+
+void ThumbnailCache::close()
+{
+    m_index.clear();
+    m_pending.clear();
+    unmapFile();
+}
+
+// ============================================================
+// Lookup / store
+// ============================================================
+
+const uint8_t* ThumbnailCache::find(uint64_t key) const
+{
+    auto p = m_pending.find(key);
+    if (p != m_pending.end()) return p->second.data();
+    auto m = m_index.find(key);
+    return (m != m_index.end()) ? m->second : nullptr;
+}
+
+void ThumbnailCache::store(uint64_t key, const uint8_t* rgb)
+{
+    if (!rgb || m_slotBytes == 0) return;
+    m_pending[key].assign(rgb, rgb + m_slotBytes);
+}
+
+// ============================================================
+// Save
+// ============================================================
+
+// Swap `from` in for `to` in one step — the old file stays in place if this
+// fails. std::rename already replaces on POSIX, but not on Windows.
+static bool replaceFile(const std::string& from, const std::string& to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+bool ThumbnailCache::save(const std::vector<uint64_t>& liveKeys)
+{
+    if (m_path.empty() || m_slotBytes == 0) return false;
+
+    // Unique keys that we actually hold pixels for, in the caller's order
+    std::vector<uint64_t>        keys;
+    std::unordered_set<uint64_t> seen;
+    for (uint64_t k : liveKeys)
+        if (find(k) && seen.insert(k).second) keys.push_back(k);
+
+    // Written beside the live file while it is still mapped, then swapped in
+    const std::string tmp = m_path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) {
+            std::cerr << "[ThumbnailCache] Cannot write: " << tmp << "\n";
+            return false;
+        }
+        FileHeader hdr{ kMagic, kFormatVersion, (uint32_t)m_slotSize, (uint32_t)keys.size() };
+        f.write((const char*)&hdr, sizeof(hdr));
+        if (!keys.empty())
+            f.write((const char*)keys.data(), (std::streamsize)(keys.size() * sizeof(uint64_t)));
+        for (uint64_t k : keys)
+            f.write((const char*)find(k), (std::streamsize)m_slotBytes);
+        if (!f) {
+            std::cerr << "[ThumbnailCache] Write failed: " << tmp << "\n";
+            f.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    // The old mapping must go before the replace (Windows refuses to replace
+    // a mapped file); reopen afterwards so find() keeps working. Renders not
+    // yet on disk are only dropped once the new file is in place — on
+    // failure the old file is mapped again and they stay pending.
+    const std::string path = m_path;
+    const int slotSize     = m_slotSize;
+    auto pending = std::move(m_pending);
+    close();
+    if (!replaceFile(tmp, path)) {
+        std::cerr << "[ThumbnailCache] Cannot replace: " << path << "\n";
+        std::remove(tmp.c_str());
+        open(path, slotSize);
+        m_pending = std::move(pending);
+        return false;
+    }
+
+    std::cout << "[ThumbnailCache] Saved " << keys.size() << " thumbnails to " << path << "\n";
+    open(path, slotSize);
+    return true;
+}
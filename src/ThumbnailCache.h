@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================
+// ThumbnailCache — persistent thumbnail pixels, one packed file
+//
+// Stored as editor_thumbs.bin next to editor_assets.json:
+//
+//   Header   { magic, format version, slot size, count }
+//   uint64   keys[count]
+//   uint8    pixels[count][slotSize * slotSize * 3]   RGB8, bottom row first
+//
+// The file is memory-mapped on open (mmap / CreateFileMapping) and only the
+// key table is read eagerly; pixels are paged in by the OS as thumbnails are
+// uploaded. New renders are kept in memory until save(), which rewrites the
+// file with the keys still in use — stale thumbnails are dropped there.
+//
+// Keys are ThumbnailRenderer::cacheKey(): mesh content hash + calibration +
+// renderer version, so any change to what a thumbnail would look like
+// misses the cache instead of showing an old image. GL-free.
+// ============================================================
+
+class ThumbnailCache
+{
+public:
+    static constexpr uint32_t kMagic         = 0x4854594D;   // "MYTH"
+    static constexpr uint32_t kFormatVersion = 1;
+
+    ThumbnailCache() = default;
+    ~ThumbnailCache() { close(); }
+    ThumbnailCache(const ThumbnailCache&)            = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // editor_assets.json → editor_thumbs.bin in the same directory
+    static std::string pathFor(const std::string& libraryJsonPath);
+
+    // Map an existing cache file. A missing, truncated or mismatched file
+    // (other slot size / format) leaves the cache empty; returns false.
+    bool open(const std::string& path, int slotSize);
+    void close();
+
+    // Pixels for key (slotSize² RGB8) or nullptr. Valid until the next
+    // store()/save()/close().
+    const uint8_t* find(uint64_t key) const;
+    void           store(uint64_t key, const uint8_t* rgb);
+
+    // Rewrite the file with only the given keys (those found in the cache).
+    bool save(const std::vector<uint64_t>& liveKeys);
+
+    int count() const { return (int)(m_index.size() + m_pending.size()); }
+
+private:
+    std::string m_path;
+    int         m_slotSize = 0;
+    size_t      m_slotBytes = 0;
+
+    // Mapping of the file as opened
+    const uint8_t* m_base = nullptr;
+    size_t         m_size = 0;
+    void*          m_hFile = nullptr;   // Win32 handles; unused on POSIX
+    void*          m_hMap  = nullptr;
+
+    std::unordered_map<uint64_t, const uint8_t*>       m_index;     // key → mapped pixels
+    std::unordered_map<uint64_t, std::vector<uint8_t>> m_pending;   // stored since open
+
+    bool mapFile(const std::string& path);
+    void unmapFile();
+};
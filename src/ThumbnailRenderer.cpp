@@ -1,9 +1,13 @@
 #include "ThumbnailRenderer.h"
+#include "Profiler.h"
+#include "ContentHash.h"
+#include "ShaderCache.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 
 // ---- Embedded shaders ------------------------------------------------------
 
@@ -29,7 +33,10 @@ in vec3 vPos;
 uniform vec3 uColor;
 out vec4 FragColor;
 void main() {
-    vec3 N = normalize(vNormal);
+    // Flat face normal, oriented like the interpolated vertex normal — the
+    // same shading SoftwareRasterizer uses, so both paths look identical.
+    vec3 N = normalize(cross(dFdx(vPos), dFdy(vPos)));
+    if (dot(N, vNormal) < 0.0) N = -N;
     vec3 L = normalize(vec3(1.5, 2.0, 1.0));
     float diff = max(dot(N, L), 0.0);
     vec3 col = uColor * (0.25 + 0.75 * diff);
@@ -37,45 +44,22 @@ void main() {
 }
 )GLSL";
 
-// ---- Shader helper ---------------------------------------------------------
-
-static GLuint compileShader(GLenum type, const char* src)
-{
-    GLuint s = glCreateShader(type);
-    glShaderSource(s, 1, &src, nullptr);
-    glCompileShader(s);
-    GLint ok; glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
-    if (!ok) {
-        char log[512]; glGetShaderInfoLog(s, 512, nullptr, log);
-        std::cerr << "[ThumbnailRenderer] Shader error: " << log << "\n";
-    }
-    return s;
-}
-
-static GLuint buildProgram(const char* vert, const char* frag)
-{
-    GLuint vs = compileShader(GL_VERTEX_SHADER,   vert);
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, frag);
-    GLuint p  = glCreateProgram();
-    glAttachShader(p, vs); glAttachShader(p, fs);
-    glLinkProgram(p);
-    glDeleteShader(vs); glDeleteShader(fs);
-    return p;
-}
-
 // ============================================================
 // Init / shutdown
 // ============================================================
 
 bool ThumbnailRenderer::init()
 {
-    m_shader = buildProgram(THUMB_VERT, THUMB_FRAG);
+    m_shader   = ShaderCache::buildProgram(THUMB_VERT, THUMB_FRAG, "thumbnail");
+    m_locMVP   = glGetUniformLocation(m_shader, "uMVP");
+    m_locModel = glGetUniformLocation(m_shader, "uModel");
+    m_locColor = glGetUniformLocation(m_shader, "uColor");
 
     // FBO
     glGenFramebuffers(1, &m_fbo);
     glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
 
-    // Colour attachment (scratch — will be replaced per asset)
+    // Colour attachment — scratch target, copied into the atlas per asset
     glGenTextures(1, &m_colorTex);
     glBindTexture(GL_TEXTURE_2D, m_colorTex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SIZE, SIZE, 0,
@@ -92,6 +76,9 @@ bool ThumbnailRenderer::init()
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
                               GL_RENDERBUFFER, m_rbo);
 
+    // RGB8 colour + 24-bit depth (usually padded to 32)
+    m_targetMem.set((size_t)SIZE * SIZE * (3 + 4));
+
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         std::cerr << "[ThumbnailRenderer] FBO incomplete\n";
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -105,25 +92,137 @@ bool ThumbnailRenderer::init()
 
 void ThumbnailRenderer::shutdown()
 {
+    m_softJobs.clear();   // joins outstanding workers
     if (m_fbo)      { glDeleteFramebuffers(1,  &m_fbo);      m_fbo      = 0; }
     if (m_rbo)      { glDeleteRenderbuffers(1, &m_rbo);      m_rbo      = 0; }
     if (m_colorTex) { glDeleteTextures(1,      &m_colorTex); m_colorTex = 0; }
+    m_targetMem.set(0);
     if (m_shader)   { glDeleteProgram(m_shader);              m_shader   = 0; }
+    m_atlas.shutdown();
 }
 
 // ============================================================
-// ensureTexture — allocate or reuse the per-asset texture
+// Software path
 // ============================================================
 
-void ThumbnailRenderer::ensureTexture(GLuint& tex)
+int ThumbnailRenderer::maxSoftJobs()
 {
-    if (tex) return;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SIZE, SIZE, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    unsigned hw = std::thread::hardware_concurrency();
+    return std::min(std::max((int)hw - 1, 1), 8);
+}
+
+bool ThumbnailRenderer::queueSoftware(AssetEntry& entry)
+{
+    if (!entry.mesh || entry.mesh->data.indices.empty()) return false;
+    if ((int)m_softJobs.size() >= maxSoftJobs()) return false;
+    for (const SoftJob& j : m_softJobs)
+        if (j.launchedBy(entry)) return false;   // already rendering
+
+    SoftJob job;
+    job.mesh  = entry.mesh;   // keeps the data alive; released on this thread
+    job.name  = entry.name;
+    job.calib = entry.calibMatrix();
+    job.key   = cacheKey(entry);
+
+    const MeshAsset*     mesh  = entry.mesh.get();
+    std::vector<SubMesh> subs  = entry.mesh->submeshes;
+    glm::mat4            calib = job.calib;
+    job.image = std::async(std::launch::async, [mesh, subs, calib]() {
+        return SoftwareRasterizer::renderThumbnail(mesh->data, subs, calib, SIZE);
+    });
+
+    m_softJobs.push_back(std::move(job));
+    entry.thumbDirty = false;
+    return true;
+}
+
+int ThumbnailRenderer::collectSoftware(std::vector<AssetEntry>& entries)
+{
+    MYTHOS_PROFILE_SCOPE("ThumbnailRenderer::collectSoftware");
+    int uploaded = 0;
+    for (auto it = m_softJobs.begin(); it != m_softJobs.end(); ) {
+        if (it->image.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        SoftwareRasterizer::Image img = it->image.get();
+
+        // The entry may have been removed while its job ran, or recalibrated
+        // (it is dirty again then and re-queues once this job is gone)
+        AssetEntry* entry = nullptr;
+        for (auto& e : entries)
+            if (it->launchedBy(e)) { entry = &e; break; }
+
+        if (entry && entry->calibMatrix() != it->calib) entry = nullptr;
+        if (img.width != SIZE || img.height != SIZE) entry = nullptr;
+        if (entry && uploadPixels(*entry, img.rgb.data())) {
+            entry->thumbKey = it->key;
+            if (m_cache && it->key) m_cache->store(it->key, img.rgb.data());
+            ++uploaded;
+        }
+        it = m_softJobs.erase(it);
+    }
+    return uploaded;
+}
+
+bool ThumbnailRenderer::uploadPixels(AssetEntry& entry, const uint8_t* rgb)
+{    if (entry.thumbSlot < 0 && !m_atlas.allocate(entry.thumbPage, entry.thumbSlot)) {
+        std::cerr << "[ThumbnailRenderer] Atlas allocation failed for '" << entry.name << "'\n";
+        return false;
+    }
+
+    int sx, sy;
+    ThumbnailAtlas::slotOrigin(entry.thumbSlot, sx, sy);
+
+    GLint prevAlign;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevAlign);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, m_atlas.pageTexture(entry.thumbPage));
+    // Rows are bottom-up like the FBO copy, so the slot UVs are unchanged
+    glTexSubImage2D(GL_TEXTURE_2D, 0, sx, sy, SIZE, SIZE,
+                    GL_RGB, GL_UNSIGNED_BYTE, rgb);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, prevAlign);
+
+    entry.thumbnailTex = m_atlas.pageTexture(entry.thumbPage);
+    ThumbnailAtlas::slotUV(entry.thumbSlot, entry.thumbUV0, entry.thumbUV1);
+    return true;
+}
+
+void ThumbnailRenderer::releaseThumbnail(AssetEntry& entry)
+{
+    if (entry.thumbSlot >= 0) m_atlas.release(entry.thumbPage, entry.thumbSlot);
+    entry.thumbPage    = -1;
+    entry.thumbSlot    = -1;
+    entry.thumbnailTex = 0;
+    entry.thumbKey     = 0;
+    entry.thumbDirty   = true;
+}
+
+// ============================================================
+// Cache
+// ============================================================
+
+uint64_t ThumbnailRenderer::cacheKey(const AssetEntry& entry)
+{
+    if (entry.contentHash == 0) return 0;   // unknown content — never cached
+    uint64_t h = ContentHash::kSeed;
+    h = ContentHash::value(h, entry.contentHash);
+    h = ContentHash::mat4(h, entry.calibMatrix());
+    h = ContentHash::value(h, kVersion);
+    h = ContentHash::value(h, (uint32_t)SIZE);
+    return h;
+}
+
+bool ThumbnailRenderer::restoreCached(AssetEntry& entry)
+{
+    uint64_t key = cacheKey(entry);
+    if (!m_cache || key == 0) return false;
+    const uint8_t* rgb = m_cache->find(key);
+    if (!rgb || !uploadPixels(entry, rgb)) return false;
+    entry.thumbKey   = key;
+    entry.thumbDirty = false;
+    return true;
 }
 
 // ============================================================
@@ -132,19 +231,22 @@ void ThumbnailRenderer::ensureTexture(GLuint& tex)
 
 void ThumbnailRenderer::renderThumbnail(AssetEntry& entry)
 {
+    MYTHOS_PROFILE_SCOPE("ThumbnailRenderer::renderThumbnail");
     if (!entry.mesh || !entry.mesh->isLoaded()) return;
 
-    ensureTexture(entry.thumbnailTex);
+    if (entry.thumbSlot < 0 && !m_atlas.allocate(entry.thumbPage, entry.thumbSlot)) {
+        std::cerr << "[ThumbnailRenderer] Atlas allocation failed for '" << entry.name << "'\n";
+        entry.thumbDirty = false;
+        return;
+    }
 
     // Save GL state we're about to clobber
     GLint prevFBO, prevViewport[4];
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
     glGetIntegerv(GL_VIEWPORT, prevViewport);
 
-    // Bind our FBO, attach the per-asset texture as colour target
+    // Render into the scratch target; copied into the atlas slot below
     glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                           GL_TEXTURE_2D, entry.thumbnailTex, 0);
 
     glViewport(0, 0, SIZE, SIZE);
     glEnable(GL_DEPTH_TEST);
@@ -154,39 +256,10 @@ void ThumbnailRenderer::renderThumbnail(AssetEntry& entry)
     const GpuMesh& gpu = entry.mesh->gpu;
     const MeshData& d  = entry.mesh->data;
 
-    // Camera: fit the mesh in view using its AABB
-    glm::vec3 centre = d.centre();
-    glm::vec3 size   = d.size();
-
-    // Use the longest axis as radius — guarantees non-zero even for flat tiles
-    float radius = std::max({size.x, size.y, size.z}) * 0.6f;
-    if (radius < 0.01f) radius = 1.f;
-
-    // Apply calibration so the thumbnail matches what you'll see in-scene
+    // Same framing as the software path — the two must be interchangeable
     glm::mat4 calib = entry.calibMatrix();
-    glm::vec4 cc    = calib * glm::vec4(centre, 1.f);
-    centre = glm::vec3(cc);
-
-    // Orbit camera — fixed 45°/30°
-    float dist = radius * 2.5f;
-    float yaw  = glm::radians(45.f);
-    float pit  = glm::radians(35.f);
-    glm::vec3 camPos = centre + dist * glm::vec3(
-        cos(pit) * sin(yaw),
-        sin(pit),
-        cos(pit) * cos(yaw));
-
-    // Safe up vector — if viewing almost straight down, use Z instead
-    glm::vec3 up = {0,1,0};
-    glm::vec3 fwd = glm::normalize(centre - camPos);
-    if (std::abs(glm::dot(fwd, up)) > 0.99f) up = {0,0,1};
-
-    // Robust near/far — never allow near < 0.001
-    float nearZ = std::max(radius * 0.01f, 0.001f);
-    float farZ  = radius * 15.f;
-
-    glm::mat4 view = glm::lookAt(camPos, centre, up);
-    glm::mat4 proj = glm::perspective(glm::radians(40.f), 1.f, nearZ, farZ);
+    glm::mat4 view, proj;
+    SoftwareRasterizer::thumbnailCamera(d, calib, view, proj);
     glm::mat4 mvp  = proj * view * calib;
 
     glUseProgram(m_shader);
@@ -200,28 +273,53 @@ void ThumbnailRenderer::renderThumbnail(AssetEntry& entry)
         return;
     }
 
-    glUniformMatrix4fv(glGetUniformLocation(m_shader, "uMVP"),   1, GL_FALSE, glm::value_ptr(mvp));
-    glUniformMatrix4fv(glGetUniformLocation(m_shader, "uModel"), 1, GL_FALSE, glm::value_ptr(calib));
+    glUniformMatrix4fv(m_locMVP,   1, GL_FALSE, glm::value_ptr(mvp));
+    glUniformMatrix4fv(m_locModel, 1, GL_FALSE, glm::value_ptr(calib));
 
+    // The mesh is a range of the renderer's geometry arena
     glBindVertexArray(gpu.vao);
+    const uintptr_t base = (uintptr_t)gpu.firstIndex * sizeof(unsigned int);
 
     if (!entry.mesh->submeshes.empty()) {
         // Multi-material mesh — draw each submesh with its own colour
         for (const SubMesh& sm : entry.mesh->submeshes) {
-            glUniform3fv(glGetUniformLocation(m_shader, "uColor"), 1,
-                         glm::value_ptr(sm.color));
-            glDrawElements(GL_TRIANGLES, sm.indexCount, GL_UNSIGNED_INT,
-                           (void*)(uintptr_t)sm.indexOffset);
+            glUniform3fv(m_locColor, 1, glm::value_ptr(sm.color));
+            glDrawElementsBaseVertex(GL_TRIANGLES, sm.indexCount, GL_UNSIGNED_INT,
+                                     (void*)(base + (uintptr_t)sm.indexOffset),
+                                     gpu.baseVertex);
         }
     } else {
         // Single-colour fallback
-        glUniform3f(glGetUniformLocation(m_shader, "uColor"), 0.75f, 0.78f, 0.85f);
-        glDrawElements(GL_TRIANGLES, gpu.indexCount, GL_UNSIGNED_INT, nullptr);
+        glUniform3f(m_locColor, 0.75f, 0.78f, 0.85f);
+        glDrawElementsBaseVertex(GL_TRIANGLES, gpu.indexCount, GL_UNSIGNED_INT,
+                                 (void*)base, gpu.baseVertex);
     }
 
     glBindVertexArray(0);
     glUseProgram(0);
 
+    // Keep a copy for the cache — one small synchronous read per render
+    entry.thumbKey = cacheKey(entry);
+    if (m_cache && entry.thumbKey) {
+        std::vector<uint8_t> rgb((size_t)SIZE * SIZE * 3);
+        GLint prevAlign;
+        glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlign);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, SIZE, SIZE, GL_RGB, GL_UNSIGNED_BYTE, rgb.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, prevAlign);
+        m_cache->store(entry.thumbKey, rgb.data());
+    }
+
+    // Scratch → atlas slot (reads from the bound FBO's colour attachment)
+    int sx, sy;
+    ThumbnailAtlas::slotOrigin(entry.thumbSlot, sx, sy);
+    glBindTexture(GL_TEXTURE_2D, m_atlas.pageTexture(entry.thumbPage));
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, sx, sy, 0, 0, SIZE, SIZE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    entry.thumbnailTex = m_atlas.pageTexture(entry.thumbPage);
+    ThumbnailAtlas::slotUV(entry.thumbSlot, entry.thumbUV0, entry.thumbUV1);
+
     // Restore state
     glBindFramebuffer(GL_FRAMEBUFFER, prevFBO);
     glViewport(prevViewport[0], prevViewport[1],
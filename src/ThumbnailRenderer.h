@@ -2,33 +2,92 @@
 #include <glad/glad.h>
 #include "MeshAsset.h"
 #include "AssetLibrary.h"
+#include "ThumbnailAtlas.h"
+#include "ThumbnailCache.h"
+#include "SoftwareRasterizer.h"
 #include <glm/glm.hpp>
+#include <future>
+#include <memory>
+#include <vector>
 
-// Renders a mesh asset into a small offscreen framebuffer and
-// returns the GL texture ID for use with ImGui::Image.
+// Renders a mesh asset into a small offscreen framebuffer and copies the
+// result into a slot of the shared ThumbnailAtlas for use with ImGui::Image.
 //
 // One ThumbnailRenderer is shared across all assets.
-// Call renderThumbnail() when thumbDirty is true to refresh.
+// Call renderThumbnail() when thumbDirty is true to refresh; callers spread
+// those calls over frames (see AssetLibraryView::pumpThumbnails).
 class ThumbnailRenderer
 {
 public:
-    static constexpr int SIZE = 128;   // thumbnail pixel dimensions
+    static constexpr int SIZE = ThumbnailAtlas::kSlotSize;   // thumbnail pixel dimensions
+
+    // Bump whenever framing, shading or clear colour change — part of every
+    // cache key, so old cached thumbnails are simply never hit again.
+    static constexpr uint32_t kVersion = 1;
 
     bool init();
     void shutdown();
 
-    // Render asset's mesh into its thumbnail texture.
-    // Updates entry.thumbnailTex and clears entry.thumbDirty.
+    // Render asset's mesh into its atlas slot (allocated on first use).
+    // Updates entry.thumbnailTex/thumbUV0/thumbUV1 and clears entry.thumbDirty.
     void renderThumbnail(AssetEntry& entry);
 
+    // ---- Software path ----
+    // Render the entry with SoftwareRasterizer on a worker thread instead of
+    // the GL context. Clears thumbDirty on launch. false when the entry has
+    // no CPU mesh data, is already in flight, or all workers are busy.
+    bool queueSoftware(AssetEntry& entry);
+    // Upload finished software renders into their atlas slots (main thread).
+    int  collectSoftware(std::vector<AssetEntry>& entries);
+    int  pendingSoftware() const { return (int)m_softJobs.size(); }
+    bool softwareFull()    const { return pendingSoftware() >= maxSoftJobs(); }
+
+    // Return the entry's slot to the atlas (asset removed from the library).
+    void releaseThumbnail(AssetEntry& entry);
+
+    // ---- Cache ----
+    // Finished renders are stored in the cache; restoreCached() uploads a
+    // cached image instead of rendering. Needs only entry.contentHash, not a
+    // loaded mesh. Clears thumbDirty on a hit.
+    void setCache(ThumbnailCache* cache) { m_cache = cache; }
+    bool restoreCached(AssetEntry& entry);
+    static uint64_t cacheKey(const AssetEntry& entry);   // 0 without contentHash
+
+    const ThumbnailAtlas& atlas() const { return m_atlas; }
+
 private:
     GLuint m_fbo     = 0;
     GLuint m_rbo     = 0;   // depth renderbuffer
     GLuint m_shader  = 0;
 
-    // Shared scratch texture — we blit into entry.thumbnailTex after rendering
+    // Scratch render target — copied into the atlas after each render
     GLuint m_colorTex = 0;
+    MemoryStats::Tracked m_targetMem { MemTag::Thumbnails };   // FBO colour + depth
+
+    GLint  m_locMVP   = -1;
+    GLint  m_locModel = -1;
+    GLint  m_locColor = -1;
+
+    ThumbnailAtlas  m_atlas;
+    ThumbnailCache* m_cache = nullptr;
+
+    // Entries can share a mesh (one import, several calibrations), so a job
+    // belongs to the entry that launched it: mesh + name, with the
+    // calibration it was framed with to spot edits made while it ran.
+    struct SoftJob
+    {
+        std::shared_ptr<MeshAsset>               mesh;
+        std::string                              name;      // AssetEntry::name
+        glm::mat4                                calib { 1.f };
+        uint64_t                                 key = 0;   // cache key at launch
+        std::future<SoftwareRasterizer::Image>   image;
+
+        bool launchedBy(const AssetEntry& e) const { return e.mesh == mesh && e.name == name; }
+    };
+    std::vector<SoftJob> m_softJobs;
+
+    static int maxSoftJobs();
+    bool uploadPixels(AssetEntry& entry, const uint8_t* rgb);   // SIZE² RGB8
 
-    void ensureTexture(GLuint& tex);
     void setUniforms(const GpuMesh& mesh, const AssetEntry& entry);
 };
@@ -1,11 +1,16 @@
 #include "App.h"
 #include <iostream>
 
-int main()
+int main(int argc, char** argv)
 {
+    BenchmarkConfig cfg;
+    if (!BenchmarkConfig::parse(argc, argv, cfg))
+        return 2;
+
     App app;
+    app.setOptions(cfg);
 
-    if (!app.init(1280, 720, "Mythos"))
+    if (!app.init(cfg.width, cfg.height, "Mythos"))
     {
         std::cerr << "[Main] App init failed\n";
         return 1;
@@ -14,5 +19,5 @@ int main()
     app.run();
     app.shutdown();
 
-    return 0;
+    return app.exitCode();
 }
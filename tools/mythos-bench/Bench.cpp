@@ -0,0 +1,169 @@
+#include "Bench.h"
+#include "MemoryStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Bench
+{
+
+static volatile uint64_t s_sink = 0;
+
+void keep(uint64_t v) { s_sink = s_sink + v; }
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    // Nearest rank: smallest sample with at least p% of samples <= it
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    rank = std::min(std::max(rank, (size_t)1), sorted.size());
+    return sorted[rank - 1];
+}
+
+Stats run(const std::string& name, const Options& opt,
+          const std::function<int64_t()>& fn,
+          const std::function<void()>& setup)
+{
+    Stats st;
+    st.name = name;
+
+    for (int i = 0; i < opt.warmup; ++i) {
+        if (setup) setup();
+        keep((uint64_t)fn());
+    }
+
+    const bool countAllocs = MemoryStats::allocCountingAvailable();
+
+    std::vector<double> samples;
+    samples.reserve(std::max(opt.reps, 1));
+    for (int i = 0; i < std::max(opt.reps, 1); ++i) {
+        if (setup) setup();
+        const uint64_t a0 = MemoryStats::threadAllocations();
+        auto t0 = std::chrono::steady_clock::now();
+        st.items = fn();
+        auto t1 = std::chrono::steady_clock::now();
+        const int64_t allocs = (int64_t)(MemoryStats::threadAllocations() - a0);
+        samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        keep((uint64_t)st.items);
+        if (countAllocs && (st.allocs < 0 || allocs < st.allocs)) st.allocs = allocs;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+
+    st.reps   = (int)samples.size();
+    st.minMs  = samples.front();
+    st.maxMs  = samples.back();
+    st.p50Ms  = percentile(samples, 50.0);
+    st.p90Ms  = percentile(samples, 90.0);
+    st.p99Ms  = percentile(samples, 99.0);
+    st.meanMs = sum / (double)samples.size();
+    return st;
+}
+
+// ============================================================
+// JSON
+// ============================================================
+
+static std::string jsonStr(const std::string& s)
+{
+    std::string r = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') r += '\\';
+        r += c;
+    }
+    return r + "\"";
+}
+
+void writeJson(std::ostream& out, const std::vector<Stats>& results,
+               const std::string& label)
+{
+    out << std::fixed << std::setprecision(4);
+    out << "{\n  \"tool\": \"mythos-bench\",\n  \"label\": " << jsonStr(label)
+        << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Stats& s = results[i];
+        const double perSec = (s.items > 0 && s.p50Ms > 0.0)
+                            ? (double)s.items * 1000.0 / s.p50Ms : 0.0;
+        out << "    { \"name\": " << jsonStr(s.name)
+            << ", \"reps\": "   << s.reps
+            << ", \"minMs\": "  << s.minMs
+            << ", \"p50Ms\": "  << s.p50Ms
+            << ", \"p90Ms\": "  << s.p90Ms
+            << ", \"p99Ms\": "  << s.p99Ms
+            << ", \"maxMs\": "  << s.maxMs
+            << ", \"meanMs\": " << s.meanMs
+            << ", \"items\": "  << s.items
+            << ", \"allocs\": " << s.allocs
+            << ", \"itemsPerSec\": " << std::setprecision(1) << perSec << std::setprecision(4)
+            << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Only reads what writeJson wrote: every result is one line holding
+// "name": "…" followed by "p50Ms": <number>.
+bool loadBaseline(const std::string& path, std::map<std::string, double>& p50)
+{
+    std::ifstream f(path);
+    if (!f) return false;
+
+    std::string line;
+    while (std::getline(f, line)) {
+        size_t n = line.find("\"name\": \"");
+        size_t p = line.find("\"p50Ms\": ");
+        if (n == std::string::npos || p == std::string::npos) continue;
+        n += 9;
+        std::string name;
+        while (n < line.size() && line[n] != '"') {
+            if (line[n] == '\\' && n + 1 < line.size()) ++n;
+            name += line[n++];
+        }
+        p50[name] = atof(line.c_str() + p + 9);
+    }
+    return true;
+}
+
+int compare(std::ostream& out, const std::vector<Stats>& results,
+            const std::map<std::string, double>& baseline, double thresholdPct)
+{
+    int regressions = 0;
+    char buf[256];
+    out << "\n-- vs baseline (p50, threshold " << thresholdPct << "%) --\n";
+    for (const Stats& s : results) {
+        auto it = baseline.find(s.name);
+        if (it == baseline.end() || it->second <= 0.0) continue;
+        const double delta = (s.p50Ms - it->second) / it->second * 100.0;
+        const bool   worse = delta > thresholdPct;
+        regressions += worse ? 1 : 0;
+        snprintf(buf, sizeof(buf), "  %-40s %10.3f -> %10.3f ms  %+7.1f%%%s\n",
+                 s.name.c_str(), it->second, s.p50Ms, delta,
+                 worse ? "  REGRESSION" : (delta < -thresholdPct ? "  faster" : ""));
+        out << buf;
+    }
+    return regressions;
+}
+
+// ============================================================
+// Allocation-free cases
+// ============================================================
+
+int allocViolations(std::ostream& out, const std::vector<Stats>& results)
+{
+    int violations = 0;
+    for (const Stats& s : results) {
+        if (!s.allocFree || s.allocs <= 0) continue;
+        out << "  " << s.name << " FAILED: " << s.allocs
+            << " allocation(s) per rep in an allocation-free case\n";
+        ++violations;
+    }
+    return violations;
+}
+
+} // namespace Bench
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Bench — minimal in-tree benchmark harness for mythos-bench
+//
+// run() calls a case `warmup` times untimed, then `reps` times timed with
+// steady_clock, and reduces the samples to min / percentiles / mean. Each
+// case reports an item count (triangles, tiles, rules …) so throughput
+// survives changes to the synthetic input size.
+//
+// Heap allocations per rep are counted through MemoryStats (mythos-bench
+// links src/AllocHook.cpp); setup() runs outside the counted region. Cases
+// marked allocation-free fail the run if their fewest allocs per rep is not 0.
+//
+// Results serialise to a flat JSON document; a previous run's file can be
+// loaded as a baseline and compared by p50 — noisy tails are reported but
+// never gate.
+// ============================================================
+
+namespace Bench
+{
+    struct Stats {
+        std::string name;
+        int         reps   = 0;
+        double      minMs  = 0.0;
+        double      p50Ms  = 0.0;
+        double      p90Ms  = 0.0;
+        double      p99Ms  = 0.0;
+        double      maxMs  = 0.0;
+        double      meanMs = 0.0;
+        int64_t     items  = 0;      // work units per rep (0 = not reported)
+        int64_t     allocs = -1;     // heap allocations per rep, fewest seen (-1 = not counted)
+        bool        allocFree = false;   // marked allocation-free — allocs > 0 fails
+    };
+
+    struct Options {
+        int         warmup = 2;
+        int         reps   = 15;
+        std::string filter;          // substring of the case name; empty = all
+    };
+
+    // fn returns the item count of one rep (also defeats dead-code removal).
+    // setup, if given, runs untimed before every call of fn — for cases that
+    // consume their input (welding in place, …).
+    Stats run(const std::string& name, const Options& opt,
+              const std::function<int64_t()>& fn,
+              const std::function<void()>& setup = {});
+
+    // Sorted samples → nearest-rank percentile (p in 0..100).
+    double percentile(const std::vector<double>& sorted, double p);
+
+    void writeJson(std::ostream& out, const std::vector<Stats>& results,
+                   const std::string& label);
+
+    // name → p50Ms from a file written by writeJson. false if unreadable.
+    bool loadBaseline(const std::string& path, std::map<std::string, double>& p50);
+
+    // Prints one line per case present in both sets; returns the number of
+    // cases whose p50 grew by more than thresholdPct.
+    int compare(std::ostream& out, const std::vector<Stats>& results,
+                const std::map<std::string, double>& baseline, double thresholdPct);
+
+    // Prints one line per allocation-free case that allocated; returns their
+    // number.
+    int allocViolations(std::ostream& out, const std::vector<Stats>& results);
+
+    // Stops the optimiser from discarding a computed value.
+    void keep(uint64_t v);
+}
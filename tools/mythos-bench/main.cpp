@@ -0,0 +1,674 @@
+// ============================================================
+// mythos-bench — performance regression suite for mythos-core
+//
+//   mythos-bench [--filter S] [--reps N] [--warmup N] [--full]
+//                [--json F] [--baseline F] [--threshold PCT] [--label S]
+//                [--verbose]
+//
+// Every input is synthetic and seeded — no assets are read. Mesh cases use a
+// displaced N×N grid; importer cases write that grid to OBJ / glTF / GLB in
+// the temp directory first (untimed) and delete the files afterwards.
+//
+// --json writes the results ('-' = stdout). --baseline compares p50 times
+// against an earlier --json file and exits 1 if any case slowed down by more
+// than --threshold percent (default 10). --full adds the large sizes.
+// Library logging is discarded unless --verbose.
+//
+// check.* entries are not timed: they run a fixed input once and compare the
+// output with the expected one. A failed check also exits 1, and so does a
+// case marked allocation-free (cull.frustum) that allocated in every rep.
+// ============================================================
+
+#include "Bench.h"
+#include "MeshAsset.h"
+#include "MeshMerge.h"
+#include "SceneObject.h"
+#include "Culling.h"
+#include "SoftwareOcclusion.h"
+#include "SoftwareRasterizer.h"
+#include "ContentHash.h"
+#include "ObjImporter.h"
+#include "GltfImporter.h"
+#include "Grammar.h"
+#include "GrammarInducer.h"
+#include "HalfEdgeMesh.h"
+#include "MerrellGrammar.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Synthetic inputs
+// ============================================================
+
+// Small deterministic LCG — std::mt19937 output is portable too, but this
+// keeps the generated files byte-identical across standard libraries.
+struct Lcg {
+    uint32_t s;
+    explicit Lcg(uint32_t seed) : s(seed) {}
+    uint32_t next() { s = s * 1664525u + 1013904223u; return s >> 8; }
+    int      range(int n) { return (int)(next() % (uint32_t)n); }
+};
+
+// N×N quads over [0,N]², gently displaced in Y so normals vary.
+// shared=false emits a triangle soup (3 unique verts per triangle) for weld.
+static MeshData makeGrid(int n, bool shared)
+{
+    MeshData d;
+    auto vert = [n](int x, int z) {
+        MeshVertex v;
+        float fx = (float)x, fz = (float)z;
+        v.pos    = { fx, 0.25f * std::sin(fx * 0.7f) * std::cos(fz * 0.5f), fz };
+        v.normal = { 0.f, 1.f, 0.f };
+        v.uv     = { fx / (float)n, fz / (float)n };
+        return v;
+    };
+
+    if (shared) {
+        d.vertices.reserve((size_t)(n + 1) * (n + 1));
+        for (int z = 0; z <= n; ++z)
+            for (int x = 0; x <= n; ++x) d.vertices.push_back(vert(x, z));
+        d.indices.reserve((size_t)n * n * 6);
+        for (int z = 0; z < n; ++z)
+            for (int x = 0; x < n; ++x) {
+                unsigned int i0 = z * (n + 1) + x, i1 = i0 + 1;
+                unsigned int i2 = i0 + (n + 1),    i3 = i2 + 1;
+                d.indices.insert(d.indices.end(), { i0, i2, i1, i1, i2, i3 });
+            }
+    } else {
+        d.vertices.reserve((size_t)n * n * 6);
+        for (int z = 0; z < n; ++z)
+            for (int x = 0; x < n; ++x) {
+                const MeshVertex q[6] = { vert(x, z), vert(x, z + 1), vert(x + 1, z),
+                                          vert(x + 1, z), vert(x, z + 1), vert(x + 1, z + 1) };
+                for (const auto& v : q) {
+                    d.indices.push_back((unsigned int)d.vertices.size());
+                    d.vertices.push_back(v);
+                }
+            }
+    }
+    d.computeAABB();
+    return d;
+}
+
+// Unit cube centred on the origin, 4 vertices per face.
+static MeshData makeBox()
+{
+    MeshData d;
+    static const glm::vec3 n[6] = { {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+    for (const glm::vec3& fn : n) {
+        // Two axes spanning the face, ordered so the winding is CCW from outside
+        const glm::vec3 u = fn.x != 0.f ? glm::vec3(0, 0, -fn.x)
+                          : fn.y != 0.f ? glm::vec3(fn.y, 0, 0) : glm::vec3(fn.z, 0, 0);
+        const glm::vec3 v = glm::cross(fn, u);
+        const unsigned int base = (unsigned int)d.vertices.size();
+        for (int k = 0; k < 4; ++k) {
+            const float su = (k == 1 || k == 2) ? 0.5f : -0.5f;
+            const float sv = (k >= 2) ? 0.5f : -0.5f;
+            MeshVertex mv;
+            mv.pos    = fn * 0.5f + u * su + v * sv;
+            mv.normal = fn;
+            mv.uv     = { su + 0.5f, sv + 0.5f };
+            d.vertices.push_back(mv);
+        }
+        d.indices.insert(d.indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+    d.computeAABB();
+    return d;
+}
+
+static bool writeObj(const std::string& path, const MeshData& d)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f) return false;
+    char buf[128];
+    for (const auto& v : d.vertices) {
+        snprintf(buf, sizeof(buf), "v %.6f %.6f %.6f\n", v.pos.x, v.pos.y, v.pos.z);
+        f << buf;
+    }
+    for (const auto& v : d.vertices) {
+        snprintf(buf, sizeof(buf), "vt %.6f %.6f\n", v.uv.x, v.uv.y);
+        f << buf;
+    }
+    for (size_t i = 0; i + 2 < d.indices.size(); i += 3) {
+        unsigned a = d.indices[i] + 1, b = d.indices[i + 1] + 1, c = d.indices[i + 2] + 1;
+        snprintf(buf, sizeof(buf), "f %u/%u %u/%u %u/%u\n", a, a, b, b, c, c);
+        f << buf;
+    }
+    return (bool)f;
+}
+
+// glTF JSON for one primitive: positions, normals (float VEC3) and uint32
+// indices packed back to back in buffer 0. uri is empty for GLB.
+static std::string gltfJson(const MeshData& d, size_t binBytes, const std::string& uri)
+{
+    const size_t nv = d.vertices.size(), ni = d.indices.size();
+    const size_t vec3Bytes = nv * 12;
+    std::ostringstream s;
+    s << "{\"asset\":{\"version\":\"2.0\"},"
+      << "\"buffers\":[{\"byteLength\":" << binBytes
+      << (uri.empty() ? "" : ",\"uri\":\"" + uri + "\"") << "}],"
+      << "\"bufferViews\":["
+      << "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" << vec3Bytes << "},"
+      << "{\"buffer\":0,\"byteOffset\":" << vec3Bytes << ",\"byteLength\":" << vec3Bytes << "},"
+      << "{\"buffer\":0,\"byteOffset\":" << vec3Bytes * 2 << ",\"byteLength\":" << ni * 4 << "}],"
+      << "\"accessors\":["
+      << "{\"bufferView\":0,\"componentType\":5126,\"count\":" << nv << ",\"type\":\"VEC3\","
+      <<   "\"min\":[" << d.aabbMin.x << "," << d.aabbMin.y << "," << d.aabbMin.z << "],"
+      <<   "\"max\":[" << d.aabbMax.x << "," << d.aabbMax.y << "," << d.aabbMax.z << "]},"
+      << "{\"bufferView\":1,\"componentType\":5126,\"count\":" << nv << ",\"type\":\"VEC3\"},"
+      << "{\"bufferView\":2,\"componentType\":5125,\"count\":" << ni << ",\"type\":\"SCALAR\"}],"
+      << "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1},\"indices\":2}]}],"
+      << "\"nodes\":[{\"mesh\":0}],\"scenes\":[{\"nodes\":[0]}],\"scene\":0}";
+    return s.str();
+}
+
+static std::vector<uint8_t> gltfBin(const MeshData& d)
+{
+    std::vector<uint8_t> bin;
+    auto put = [&](const void* p, size_t n) {
+        bin.insert(bin.end(), (const uint8_t*)p, (const uint8_t*)p + n);
+    };
+    for (const auto& v : d.vertices) put(&v.pos,    12);
+    for (const auto& v : d.vertices) put(&v.normal, 12);
+    put(d.indices.data(), d.indices.size() * 4);
+    return bin;
+}
+
+// .gltf + external .bin (binPath is next to path, referenced by file name)
+static bool writeGltf(const std::string& path, const std::string& binPath, const MeshData& d)
+{
+    std::vector<uint8_t> bin = gltfBin(d);
+    std::ofstream b(binPath, std::ios::binary | std::ios::trunc);
+    if (!b) return false;
+    b.write((const char*)bin.data(), (std::streamsize)bin.size());
+
+    std::string uri = std::filesystem::path(binPath).filename().string();
+    std::ofstream f(path, std::ios::trunc);
+    if (!f) return false;
+    f << gltfJson(d, bin.size(), uri);
+    return (bool)b && (bool)f;
+}
+
+static bool writeGlb(const std::string& path, const MeshData& d)
+{
+    std::vector<uint8_t> bin = gltfBin(d);
+    std::string json = gltfJson(d, bin.size(), "");
+    while (json.size() % 4) json += ' ';           // chunks are 4-byte aligned
+    while (bin.size()  % 4) bin.push_back(0);
+
+    const uint32_t total = 12 + 8 + (uint32_t)json.size() + 8 + (uint32_t)bin.size();
+    const uint32_t header[3]  = { 0x46546C67u, 2u, total };               // "glTF"
+    const uint32_t jsonHdr[2] = { (uint32_t)json.size(), 0x4E4F534Au };  // JSON
+    const uint32_t binHdr[2]  = { (uint32_t)bin.size(),  0x004E4942u };  // BIN
+
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) return false;
+    f.write((const char*)header, sizeof(header));
+    f.write((const char*)jsonHdr, sizeof(jsonHdr));
+    f.write(json.data(), (std::streamsize)json.size());
+    f.write((const char*)binHdr, sizeof(binHdr));
+    f.write((const char*)bin.data(), (std::streamsize)bin.size());
+    return (bool)f;
+}
+
+// Tile vocabularies of growing size: the six two-socket corridor pieces,
+// then T-junctions, then the cross.
+static std::vector<merrell::TileSocketDef> vocabulary(int n)
+{
+    static const std::vector<merrell::TileSocketDef> all = {
+        { "HStraight", {{-1,0},{ 1,0}} },
+        { "VStraight", {{ 0,-1},{0,1}} },
+        { "CornerTL",  {{-1,0},{ 0,-1}} },
+        { "CornerTR",  {{ 1,0},{ 0,-1}} },
+        { "CornerBL",  {{-1,0},{ 0, 1}} },
+        { "CornerBR",  {{ 1,0},{ 0, 1}} },
+        { "TeeN",      {{-1,0},{ 1,0},{0,-1}} },
+        { "TeeS",      {{-1,0},{ 1,0},{0, 1}} },
+        { "TeeE",      {{ 0,-1},{0,1},{1, 0}} },
+        { "TeeW",      {{ 0,-1},{0,1},{-1,0}} },
+        { "Cross",     {{-1,0},{ 1,0},{0,-1},{0,1}} },
+    };
+    n = std::min(n, (int)all.size());
+    return std::vector<merrell::TileSocketDef>(all.begin(), all.begin() + n);
+}
+
+// GEP scene with a w×h grid of tiles drawn from `kinds` assets at random
+// 90° rotations — the shape GrammarInducer::induce reads from a saved project.
+static std::string makeGep(int w, int h, int kinds, uint32_t seed)
+{
+    Lcg rng(seed);
+    std::ostringstream s;
+    s << "{\n  \"version\": 1,\n  \"objects\": [\n";
+    int id = 0;
+    for (int z = 0; z < h; ++z)
+        for (int x = 0; x < w; ++x, ++id) {
+            const int kind = rng.range(kinds);
+            const int rot  = rng.range(4) * 90;
+            s << "    { \"id\": " << id
+              << ", \"name\": \"tile_" << kind << "\""
+              << ", \"meshName\": \"gltf:tile_" << kind << ".gltf\""
+              << ", \"meshSource\": \"assets/tile_" << kind << ".gltf\""
+              << ", \"position\": [" << x << ", 0, " << z << "]"
+              << ", \"rotation\": [0, " << rot << ", 0]"
+              << ", \"scale\": [1, 1, 1] }"
+              << (id + 1 < w * h ? "," : "") << "\n";
+        }
+    s << "  ]\n}\n";
+    return s.str();
+}
+
+// Fixed occlusion scene: a wall facing the camera and boxes hidden behind
+// it, beside it, above it, in front of it and behind the camera.
+struct OcclusionScene {
+    std::vector<SceneObject> objects;
+    glm::mat4                viewProj;
+    std::vector<int>         expected;   // survivors of frustum + occlusion
+};
+
+static OcclusionScene makeOcclusionScene(const std::shared_ptr<MeshAsset>& box)
+{
+    struct Placement { glm::vec3 pos, scale; };
+    static const Placement kPlacements[] = {
+        { {  0.0f, 1.0f,   0.f }, {  8.f, 4.f, 0.2f } },   // 0 wall
+        { {  0.0f, 1.0f,  -5.f }, {  1.f, 1.f, 1.0f } },   // 1 behind the wall
+        { { 12.0f, 1.0f,  -5.f }, {  1.f, 1.f, 1.0f } },   // 2 beside it
+        { {  0.0f, 1.0f,   4.f }, {  1.f, 1.f, 1.0f } },   // 3 in front of it
+        { {  0.0f, 4.5f,  -5.f }, {  1.f, 1.f, 1.0f } },   // 4 behind, above its top edge
+        { {  0.0f, 1.0f, -20.f }, { 30.f, 1.f, 1.0f } },   // 5 behind, wider than it
+        { {  0.0f, 1.0f,  30.f }, {  1.f, 1.f, 1.0f } },   // 6 behind the camera
+    };
+
+    OcclusionScene sc;
+    for (const Placement& p : kPlacements) {
+        SceneObject o;
+        o.id       = (int)sc.objects.size();
+        o.mesh     = box;
+        o.position = p.pos;
+        o.scale    = p.scale;
+        sc.objects.push_back(std::move(o));
+    }
+    const float aspect = (float)SoftwareOcclusion::kWidth / (float)SoftwareOcclusion::kHeight;
+    sc.viewProj = glm::perspective(glm::radians(60.f), aspect, 0.1f, 100.f)
+                * glm::lookAt(glm::vec3(0.f, 1.f, 10.f), glm::vec3(0.f, 1.f, 0.f),
+                              glm::vec3(0.f, 1.f, 0.f));
+    sc.expected = { 0, 2, 3, 4, 5 };
+    return sc;
+}
+
+// Frustum culling then occlusion, as App::render does; sorted survivors.
+static std::vector<int> cullOcclusionScene(const OcclusionScene& sc, SceneCuller& culler,
+                                           SoftwareOcclusion& occlusion)
+{
+    CullParams cp;
+    cp.viewProj = sc.viewProj;
+    std::vector<int> visible;
+    culler.cull(cp, visible);
+
+    OcclusionParams op;
+    op.viewProj = sc.viewProj;
+    occlusion.cull(sc.objects, visible, op);
+    std::sort(visible.begin(), visible.end());
+    return visible;
+}
+
+// Fixed thumbnail input: a displaced grid in two material halves, imported
+// Z-up (calibration turns it Y-up, scales and offsets it).
+struct ThumbnailScene {
+    MeshData             data;
+    std::vector<SubMesh> submeshes;
+    glm::mat4            calib;
+};
+
+static ThumbnailScene makeThumbnailScene()
+{
+    ThumbnailScene sc;
+    sc.data = makeGrid(24, true);
+    const int half = (int)sc.data.indices.size() / 6 * 3;   // whole triangles
+    SubMesh a, b;
+    a.color = { 0.85f, 0.35f, 0.25f };
+    a.indexCount  = half;
+    b.color = { 0.25f, 0.55f, 0.85f };
+    b.indexOffset = half * (int)sizeof(unsigned int);
+    b.indexCount  = (int)sc.data.indices.size() - half;
+    sc.submeshes = { a, b };
+
+    sc.calib = glm::translate(glm::mat4(1.f), glm::vec3(0.5f, 0.f, -0.25f));
+    sc.calib = glm::rotate(sc.calib, glm::radians(-90.f), glm::vec3(1.f, 0.f, 0.f));
+    sc.calib = glm::scale(sc.calib, glm::vec3(0.5f));
+    return sc;
+}
+
+// ContentHash of the expected check.softraster.thumbnail image. Pinned from a
+// reference run; when the rasteriser's output changes on purpose, take the
+// new value from the failure message.
+static const uint64_t kThumbnailHash = 0x44e36d266b1a9908ull;
+static const int      kThumbnailSize = 128;
+
+static std::string hex64(uint64_t v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "0x%016llx", (unsigned long long)v);
+    return buf;
+}
+
+static std::string joinInts(const std::vector<int>& v)
+{
+    std::string s = "{";
+    for (size_t i = 0; i < v.size(); ++i) s += (i ? "," : "") + std::to_string(v[i]);
+    return s + "}";
+}
+
+// ============================================================
+// Output plumbing
+// ============================================================
+
+// Discards library logging (std::cout) while cases run
+struct NullBuf : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+static bool writeResults(const std::string& path, const std::vector<Bench::Stats>& r,
+                         const std::string& label, std::streambuf* stdoutBuf)
+{
+    if (path == "-") {
+        std::ostream out(stdoutBuf);
+        Bench::writeJson(out, r, label);
+        return (bool)out;
+    }
+    std::ofstream f(path, std::ios::trunc);
+    if (!f) {
+        std::cerr << "[mythos-bench] Cannot write: " << path << "\n";
+        return false;
+    }
+    Bench::writeJson(f, r, label);
+    return (bool)f;
+}
+
+static void printRow(const Bench::Stats& s)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), "  %-40s p50 %10.3f  p90 %10.3f  p99 %10.3f  min %10.3f ms  (%lld items, %lld allocs)\n",
+             s.name.c_str(), s.p50Ms, s.p90Ms, s.p99Ms, s.minMs, (long long)s.items, (long long)s.allocs);
+    std::cerr << buf;
+}
+
+// ============================================================
+// main
+// ============================================================
+
+int main(int argc, char** argv)
+{
+    Bench::Options opt;
+    std::string jsonPath, baselinePath, label = "local";
+    double threshold = 10.0;
+    bool   full = false, verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) { std::cerr << "[mythos-bench] " << a << " needs a value\n"; exit(2); }
+            return argv[++i];
+        };
+        if      (a == "--filter")    opt.filter   = value();
+        else if (a == "--reps")      opt.reps     = std::max(1, atoi(value().c_str()));
+        else if (a == "--warmup")    opt.warmup   = std::max(0, atoi(value().c_str()));
+        else if (a == "--json")      jsonPath     = value();
+        else if (a == "--baseline")  baselinePath = value();
+        else if (a == "--threshold") threshold    = atof(value().c_str());
+        else if (a == "--label")     label        = value();
+        else if (a == "--full")      full         = true;
+        else if (a == "--verbose")   verbose      = true;
+        else {
+            std::cerr << "usage: mythos-bench [--filter S] [--reps N] [--warmup N] [--full]\n"
+                         "                    [--json F] [--baseline F] [--threshold PCT]\n"
+                         "                    [--label S] [--verbose]\n";
+            return 2;
+        }
+    }
+
+    NullBuf nullBuf;
+    std::streambuf* stdoutBuf = std::cout.rdbuf(verbose ? std::cerr.rdbuf() : &nullBuf);
+
+    std::vector<Bench::Stats> results;
+    auto bench = [&](const std::string& name, const std::function<int64_t()>& fn,
+                     const std::function<void()>& setup = {}) {
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+        results.push_back(Bench::run(name, opt, fn, setup));
+        printRow(results.back());
+    };
+    // Same, for a case whose reps must not touch the heap once warmed up
+    // (warmed at least once even with --warmup 0, so the first rep's reserve
+    // is not counted against it)
+    auto benchNoAlloc = [&](const std::string& name, const std::function<int64_t()>& fn) {
+        const size_t n = results.size();
+        if (opt.warmup == 0 && (opt.filter.empty() || name.find(opt.filter) != std::string::npos))
+            fn();
+        bench(name, fn);
+        if (results.size() > n) results.back().allocFree = true;
+    };
+    auto wanted = [&](const std::string& name) {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    };
+    int checksRun = 0, checksFailed = 0;
+    auto check = [&](const std::string& name, bool ok, const std::string& detail) {
+        ++checksRun;
+        if (ok) return;
+        ++checksFailed;
+        std::cerr << "  " << name << " FAILED: " << detail << "\n";
+    };
+
+    std::cerr << "[mythos-bench] warmup " << opt.warmup << ", reps " << opt.reps
+              << (full ? ", full sizes" : "") << "\n";
+
+    // ---- Merrell: loadFromTiles + extractGrammar over growing vocabularies ----
+    // Same limits the editor uses (App::init) so the numbers are comparable.
+    for (int n : full ? std::vector<int>{2, 4, 6, 8, 11} : std::vector<int>{2, 4, 6}) {
+        const auto tiles = vocabulary(n);
+        bench("merrell.extract/vocab=" + std::to_string(n), [&]() -> int64_t {
+            merrell::MerrellGrammar g;
+            g.settings().maxHierarchyGen = 3;
+            g.settings().maxRules        = 50;
+            g.loadFromTiles(tiles, {});
+            g.extractGrammar();
+            return g.ruleCount();
+        });
+    }
+
+    // ---- Grid loop generator ----
+    for (int seed : {1, 42}) {
+        bench("grammar.generate/seed=" + std::to_string(seed), [&]() -> int64_t {
+            grammar::Grammar g;
+            for (const auto& t : vocabulary(6))
+                g.addPrim(t.label.c_str(), {0.8f, 0.8f, 0.8f}, t.sockets);
+            g.seed = seed;
+            g.generate();
+            return (int64_t)g.placed.size();
+        });
+    }
+
+    // ---- Grammar induction from a GEP scene ----
+    for (int n : full ? std::vector<int>{16, 64, 128} : std::vector<int>{16, 64}) {
+        const std::string gep = makeGep(n, n, 8, 1234u);
+        bench("inducer.induce/grid=" + std::to_string(n), [&]() -> int64_t {
+            grammar::InducedGrammar g = grammar::GrammarInducer::induce(gep);
+            return (int64_t)g.nodes.size();
+        });
+    }
+
+    // ---- Half-edge construction ----
+    for (int n : full ? std::vector<int>{64, 256, 512} : std::vector<int>{64, 256}) {
+        const MeshData grid = makeGrid(n, true);
+        bench("halfedge.build/grid=" + std::to_string(n), [&]() -> int64_t {
+            grammar::HalfEdgeMesh he;
+            he.buildFromMesh(grid);
+            return (int64_t)he.faces.size();
+        });
+    }
+
+    // ---- Importers on generated files ----
+    // Files are only written when one of the three cases survives --filter
+    const int importN = full ? 512 : 128;
+    const std::string importSuffix = "/grid=" + std::to_string(importN);
+    if (wanted("import.obj" + importSuffix) || wanted("import.gltf" + importSuffix) ||
+        wanted("import.glb" + importSuffix)) {
+        namespace fs = std::filesystem;
+        const int n = importN;
+        const MeshData grid = makeGrid(n, true);
+        const std::string tag = "mythos-bench-grid" + std::to_string(n);
+        const fs::path dir = fs::temp_directory_path();
+        const std::string obj  = (dir / (tag + ".obj")).string();
+        const std::string gltf = (dir / (tag + ".gltf")).string();
+        const std::string bin  = (dir / (tag + ".bin")).string();
+        const std::string glb  = (dir / (tag + ".glb")).string();
+
+        if (writeObj(obj, grid) && writeGltf(gltf, bin, grid) && writeGlb(glb, grid)) {
+            const std::string& suffix = importSuffix;
+            bench("import.obj" + suffix, [&]() -> int64_t {
+                auto m = ObjImporter::load(obj);
+                return m ? (int64_t)m->data.indices.size() / 3 : 0;
+            });
+            bench("import.gltf" + suffix, [&]() -> int64_t {
+                auto m = GltfImporter::load(gltf);
+                return m ? (int64_t)m->data.indices.size() / 3 : 0;
+            });
+            bench("import.glb" + suffix, [&]() -> int64_t {
+                auto m = GltfImporter::load(glb);
+                return m ? (int64_t)m->data.indices.size() / 3 : 0;
+            });
+        } else {
+            std::cerr << "[mythos-bench] Cannot write import inputs to " << dir.string() << "\n";
+        }
+        std::error_code ec;
+        for (const auto& p : { obj, gltf, bin, glb }) fs::remove(p, ec);
+    }
+
+    // ---- Vertex welding ----
+    for (int n : full ? std::vector<int>{128, 512} : std::vector<int>{128}) {
+        const MeshData soup = makeGrid(n, false);
+        MeshData work;
+        std::vector<SubMesh> subs;
+        bench("meshmerge.weld/grid=" + std::to_string(n),
+              [&]() -> int64_t {
+                  MeshMerge::weld(work, subs);
+                  return (int64_t)work.vertices.size();
+              },
+              [&]() {
+                  work = soup;
+                  subs.assign(1, SubMesh{});
+                  subs[0].indexCount = (int)soup.indices.size();
+              });
+    }
+
+    auto box = std::make_shared<MeshAsset>();
+    box->name = "box";
+    box->data = makeBox();
+
+    // ---- Frustum culling over a field of boxes ----
+    // `visible` is kept between reps like the editor's per-frame list, so
+    // every rep after the first must be allocation-free.
+    for (int n : full ? std::vector<int>{64, 256} : std::vector<int>{64}) {
+        std::vector<SceneObject> objects;
+        objects.reserve((size_t)n * n);
+        for (int z = 0; z < n; ++z)
+            for (int x = 0; x < n; ++x) {
+                SceneObject o;
+                o.id       = (int)objects.size();
+                o.mesh     = box;
+                o.position = { (float)x * 3.f, 0.5f, (float)z * 3.f };
+                objects.push_back(std::move(o));
+            }
+        SceneCuller culler;
+        culler.rebuild(objects);
+
+        const float extent = (float)n * 3.f;
+        CullParams cp;
+        cp.eye      = { extent * 0.5f, 20.f, -10.f };
+        cp.viewProj = glm::perspective(glm::radians(cp.fovY), 16.f / 9.f, 0.1f, 1000.f)
+                    * glm::lookAt(cp.eye, glm::vec3(extent * 0.5f, 0.f, extent * 0.5f),
+                                  glm::vec3(0.f, 1.f, 0.f));
+        cp.maxDistance = extent;
+        cp.minPixels   = 2.f;
+
+        std::vector<int> visible;
+        benchNoAlloc("cull.frustum/objects=" + std::to_string(n * n), [&]() -> int64_t {
+            visible.clear();
+            culler.cull(cp, visible);
+            return (int64_t)visible.size();
+        });
+    }
+
+    // ---- Occlusion culling on a fixed scene ----
+    {
+        const OcclusionScene sc = makeOcclusionScene(box);
+        SceneCuller       culler;
+        SoftwareOcclusion occlusion;
+        culler.rebuild(sc.objects);
+
+        if (wanted("check.occlusion.visible")) {
+            const std::vector<int> visible = cullOcclusionScene(sc, culler, occlusion);
+            check("check.occlusion.visible", visible == sc.expected,
+                  "visible " + joinInts(visible) + ", expected " + joinInts(sc.expected));
+        }
+        bench("occlusion.cull/fixed", [&]() -> int64_t {
+            return (int64_t)cullOcclusionScene(sc, culler, occlusion).size();
+        });
+    }
+
+    // ---- Software thumbnail rasteriser ----
+    {
+        const ThumbnailScene sc = makeThumbnailScene();
+        if (wanted("check.softraster.thumbnail")) {
+            SoftwareRasterizer::Image img =
+                SoftwareRasterizer::renderThumbnail(sc.data, sc.submeshes, sc.calib, kThumbnailSize);
+            const uint64_t h = ContentHash::bytes(ContentHash::kSeed, img.rgb.data(), img.rgb.size());
+            check("check.softraster.thumbnail", h == kThumbnailHash,
+                  "image hash " + hex64(h) + ", expected " + hex64(kThumbnailHash));
+        }
+        bench("softraster.thumbnail/size=" + std::to_string(kThumbnailSize), [&]() -> int64_t {
+            SoftwareRasterizer::Image img =
+                SoftwareRasterizer::renderThumbnail(sc.data, sc.submeshes, sc.calib, kThumbnailSize);
+            Bench::keep(img.rgb[img.rgb.size() / 2]);
+            return (int64_t)sc.data.indices.size() / 3;
+        });
+    }
+
+    std::cout.rdbuf(stdoutBuf);
+
+    const int allocFailures = Bench::allocViolations(std::cerr, results);
+    if (checksRun > 0)
+        std::cerr << "[mythos-bench] checks: " << checksRun - checksFailed << "/"
+                  << checksRun << " passed\n";
+    if (results.empty() && checksRun == 0) {
+        std::cerr << "[mythos-bench] No cases matched '" << opt.filter << "'\n";
+        return 2;
+    }
+    if (!jsonPath.empty() && !writeResults(jsonPath, results, label, stdoutBuf))
+        return 1;
+    if (checksFailed > 0 || allocFailures > 0) return 1;
+
+    if (!baselinePath.empty()) {
+        std::map<std::string, double> baseline;
+        if (!Bench::loadBaseline(baselinePath, baseline)) {
+            std::cerr << "[mythos-bench] Cannot read baseline: " << baselinePath << "\n";
+            return 1;
+        }
+        const int regressions = Bench::compare(std::cerr, results, baseline, threshold);
+        if (regressions > 0) {
+            std::cerr << "[mythos-bench] " << regressions << " regression(s)\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,675 @@
+// ============================================================
+// mythos-cli — headless front end over mythos-core
+//
+// Runs the grammar and mesh pipeline without a window, GL context or ImGui,
+// so batch jobs and benchmarks can run on build servers.
+//
+//   mythos-cli import   <mesh>...        [--json F] [--bin F]
+//   mythos-cli merge    <mesh>...        [--weld EPS] [--obj F] [--bin F] [--json F]
+//   mythos-cli halfedge <mesh>           [--weld EPS] [--json F]
+//   mythos-cli tiles                     [--tiles F] [--json F]
+//   mythos-cli extract                   [--tiles F] [--max-gen N] [--max-rules N] [--json F]
+//   mythos-cli generate                  [--tiles F] [--seed N] [--grid] [--min N] [--max N] [--json F]
+//   mythos-cli induce   <scene.gep>      [--json F]
+//
+// <mesh> is .obj, .gltf or .glb. --json/--obj accept "-" for stdout; library
+// log output is redirected to stderr so stdout carries only results.
+// --bin writes the MeshCodec packed form (vertices + indices).
+// --mem (any command) prints the MemoryStats table to stderr on exit; by then
+// most data is freed, so the peak column is the informative one.
+//
+// Tile file: one tile type per line, "Label dx dy [dx dy ...]" — the grid
+// directions of its sockets. '#' starts a comment. Without --tiles the
+// editor's six-piece corridor set is used.
+//
+// Exit codes: 0 success, 1 command failed, 2 bad usage.
+// ============================================================
+
+#include "MeshAsset.h"
+#include "MeshCodec.h"
+#include "MeshMerge.h"
+#include "ContentHash.h"
+#include "ObjImporter.h"
+#include "GltfImporter.h"
+#include "SceneObject.h"
+#include "Grammar.h"
+#include "GrammarInducer.h"
+#include "HalfEdgeMesh.h"
+#include "MerrellGrammar.h"
+#include "MemoryStats.h"
+
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Arguments
+// ============================================================
+
+struct Args {
+    std::string                        cmd;
+    std::vector<std::string>           inputs;
+    std::map<std::string, std::string> opts;    // "--json" -> "out.json"
+    bool                               grid = false;
+    bool                               mem  = false;
+
+    bool has(const char* k) const { return opts.count(k) != 0; }
+    std::string get(const char* k, const std::string& def = "") const {
+        auto it = opts.find(k);
+        return it == opts.end() ? def : it->second;
+    }
+    int   getInt  (const char* k, int def)   const { return has(k) ? atoi(get(k).c_str()) : def; }
+    float getFloat(const char* k, float def) const { return has(k) ? (float)atof(get(k).c_str()) : def; }
+};
+
+static const char* kValueOpts[] = {
+    "--json", "--bin", "--obj", "--tiles", "--seed", "--weld",
+    "--max-gen", "--max-rules", "--min", "--max",
+};
+
+static bool parseArgs(int argc, char** argv, Args& a)
+{
+    if (argc < 2) return false;
+    a.cmd = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        std::string s = argv[i];
+        if (s == "--grid") { a.grid = true; continue; }
+        if (s == "--mem")  { a.mem  = true; continue; }
+        if (s.size() > 2 && s[0] == '-' && s[1] == '-') {
+            bool known = false;
+            for (const char* k : kValueOpts) known |= (s == k);
+            if (!known || i + 1 >= argc) {
+                std::cerr << "[mythos-cli] Unknown or incomplete option: " << s << "\n";
+                return false;
+            }
+            a.opts[s] = argv[++i];
+            continue;
+        }
+        a.inputs.push_back(s);
+    }
+    return true;
+}
+
+static void printUsage()
+{
+    std::cerr <<
+        "usage: mythos-cli <command> [inputs] [options]\n"
+        "  import   <mesh>...    [--json F] [--bin F]\n"
+        "  merge    <mesh>...    [--weld EPS] [--obj F] [--bin F] [--json F]\n"
+        "  halfedge <mesh>       [--weld EPS] [--json F]\n"
+        "  tiles                 [--tiles F] [--json F]\n"
+        "  extract               [--tiles F] [--max-gen N] [--max-rules N] [--json F]\n"
+        "  generate              [--tiles F] [--seed N] [--grid] [--min N] [--max N] [--json F]\n"
+        "  induce   <scene.gep>  [--json F]\n"
+        "F may be '-' for stdout (--json, --obj).\n"
+        "--mem prints per-subsystem memory counters to stderr on exit.\n";
+}
+
+// ============================================================
+// Output helpers
+// ============================================================
+
+// The real stdout — std::cout itself is pointed at stderr in main() so the
+// libraries' progress logging never mixes with JSON written to "-".
+static std::streambuf* s_stdout = nullptr;
+
+static std::string jsonStr(const std::string& s)
+{
+    std::string r = "\"";
+    for (char c : s) {
+        switch (c) {
+            case '"':  r += "\\\""; break;
+            case '\\': r += "\\\\"; break;
+            case '\n': r += "\\n";  break;
+            case '\r': r += "\\r";  break;
+            case '\t': r += "\\t";  break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char)c);
+                    r += buf;
+                } else {
+                    r += c;
+                }
+        }
+    }
+    return r + "\"";
+}
+
+static std::string vec3Json(const glm::vec3& v)
+{
+    std::ostringstream s;
+    s << "[" << v.x << ", " << v.y << ", " << v.z << "]";
+    return s.str();
+}
+
+static std::string hashHex(uint64_t h)
+{
+    char buf[20];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+    return buf;
+}
+
+// Writes text to a file, or to stdout for "-".
+static bool writeText(const std::string& path, const std::string& text)
+{
+    if (path == "-") {
+        std::ostream out(s_stdout);
+        out << text;
+        out.flush();
+        return true;
+    }
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        std::cerr << "[mythos-cli] Cannot write: " << path << "\n";
+        return false;
+    }
+    f << text;
+    return (bool)f;
+}
+
+static bool writeBinary(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        std::cerr << "[mythos-cli] Cannot write: " << path << "\n";
+        return false;
+    }
+    f.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    return (bool)f;
+}
+
+// --json is optional everywhere: without it a one-line summary goes to stderr.
+static bool emitJson(const Args& a, const std::string& json)
+{
+    if (!a.has("--json")) return true;
+    return writeText(a.get("--json"), json);
+}
+
+static double msSince(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+// ============================================================
+// Mesh helpers
+// ============================================================
+
+// Same extension routing as the editor's importers
+static std::shared_ptr<MeshAsset> loadMesh(const std::string& path)
+{
+    std::string lower = path;
+    for (auto& c : lower) c = (char)tolower((unsigned char)c);
+    auto endsWith = [&](const char* ext) {
+        size_t n = strlen(ext);
+        return lower.size() >= n && lower.compare(lower.size() - n, n, ext) == 0;
+    };
+    std::shared_ptr<MeshAsset> asset =
+        (endsWith(".glb") || endsWith(".gltf")) ? GltfImporter::load(path)
+                                                : ObjImporter::load(path);
+    if (!asset || asset->data.indices.empty()) {
+        std::cerr << "[mythos-cli] Failed to import: " << path << "\n";
+        return nullptr;
+    }
+    asset->data.computeAABB();
+    asset->contentHash = ContentHash::mesh(asset->data, asset->submeshes);
+    return asset;
+}
+
+static std::string meshJson(const MeshAsset& m, const std::string& indent)
+{
+    std::ostringstream s;
+    s << indent << "{\n"
+      << indent << "  \"name\": "        << jsonStr(m.name)       << ",\n"
+      << indent << "  \"sourcePath\": "  << jsonStr(m.sourcePath) << ",\n"
+      << indent << "  \"vertices\": "    << m.data.vertices.size() << ",\n"
+      << indent << "  \"triangles\": "   << m.data.indices.size() / 3 << ",\n"
+      << indent << "  \"submeshes\": "   << m.submeshes.size()    << ",\n"
+      << indent << "  \"aabbMin\": "     << vec3Json(m.data.aabbMin) << ",\n"
+      << indent << "  \"aabbMax\": "     << vec3Json(m.data.aabbMax) << ",\n"
+      << indent << "  \"contentHash\": " << jsonStr(hashHex(m.contentHash)) << "\n"
+      << indent << "}";
+    return s.str();
+}
+
+// Plain OBJ: positions, normals, UVs, one group per SubMesh.
+static std::string meshToObj(const MeshAsset& m)
+{
+    std::ostringstream s;
+    s << std::setprecision(7);
+    s << "# mythos-cli merge\n";
+    s << "o " << (m.name.empty() ? "merged" : m.name) << "\n";
+    for (const auto& v : m.data.vertices) s << "v "  << v.pos.x    << " " << v.pos.y    << " " << v.pos.z    << "\n";
+    for (const auto& v : m.data.vertices) s << "vn " << v.normal.x << " " << v.normal.y << " " << v.normal.z << "\n";
+    for (const auto& v : m.data.vertices) s << "vt " << v.uv.x     << " " << v.uv.y     << "\n";
+
+    auto faces = [&](int first, int count) {
+        for (int i = first; i + 2 < first + count; i += 3) {
+            s << "f";
+            for (int k = 0; k < 3; ++k) {
+                unsigned int n = m.data.indices[i + k] + 1;
+                s << " " << n << "/" << n << "/" << n;
+            }
+            s << "\n";
+        }
+    };
+    if (m.submeshes.empty()) {
+        faces(0, (int)m.data.indices.size());
+    } else {
+        for (int i = 0; i < (int)m.submeshes.size(); ++i) {
+            const SubMesh& sm = m.submeshes[i];
+            s << "g " << (sm.materialName.empty() ? "submesh_" + std::to_string(i)
+                                                  : sm.materialName) << "\n";
+            // indexOffset is a byte offset into the IBO
+            faces(sm.indexOffset / (int)sizeof(unsigned int), sm.indexCount);
+        }
+    }
+    return s.str();
+}
+
+// ============================================================
+// Tile definitions
+// ============================================================
+
+// The editor's corridor vocabulary (GrammarView::init)
+static std::vector<merrell::TileSocketDef> defaultTiles()
+{
+    return {
+        { "HStraight", {{-1,0},{ 1,0}} },
+        { "VStraight", {{ 0,-1},{0,1}} },
+        { "CornerTL",  {{-1,0},{ 0,-1}} },
+        { "CornerTR",  {{ 1,0},{ 0,-1}} },
+        { "CornerBL",  {{-1,0},{ 0, 1}} },
+        { "CornerBR",  {{ 1,0},{ 0, 1}} },
+    };
+}
+
+static bool loadTiles(const Args& a, std::vector<merrell::TileSocketDef>& out)
+{
+    out.clear();
+    if (!a.has("--tiles")) { out = defaultTiles(); return true; }
+
+    const std::string path = a.get("--tiles");
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "[mythos-cli] Cannot open tile file: " << path << "\n";
+        return false;
+    }
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line)) {
+        ++lineNo;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.resize(hash);
+        std::istringstream ls(line);
+        merrell::TileSocketDef def;
+        if (!(ls >> def.label)) continue;               // blank / comment
+        std::vector<int> v;
+        int n;
+        while (ls >> n) v.push_back(n);
+        for (size_t k = 0; k + 1 < v.size(); k += 2) def.sockets.push_back({v[k], v[k + 1]});
+        if (!ls.eof() || v.empty() || v.size() % 2) {
+            std::cerr << "[mythos-cli] " << path << ":" << lineNo
+                      << ": expected 'Label dx dy [dx dy ...]'\n";
+            return false;
+        }
+        out.push_back(std::move(def));
+    }
+    if (out.empty()) {
+        std::cerr << "[mythos-cli] No tiles in " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+static std::string tilesJson(const std::vector<merrell::TileSocketDef>& tiles,
+                             const std::string& indent)
+{
+    std::ostringstream s;
+    s << "[\n";
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        s << indent << "  { \"label\": " << jsonStr(tiles[i].label) << ", \"sockets\": [";
+        for (size_t k = 0; k < tiles[i].sockets.size(); ++k)
+            s << (k ? ", " : "") << "[" << tiles[i].sockets[k].x << ", "
+              << tiles[i].sockets[k].y << "]";
+        s << "] }" << (i + 1 < tiles.size() ? "," : "") << "\n";
+    }
+    s << indent << "]";
+    return s.str();
+}
+
+static const char* ruleKindName(merrell::RuleKind k)
+{
+    switch (k) {
+        case merrell::RuleKind::LoopGlue:   return "LoopGlue";
+        case merrell::RuleKind::BranchGlue: return "BranchGlue";
+        case merrell::RuleKind::Starter:    return "Starter";
+        case merrell::RuleKind::Stub:       return "Stub";
+        case merrell::RuleKind::General:    return "General";
+    }
+    return "?";
+}
+
+// ============================================================
+// Commands
+// ============================================================
+
+static int cmdImport(const Args& a)
+{
+    if (a.inputs.empty()) { printUsage(); return 2; }
+    if (a.has("--bin") && a.inputs.size() != 1) {
+        std::cerr << "[mythos-cli] --bin takes exactly one input mesh\n";
+        return 2;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<MeshAsset>> meshes;
+    for (const auto& path : a.inputs) {
+        auto m = loadMesh(path);
+        if (!m) return 1;
+        meshes.push_back(m);
+    }
+    const double ms = msSince(t0);
+
+    if (a.has("--bin")) {
+        std::vector<uint8_t> bytes;
+        MeshCodec::encode(meshes[0]->data, bytes);
+        if (!writeBinary(a.get("--bin"), bytes)) return 1;
+    }
+
+    std::ostringstream s;
+    s << "{\n  \"command\": \"import\",\n  \"elapsedMs\": " << ms << ",\n  \"meshes\": [\n";
+    for (size_t i = 0; i < meshes.size(); ++i)
+        s << meshJson(*meshes[i], "    ") << (i + 1 < meshes.size() ? "," : "") << "\n";
+    s << "  ]\n}\n";
+
+    std::cerr << "[mythos-cli] Imported " << meshes.size() << " mesh(es) in " << ms << " ms\n";
+    return emitJson(a, s.str()) ? 0 : 1;
+}
+
+static int cmdMerge(const Args& a)
+{
+    if (a.inputs.empty()) { printUsage(); return 2; }
+
+    auto t0 = std::chrono::steady_clock::now();
+    // Sources keep their authored placement — one identity object per file
+    std::vector<SceneObject>        objects(a.inputs.size());
+    std::vector<const SceneObject*> ptrs;
+    for (size_t i = 0; i < a.inputs.size(); ++i) {
+        objects[i].id   = (int)i;
+        objects[i].name = a.inputs[i];
+        objects[i].mesh = loadMesh(a.inputs[i]);
+        if (!objects[i].mesh) return 1;
+        ptrs.push_back(&objects[i]);
+    }
+
+    MeshMerge::Result r = a.has("--weld")
+        ? MeshMerge::mergeAndWeld(ptrs, "merged", a.getFloat("--weld", 0.001f))
+        : MeshMerge::merge(ptrs, "merged");
+    if (!r.asset || r.asset->data.indices.empty()) {
+        std::cerr << "[mythos-cli] Merge produced no geometry\n";
+        return 1;
+    }
+    MeshMerge::coalesceSubmeshes(r.asset->data, r.asset->submeshes);
+    r.asset->data.computeAABB();
+    r.asset->contentHash = ContentHash::mesh(r.asset->data, r.asset->submeshes);
+    const double ms = msSince(t0);
+
+    if (a.has("--obj") && !writeText(a.get("--obj"), meshToObj(*r.asset))) return 1;
+    if (a.has("--bin")) {
+        std::vector<uint8_t> bytes;
+        MeshCodec::encode(r.asset->data, bytes);
+        if (!writeBinary(a.get("--bin"), bytes)) return 1;
+    }
+
+    std::ostringstream s;
+    s << "{\n  \"command\": \"merge\",\n  \"elapsedMs\": " << ms
+      << ",\n  \"inputs\": " << a.inputs.size()
+      << ",\n  \"welded\": " << (a.has("--weld") ? "true" : "false")
+      << ",\n  \"mesh\":\n" << meshJson(*r.asset, "  ") << "\n}\n";
+
+    std::cerr << "[mythos-cli] Merged " << a.inputs.size() << " mesh(es): "
+              << r.asset->data.vertices.size() << " verts, "
+              << r.asset->data.indices.size() / 3 << " tris in " << ms << " ms\n";
+    return emitJson(a, s.str()) ? 0 : 1;
+}
+
+static int cmdHalfEdge(const Args& a)
+{
+    if (a.inputs.size() != 1) { printUsage(); return 2; }
+    auto mesh = loadMesh(a.inputs[0]);
+    if (!mesh) return 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    grammar::HalfEdgeMesh he;
+    if (!he.buildFromMesh(mesh->data, a.getFloat("--weld", 0.0001f))) {
+        std::cerr << "[mythos-cli] Half-edge build failed: " << a.inputs[0] << "\n";
+        return 1;
+    }
+    const double ms = msSince(t0);
+
+    grammar::BuildStats st = he.computeStats();
+    std::vector<std::string> errors;
+    const bool valid = he.validate(&errors);
+
+    std::ostringstream s;
+    s << "{\n  \"command\": \"halfedge\",\n  \"elapsedMs\": " << ms
+      << ",\n  \"source\": "          << jsonStr(a.inputs[0])
+      << ",\n  \"vertices\": "        << st.vertCount
+      << ",\n  \"faces\": "           << st.faceCount
+      << ",\n  \"halfEdges\": "       << st.halfEdgeCount
+      << ",\n  \"interiorEdges\": "   << st.interiorEdges
+      << ",\n  \"boundaryEdges\": "   << st.boundaryEdges
+      << ",\n  \"nonManifoldEdges\": " << st.nonManifoldEdges
+      << ",\n  \"manifold\": "        << (st.isManifold ? "true" : "false")
+      << ",\n  \"valid\": "           << (valid ? "true" : "false")
+      << ",\n  \"errors\": [";
+    for (size_t i = 0; i < errors.size(); ++i)
+        s << (i ? ", " : "") << jsonStr(errors[i]);
+    s << "]\n}\n";
+
+    std::cerr << "[mythos-cli] Half-edge: " << st.faceCount << " faces, "
+              << st.boundaryEdges << " boundary edges, "
+              << (valid ? "valid" : "INVALID") << "\n";
+    if (!emitJson(a, s.str())) return 1;
+    return valid ? 0 : 1;
+}
+
+static int cmdTiles(const Args& a)
+{
+    std::vector<merrell::TileSocketDef> tiles;
+    if (!loadTiles(a, tiles)) return 1;
+
+    std::cerr << "[mythos-cli] " << tiles.size() << " tile type(s)\n";
+    return emitJson(a, "{\n  \"command\": \"tiles\",\n  \"tiles\": "
+                       + tilesJson(tiles, "  ") + "\n}\n") ? 0 : 1;
+}
+
+// Shared by extract and (Merrell) generate
+static bool extractMerrell(const Args& a, merrell::MerrellGrammar& g,
+                           std::vector<merrell::TileSocketDef>& tiles)
+{
+    if (!loadTiles(a, tiles)) return false;
+    g.settings().maxHierarchyGen = a.getInt("--max-gen",   g.settings().maxHierarchyGen);
+    g.settings().maxRules        = a.getInt("--max-rules", g.settings().maxRules);
+    g.loadFromTiles(tiles, {});
+    if (g.primitiveCount() == 0) {
+        std::cerr << "[mythos-cli] " << g.lastError() << "\n";
+        return false;
+    }
+    g.extractGrammar();
+    if (!g.hasRules()) {
+        std::cerr << "[mythos-cli] Extraction produced no rules"
+                  << (g.lastError().empty() ? "" : ": " + g.lastError()) << "\n";
+        return false;
+    }
+    return true;
+}
+
+static int cmdExtract(const Args& a)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    merrell::MerrellGrammar g;
+    std::vector<merrell::TileSocketDef> tiles;
+    if (!extractMerrell(a, g, tiles)) return 1;
+    const double ms = msSince(t0);
+
+    std::ostringstream s;
+    s << "{\n  \"command\": \"extract\",\n  \"elapsedMs\": " << ms
+      << ",\n  \"primitives\": "     << g.primitiveCount()
+      << ",\n  \"hierarchyNodes\": " << g.hierarchy().size()
+      << ",\n  \"hierarchyDepth\": " << g.hierarchyDepth()
+      << ",\n  \"tiles\": "          << tilesJson(tiles, "  ")
+      << ",\n  \"rules\": [\n";
+    const auto& rules = g.rules();
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const auto& r = rules[i];
+        s << "    { \"id\": " << r.id
+          << ", \"name\": "       << jsonStr(r.name)
+          << ", \"kind\": \""     << ruleKindName(r.kind) << "\""
+          << ", \"generation\": " << r.extractedAtGeneration
+          << ", \"lFaces\": "     << r.L.faces.size()
+          << ", \"rFaces\": "     << r.R.faces.size()
+          << ", \"valid\": "      << (r.isValid() ? "true" : "false")
+          << " }" << (i + 1 < rules.size() ? "," : "") << "\n";
+    }
+    s << "  ]\n}\n";
+
+    std::cerr << "[mythos-cli] Extracted " << g.ruleCount() << " rules from "
+              << g.primitiveCount() << " primitives in " << ms << " ms\n";
+    return emitJson(a, s.str()) ? 0 : 1;
+}
+
+static int cmdGenerate(const Args& a)
+{
+    const int seed = a.getInt("--seed", 42);
+    auto t0 = std::chrono::steady_clock::now();
+    std::ostringstream s;
+
+    if (a.grid) {
+        // Grid loop generator (Grammar) — the editor's Generate button
+        std::vector<merrell::TileSocketDef> tiles;
+        if (!loadTiles(a, tiles)) return 1;
+        grammar::Grammar g;
+        for (const auto& t : tiles)
+            g.addPrim(t.label.c_str(), {0.8f, 0.8f, 0.8f}, t.sockets);
+        g.seed    = seed;
+        g.minPrim = a.getInt("--min", g.minPrim);
+        g.maxPrim = a.getInt("--max", g.maxPrim);
+        g.generate();
+        const double ms = msSince(t0);
+        if (g.placed.empty()) {
+            std::cerr << "[mythos-cli] Grid generation failed (seed " << seed << ")\n";
+            return 1;
+        }
+
+        s << "{\n  \"command\": \"generate\",\n  \"mode\": \"grid\",\n  \"elapsedMs\": " << ms
+          << ",\n  \"seed\": " << seed
+          << ",\n  \"encoded\": " << jsonStr(g.encode())
+          << ",\n  \"placed\": [\n";
+        for (size_t i = 0; i < g.placed.size(); ++i) {
+            const auto& p = g.placed[i];
+            s << "    { \"label\": " << jsonStr(p.def ? p.def->id : "")
+              << ", \"cell\": [" << p.cell.x << ", " << p.cell.y << "]"
+              << ", \"rot\": " << p.rot << " }"
+              << (i + 1 < g.placed.size() ? "," : "") << "\n";
+        }
+        s << "  ]\n}\n";
+        std::cerr << "[mythos-cli] Generated " << g.placed.size() << " pieces in " << ms << " ms\n";
+        return emitJson(a, s.str()) ? 0 : 1;
+    }
+
+    // Merrell graph grammar — extract, then Algorithm 3
+    merrell::MerrellGrammar g;
+    std::vector<merrell::TileSocketDef> tiles;
+    if (!extractMerrell(a, g, tiles)) return 1;
+    g.generate(seed);
+    const double ms = msSince(t0);
+    const auto& res = g.result();
+    if (!res.success) {
+        std::cerr << "[mythos-cli] Generation failed: " << res.errorMsg << "\n";
+        return 1;
+    }
+
+    s << "{\n  \"command\": \"generate\",\n  \"mode\": \"merrell\",\n  \"elapsedMs\": " << ms
+      << ",\n  \"seed\": " << seed
+      << ",\n  \"rules\": " << g.ruleCount()
+      << ",\n  \"graph\": { \"vertices\": " << res.graph.vertices.size()
+      << ", \"halfEdges\": " << res.graph.halfEdges.size()
+      << ", \"faces\": "     << res.graph.faces.size() << " }"
+      << ",\n  \"placed\": [\n";
+    for (size_t i = 0; i < res.placed.size(); ++i) {
+        const auto& p = res.placed[i];
+        s << "    { \"face\": " << p.faceId
+          << ", \"label\": "    << jsonStr(p.label)
+          << ", \"pos\": ["     << p.pos.x << ", " << p.pos.y << "]"
+          << ", \"rotation\": " << p.rotation << " }"
+          << (i + 1 < res.placed.size() ? "," : "") << "\n";
+    }
+    s << "  ]\n}\n";
+    std::cerr << "[mythos-cli] Generated " << res.placed.size() << " faces in " << ms << " ms\n";
+    return emitJson(a, s.str()) ? 0 : 1;
+}
+
+static int cmdInduce(const Args& a)
+{
+    if (a.inputs.size() != 1) { printUsage(); return 2; }
+    auto t0 = std::chrono::steady_clock::now();
+    grammar::InducedGrammar ig = grammar::GrammarInducer::induceFromFile(a.inputs[0]);
+    const double ms = msSince(t0);
+    if (ig.nodes.empty()) {
+        std::cerr << "[mythos-cli] Induction failed: "
+                  << grammar::GrammarInducer::lastError() << "\n";
+        return 1;
+    }
+
+    std::cerr << "[mythos-cli] Induced " << ig.tileVariants.size() << " variants, "
+              << ig.rules.size() << " rules from " << ig.nodes.size()
+              << " nodes in " << ms << " ms\n";
+    return emitJson(a, ig.toJson() + "\n") ? 0 : 1;
+}
+
+// ============================================================
+// main
+// ============================================================
+
+int main(int argc, char** argv)
+{
+    Args args;
+    if (!parseArgs(argc, argv, args)) { printUsage(); return 2; }
+
+    // Library logging → stderr; results use s_stdout
+    s_stdout = std::cout.rdbuf(std::cerr.rdbuf());
+
+    static const std::map<std::string, std::function<int(const Args&)>> commands = {
+        { "import",   cmdImport   },
+        { "merge",    cmdMerge    },
+        { "halfedge", cmdHalfEdge },
+        { "tiles",    cmdTiles    },
+        { "extract",  cmdExtract  },
+        { "generate", cmdGenerate },
+        { "induce",   cmdInduce   },
+    };
+
+    int rc = 2;
+    auto it = commands.find(args.cmd);
+    if (it != commands.end()) rc = it->second(args);
+    else                      printUsage();
+
+    if (args.mem) MemoryStats::dump(std::cerr);
+
+    std::cout.rdbuf(s_stdout);
+    return rc;
+}